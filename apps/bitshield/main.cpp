@@ -1,9 +1,29 @@
 #include <bitshield/codecs/repetition.hpp>
 #include <bitshield/codecs/hamming74.hpp>
+#include <bitshield/codecs/lt.hpp>
+#include <bitshield/codecs/codec.hpp>
 #include <bitshield/channel.hpp>
+#include <bitshield/channels/markov.hpp>
+#include <bitshield/channels/bec.hpp>
+#include <bitshield/channels/bernoulli.hpp>
+#include <bitshield/channels/awgn.hpp>
+#include <bitshield/channels/fixed_weight.hpp>
+#include <bitshield/channels/trace.hpp>
 #include <bitshield/io.hpp>
+#include <bitshield/container.hpp>
+#include <bitshield/pipeline.hpp>
+#include <bitshield/sim.hpp>
+#include <bitshield/arena.hpp>
+#include <bitshield/bitspan.hpp>
 #include <bitshield/bitstream.hpp>
 #include <bitshield/metrics.hpp>
+#include <bitshield/crc.hpp>
+#include <bitshield/llr.hpp>
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -13,9 +33,22 @@
 #include <algorithm>
 #include <random>
 #include <optional>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <thread>
 
 namespace {
 
+// Set by SIGINT/SIGTERM during a checkpointed simulation
+std::atomic<bool> g_stop{false};
+
+void request_stop(int) {
+    g_stop.store(true);
+}
+
 // Simple argument parser
 class ArgParser {
 public:
@@ -37,6 +70,29 @@ public:
         return default_val;
     }
     
+    // Copy of the parser with flag set to value, replacing any value given
+    ArgParser with_value(const std::string& flag, const std::string& value) const {
+        ArgParser copy = *this;
+        auto it = std::find(copy.args_.begin(), copy.args_.end(), flag);
+        if (it != copy.args_.end() && (it + 1) != copy.args_.end()) {
+            *(it + 1) = value;
+        } else {
+            copy.args_.push_back(flag);
+            copy.args_.push_back(value);
+        }
+        return copy;
+    }
+    
+    // Copy of the parser that falls back to extra arguments for options the
+    // command line does not set (get_value returns the first occurrence)
+    ArgParser with_defaults(const std::vector<std::string>& extra) const {
+        ArgParser copy = *this;
+        copy.args_.insert(copy.args_.end(), extra.begin(), extra.end());
+        return copy;
+    }
+    
+    const std::vector<std::string>& args() const { return args_; }
+    
     std::string get_subcommand() const {
         if (args_.empty()) {
             return "";
@@ -51,140 +107,813 @@ public:
         std::cout << "  encode    Encode bits using a codec\n";
         std::cout << "  decode    Decode bits using a codec\n";
         std::cout << "  simulate  Simulate noisy channel transmission\n";
-        std::cout << "  benchmark Benchmark codec performance\n\n";
+        std::cout << "  sweep     Simulate several codecs and error rates on a work-stealing pool\n";
+        std::cout << "  merge     Combine the result files of simulation shards\n";
+        std::cout << "  convert   Convert between .bsh containers and legacy bit files\n";
+        std::cout << "  benchmark Benchmark codec performance\n";
+        std::cout << "  fountain  Transfer a file with an LT code over an erasure channel\n\n";
         std::cout << "Examples:\n";
         std::cout << "  bitshield encode --codec repetition --n 5 --text \"hello\" --output encoded.txt\n";
         std::cout << "  bitshield decode --codec repetition --n 5 --input teste.txt --output out.txt\n";
+        std::cout << "  bitshield encode --codec hamming --text \"hello\" --output encoded.bsh\n";
+        std::cout << "  bitshield decode --input encoded.bsh --output out.txt\n";
+        std::cout << "  bitshield encode --codec hamming --input big.bin --output big.bsh --io uring\n";
         std::cout << "  bitshield decode --codec hamming --input encoded.txt --output out.txt\n";
+        std::cout << "  bitshield convert --input encoded.bsh --output encoded.txt --to legacy\n";
+        std::cout << "  bitshield encode --codec concat --outer repetition:3 --inner hamming --depth 8 --text \"hello\" --output encoded.txt\n";
         std::cout << "  bitshield simulate --codec repetition --n 5 --text \"hello\" --p 0.02 --trials 1000 --seed 42\n";
+        std::cout << "  bitshield simulate --codec hamming --interleaver block --rows 8 --text \"hello\" --p 0.02 --trials 1000\n";
+        std::cout << "  bitshield simulate --codec hamming --channel gilbert-elliott --p-gb 0.01 --p-bg 0.1 --e-bad 0.5 --text \"hello\" --trials 1000\n";
+        std::cout << "  bitshield simulate --codec hamming --channel bec --p 0.1 --text \"hello\" --trials 1000 --seed 42\n";
+        std::cout << "  bitshield simulate --codec hamming --channel bernoulli --p 0.05 --text \"hello\" --trials 100000\n";
+        std::cout << "  bitshield simulate --codec hamming --ebn0 4 --text \"hello\" --trials 1000 --seed 42\n";
+        std::cout << "  bitshield simulate --codec hamming --channel fixed --weight 2 --text \"hello\" --trials 1000\n";
+        std::cout << "  bitshield simulate --codec hamming --interleaver block --channel trace --trace link.mask --text \"hello\" --trials 1000\n";
+        std::cout << "  bitshield simulate --codec hamming --p 0.02 --text \"hello\" --trials 1000000 --threads 32 --numa\n";
+        std::cout << "  bitshield simulate --codec hamming --p 0.02 --text \"hello\" --trials 100000000 --seed 1 --checkpoint run.ckpt --resume\n";
+        std::cout << "  bitshield simulate --codec hamming --p 0.02 --text \"hello\" --trials 100000000 --seed 1 --shard 0/4 --result shard0.res\n";
+        std::cout << "  bitshield merge --input shard0.res,shard1.res,shard2.res,shard3.res\n";
+        std::cout << "  bitshield sweep --codec repetition,hamming --p 0.001,0.01,0.05,0.1 --text \"hello\" --trials 100000 --threads 8\n";
         std::cout << "  bitshield benchmark --codec repetition --n 3,5,7 --size 1MB --seed 42\n";
+        std::cout << "  bitshield benchmark --crc all --size 256MB\n";
+        std::cout << "  bitshield benchmark --awgn --size 256MB\n";
+        std::cout << "  bitshield benchmark --bits --size 1024MB\n";
+        std::cout << "  bitshield benchmark --arena --codec hamming --size 1KB --trials 100000 --batch 64 --p 0.01\n";
+        std::cout << "  bitshield benchmark --io all --size 1024MB\n";
+        std::cout << "  bitshield fountain --input data.bin --symbol-size 1024 --overhead 0.2 --erasure 0.1 --seed 42\n";
     }
     
 private:
     std::vector<std::string> args_;
 };
 
+// Parse a codec spec of the form "name" or "name:param" (e.g. "repetition:3")
+bitshield::codec::Codec codec_from_spec(const std::string& spec) {
+    size_t colon = spec.find(':');
+    if (colon == std::string::npos) {
+        return bitshield::codec::make_codec(spec);
+    }
+    return bitshield::codec::make_codec(spec.substr(0, colon), std::stoi(spec.substr(colon + 1)));
+}
+
+bitshield::codec::Codec base_codec_from_args(const ArgParser& parser, const std::string& codec) {
+    if (codec == "repetition") {
+        std::string n_str = parser.get_value("--n");
+        if (n_str.empty()) {
+            throw std::runtime_error("--n is required for repetition codec");
+        }
+        return bitshield::codec::make_repetition(std::stoi(n_str));
+    } else if (codec == "hamming") {
+        return bitshield::codec::make_hamming74();
+    } else if (codec == "product") {
+        return bitshield::codec::make_product(std::stoi(parser.get_value("--iterations", "4")));
+    } else if (codec == "concat") {
+        std::string outer = parser.get_value("--outer");
+        std::string inner = parser.get_value("--inner");
+        if (outer.empty() || inner.empty()) {
+            throw std::runtime_error("--outer and --inner are required for concat codec");
+        }
+        size_t depth = std::stoul(parser.get_value("--depth", "1"));
+        return bitshield::codec::make_concatenated(codec_from_spec(outer), codec_from_spec(inner), depth);
+    }
+    throw std::runtime_error("Unknown codec: " + codec);
+}
+
+// Options that define the codec, recorded in .bsh headers without the leading dashes
+const char* const kCodecOptions[] = {
+    "--n", "--iterations", "--outer", "--inner", "--depth",
+    "--interleaver", "--rows", "--cols", "--interleaver-seed"
+};
+
+std::vector<std::pair<std::string, std::string>> codec_parameters(const ArgParser& parser) {
+    std::vector<std::pair<std::string, std::string>> parameters;
+    for (const char* option : kCodecOptions) {
+        if (parser.has_flag(option)) {
+            parameters.emplace_back(option + 2, parser.get_value(option));
+        }
+    }
+    return parameters;
+}
+
+// Parser with the codec recorded in a container header as fallback options
+ArgParser with_container_codec(const ArgParser& parser, const bitshield::io::ContainerHeader& header) {
+    std::vector<std::string> recorded;
+    if (!header.codec.empty()) {
+        recorded = {"--codec", header.codec};
+    }
+    for (const auto& [key, value] : header.parameters) {
+        recorded.push_back("--" + key);
+        recorded.push_back(value);
+    }
+    return parser.with_defaults(recorded);
+}
+
+// Codec selected by --codec, optionally wrapped with the --interleaver stage
+bitshield::codec::Codec codec_from_args(const ArgParser& parser, const std::string& codec) {
+    bitshield::codec::Codec selected = base_codec_from_args(parser, codec);
+    
+    std::string kind = parser.get_value("--interleaver");
+    if (kind.empty()) {
+        return selected;
+    }
+    
+    bitshield::interleaver::Spec spec;
+    if (kind == "block") {
+        spec.kind = bitshield::interleaver::Kind::block;
+    } else if (kind == "helical") {
+        spec.kind = bitshield::interleaver::Kind::helical;
+    } else if (kind == "random") {
+        spec.kind = bitshield::interleaver::Kind::random;
+    } else if (kind == "convolutional") {
+        spec.kind = bitshield::interleaver::Kind::convolutional;
+    } else {
+        throw std::runtime_error("Unknown interleaver: " + kind);
+    }
+    spec.rows = std::stoul(parser.get_value("--rows", "8"));
+    spec.cols = std::stoul(parser.get_value("--cols", std::to_string(selected.code_bits)));
+    spec.seed = std::stoul(parser.get_value("--interleaver-seed", "0"));
+    return bitshield::codec::make_interleaved(selected, spec);
+}
+
+// Channel output: received (hard-decision) bits, a packed erasure mask (empty if
+// nothing was erased) and LLRs from soft-output channels (empty otherwise)
+struct Received {
+    std::vector<uint8_t> bits;
+    std::vector<uint8_t> erasures;
+    std::vector<float> llrs;
+};
+
+// Channel applied to each simulated transmission, given the trial seed and index
+using ChannelFn = std::function<Received(bitshield::util::ConstBitSpan, std::optional<uint32_t>, size_t)>;
+
+// Parse a separator-delimited list of probabilities (e.g. "0.9,0.1")
+std::vector<double> parse_doubles(const std::string& list, char separator) {
+    std::vector<double> values;
+    std::istringstream iss(list);
+    std::string token;
+    while (std::getline(iss, token, separator)) {
+        values.push_back(std::stod(token));
+    }
+    return values;
+}
+
+// Channel selected by --channel; the codec sets the Eb/N0 scaling and default block length
+ChannelFn channel_from_args(const ArgParser& parser, const bitshield::codec::Codec& codec) {
+    double rate = static_cast<double>(codec.data_bits) / codec.code_bits;
+    std::string kind = parser.get_value("--channel", parser.has_flag("--ebn0") ? "awgn" : "bsc");
+    if (kind == "awgn") {
+        std::string ebn0_str = parser.get_value("--ebn0");
+        if (ebn0_str.empty()) {
+            throw std::runtime_error("--ebn0 is required for awgn channel");
+        }
+        double ebn0_db = std::stod(ebn0_str);
+        return [ebn0_db, rate](bitshield::util::ConstBitSpan bits, std::optional<uint32_t> seed, size_t) {
+            std::vector<float> llrs = bitshield::channel::awgn_llr(bits, ebn0_db, rate, seed);
+            return Received{bitshield::llr::hard_decision(llrs), {}, std::move(llrs)};
+        };
+    }
+    if (kind == "bsc") {
+        std::string p_str = parser.get_value("--p");
+        if (p_str.empty()) {
+            throw std::runtime_error("--p is required for bsc channel");
+        }
+        double p = std::stod(p_str);
+        return [p](bitshield::util::ConstBitSpan bits, std::optional<uint32_t> seed, size_t) {
+            return Received{bitshield::channel::apply_noise(bits, p, seed), {}, {}};
+        };
+    }
+    if (kind == "bernoulli") {
+        std::string p_str = parser.get_value("--p");
+        if (p_str.empty()) {
+            throw std::runtime_error("--p is required for bernoulli channel");
+        }
+        double p = std::stod(p_str);
+        return [p](bitshield::util::ConstBitSpan bits, std::optional<uint32_t> seed, size_t) {
+            return Received{bitshield::channel::apply_bernoulli(bits, p, seed), {}, {}};
+        };
+    }
+    if (kind == "trace") {
+        std::string path = parser.get_value("--trace");
+        if (path.empty()) {
+            throw std::runtime_error("--trace is required for trace channel");
+        }
+        auto trace = std::make_shared<bitshield::channel::TraceChannel>(
+            path,
+            std::stoull(parser.get_value("--trace-offset", "0")),
+            !parser.has_flag("--no-loop")
+        );
+        // Trial i replays the window starting stride * i bits into the trace
+        // (default: consecutive windows of one encoded message each)
+        uint64_t stride = std::stoull(parser.get_value("--trace-stride", "0"));
+        return [trace, stride](bitshield::util::ConstBitSpan bits, std::optional<uint32_t>, size_t trial) {
+            uint64_t step = stride > 0 ? stride : bits.size();
+            return Received{trace->apply(bits, step * trial), {}, {}};
+        };
+    }
+    if (kind == "fixed") {
+        std::string weight_str = parser.get_value("--weight");
+        if (weight_str.empty()) {
+            throw std::runtime_error("--weight is required for fixed channel");
+        }
+        size_t weight = std::stoul(weight_str);
+        // Errors per codeword by default; --block 0 spreads them over the whole buffer
+        size_t block = std::stoul(parser.get_value("--block", std::to_string(codec.code_bits)));
+        return [weight, block](bitshield::util::ConstBitSpan bits, std::optional<uint32_t> seed, size_t) {
+            size_t block_size = block == 0 ? std::max<size_t>(bits.size(), 1) : block;
+            return Received{bitshield::channel::apply_fixed_weight(bits, block_size, weight, seed), {}, {}};
+        };
+    }
+    if (kind == "bec") {
+        std::string p_str = parser.get_value("--p");
+        if (p_str.empty()) {
+            throw std::runtime_error("--p is required for bec channel");
+        }
+        double p = std::stod(p_str);
+        return [p](bitshield::util::ConstBitSpan bits, std::optional<uint32_t> seed, size_t) {
+            std::vector<uint8_t> erasures = bitshield::channel::erasure_mask(bits.size(), p, seed);
+            return Received{bitshield::channel::apply_erasures(bits, erasures), erasures, {}};
+        };
+    }
+    
+    bitshield::channel::MarkovChannel markov;
+    if (kind == "gilbert-elliott") {
+        std::string p_gb = parser.get_value("--p-gb");
+        std::string p_bg = parser.get_value("--p-bg");
+        if (p_gb.empty() || p_bg.empty()) {
+            throw std::runtime_error("--p-gb and --p-bg are required for gilbert-elliott channel");
+        }
+        markov = bitshield::channel::gilbert_elliott(
+            std::stod(p_gb),
+            std::stod(p_bg),
+            std::stod(parser.get_value("--e-good", "0")),
+            std::stod(parser.get_value("--e-bad", "0.5"))
+        );
+    } else if (kind == "markov") {
+        std::string transitions = parser.get_value("--transitions");
+        std::string error_rates = parser.get_value("--error-rates");
+        if (transitions.empty() || error_rates.empty()) {
+            throw std::runtime_error("--transitions and --error-rates are required for markov channel");
+        }
+        std::istringstream rows(transitions);
+        std::string row;
+        while (std::getline(rows, row, ';')) {
+            markov.transitions.push_back(parse_doubles(row, ','));
+        }
+        markov.error_rates = parse_doubles(error_rates, ',');
+        markov.initial_state = std::stoul(parser.get_value("--initial-state", "0"));
+    } else {
+        throw std::runtime_error("Unknown channel: " + kind);
+    }
+    return [markov](bitshield::util::ConstBitSpan bits, std::optional<uint32_t> seed, size_t) {
+        return Received{bitshield::channel::apply_markov(bits, markov, seed), {}, {}};
+    };
+}
+
+// Size of the byte buffers read from --input and of the bit chunks passed on
+constexpr size_t kStreamBytes = size_t{1} << 16;
+
+// Pull-based stream of bits; returns false once the input is exhausted
+using BitSource = bitshield::pipeline::Source;
+
+// Push-based bit consumer; finish flushes after the last write
+struct BitSink {
+    std::function<void(const std::vector<uint8_t>&)> write;
+    std::function<void()> finish;
+};
+
+// Bytes of a file (or stdin) as bits, MSB first
+BitSource text_source(const std::shared_ptr<bitshield::io::InputFile>& file) {
+    return [file, buffer = std::vector<uint8_t>(kStreamBytes)](std::vector<uint8_t>& bits) mutable {
+        size_t got = file->read(buffer.data(), buffer.size());
+        bits.resize(got * 8);
+        bitshield::util::bytes_to_bits(buffer.data(), got, bits.data());
+        return got > 0;
+    };
+}
+
+// Whitespace-separated 0/1 tokens, optionally after the legacy N token
+BitSource bit_format_source(const std::shared_ptr<bitshield::io::InputFile>& file, bool leading_count) {
+    auto reader = std::make_shared<bitshield::io::BitFormatReader>(*file, leading_count);
+    return [file, reader](std::vector<uint8_t>& bits) {
+        return reader->next(bits);
+    };
+}
+
+// Bits packed into bytes; a trailing partial byte is dropped as by bits_to_text
+BitSink text_sink(const std::string& path) {
+    auto writer = std::make_shared<bitshield::io::TextWriter>(path);
+    return {[writer](const std::vector<uint8_t>& bits) { writer->write(bits); },
+            [writer] { writer->finish(); }};
+}
+
+// Codes every bit of source into sink on the read/code/write pipeline;
+// --threads sets the coding workers and --stats reports stage utilisation
+void run_stream(
+    const ArgParser& parser,
+    const bitshield::codec::Codec& codec,
+    bitshield::codec::ChunkedCoder::Mode mode,
+    const BitSource& source,
+    const BitSink& sink
+) {
+    bitshield::pipeline::Options options;
+    unsigned cores = std::thread::hardware_concurrency();
+    options.workers = std::stoul(parser.get_value("--threads", std::to_string(cores > 0 ? cores : 1)));
+    if (options.workers == 0) {
+        throw std::runtime_error("--threads must be > 0");
+    }
+    
+    bitshield::io::reset_copy_stats();
+    bitshield::pipeline::Stats stats = bitshield::pipeline::run(codec, mode, source, sink.write, options);
+    sink.finish();
+    
+    if (parser.has_flag("--stats")) {
+        // stderr, so stdout can carry the coded stream
+        std::cerr << "Pipeline: " << stats.chunks << " chunks, " << stats.input_bits << " -> "
+                  << stats.output_bits << " bits in " << std::fixed << std::setprecision(3)
+                  << stats.wall_seconds << " s\n";
+        for (const auto& stage : stats.stages) {
+            std::cerr << "  " << std::left << std::setw(6) << stage.name << std::right
+                      << " threads=" << stage.threads
+                      << "  busy=" << std::setprecision(3) << stage.busy_seconds << " s"
+                      << "  wait=" << stage.wait_seconds << " s"
+                      << "  utilisation=" << std::setprecision(1) << 100.0 * stage.utilisation(stats.wall_seconds) << "%\n";
+        }
+        
+        // Copies per byte of plain data: the decoded output or the encoded input
+        bitshield::io::CopyStats copies = bitshield::io::copy_stats();
+        uint64_t data_bytes = (mode == bitshield::codec::ChunkedCoder::Mode::decode ? stats.output_bits : stats.input_bits) / 8;
+        std::cerr << "I/O: " << copies.copied_in << " B copied in, " << copies.mapped_in << " B mapped, "
+                  << copies.staged << " B staged, " << copies.copied_out << " B copied out; "
+                  << std::setprecision(2) << copies.copies_per_byte(data_bytes) << " copies/byte\n";
+    }
+}
+
 void cmd_encode(const ArgParser& parser) {
     std::string codec = parser.get_value("--codec");
     if (codec.empty()) {
         throw std::runtime_error("--codec is required for encode command");
     }
     
-    std::vector<uint8_t> input_bits;
+    // Input is read and coded in chunks, so files and pipes ("-") of any size
+    // stream through with bounded memory
+    BitSource source;
     std::string text = parser.get_value("--text");
     std::string input_file = parser.get_value("--input");
     
     if (!text.empty()) {
-        input_bits = bitshield::util::text_to_bits(text);
+        source = [bits = bitshield::util::text_to_bits(text), done = false](std::vector<uint8_t>& out) mutable {
+            out = done ? std::vector<uint8_t>{} : bits;
+            return !std::exchange(done, true);
+        };
     } else if (!input_file.empty()) {
+        auto file = std::make_shared<bitshield::io::InputFile>(input_file);
         std::string format = parser.get_value("--format", "text");
         if (format == "legacy") {
-            auto [n, bits] = bitshield::io::read_legacy_format(input_file);
-            input_bits = bits;
+            source = bit_format_source(file, true);
         } else {
-            input_bits = bitshield::io::read_text_format(input_file);
+            source = text_source(file);
         }
     } else {
         throw std::runtime_error("Either --text or --input is required");
     }
     
-    std::vector<uint8_t> encoded;
-    
-    if (codec == "repetition") {
-        std::string n_str = parser.get_value("--n");
-        if (n_str.empty()) {
-            throw std::runtime_error("--n is required for repetition codec");
-        }
-        int n = std::stoi(n_str);
-        encoded = bitshield::codec::repetition::encode(input_bits, n);
-    } else if (codec == "hamming") {
-        encoded = bitshield::codec::hamming74::encode_bits(input_bits);
-    } else {
-        throw std::runtime_error("Unknown codec: " + codec);
-    }
-    
     std::string output = parser.get_value("--output");
+    BitSink sink;
     if (!output.empty()) {
-        std::string format = parser.get_value("--format");
-        // For Hamming codec, default to bit format since encoded bits may not be multiple of 8
-        if (format.empty()) {
-            format = (codec == "hamming") ? "legacy" : "text";
-        }
-        if (format == "legacy") {
-            bitshield::io::write_bit_format(output, encoded);
+        // Files default to the .bsh container, which records the codec options
+        std::string format = parser.get_value("--format", "bsh");
+        if (format == "bsh") {
+            auto writer = std::make_shared<bitshield::io::ContainerWriter>(output, codec, codec_parameters(parser));
+            sink = {[writer](const std::vector<uint8_t>& bits) { writer->write(bits); },
+                    [writer] { writer->finish(); }};
+        } else if (format == "legacy") {
+            auto writer = std::make_shared<bitshield::io::BitFormatWriter>(output);
+            sink = {[writer](const std::vector<uint8_t>& bits) { writer->write(bits); },
+                    [writer] { writer->finish(); }};
         } else {
-            bitshield::io::write_text_format(output, encoded);
+            sink = text_sink(output);
         }
     } else {
         // Output to stdout
-        for (uint8_t bit : encoded) {
-            std::cout << static_cast<int>(bit);
-        }
-        std::cout << std::endl;
+        sink.write = [](const std::vector<uint8_t>& bits) {
+            std::string digits(bits.size(), '0');
+            for (size_t i = 0; i < bits.size(); ++i) {
+                digits[i] = static_cast<char>('0' + bits[i]);
+            }
+            std::cout << digits;
+        };
+        sink.finish = [] { std::cout << std::endl; };
     }
+    
+    run_stream(parser, codec_from_args(parser, codec), bitshield::codec::ChunkedCoder::Mode::encode, source, sink);
 }
 
 void cmd_decode(const ArgParser& parser) {
-    std::string codec = parser.get_value("--codec");
-    if (codec.empty()) {
-        throw std::runtime_error("--codec is required for decode command");
-    }
-    
     std::string input_file = parser.get_value("--input");
     if (input_file.empty()) {
         throw std::runtime_error("--input is required for decode command");
     }
     
+    // .bsh input is recognised by its magic and supplies the codec options
+    // that are not given on the command line. Regular files are decoded from
+    // their mapping, unpacking chunks in place; pipes are read front to back.
     std::string format = parser.get_value("--format");
-    // For Hamming codec, default to bit format
+    std::shared_ptr<bitshield::io::InputFile> file;
+    BitSource source;
+    ArgParser args = parser;
+    if (input_file != "-" && (format.empty() || format == "bsh") && std::filesystem::is_regular_file(input_file)
+        && bitshield::io::is_container(input_file)) {
+        format = "bsh";
+        auto reader = std::make_shared<bitshield::io::ContainerReader>(input_file);
+        uint64_t chunk_bits = uint64_t{reader->header().chunk_bytes} * 8;
+        source = [reader, chunk_bits, pos = uint64_t{0}](std::vector<uint8_t>& bits) mutable {
+            uint64_t count = std::min(chunk_bits, reader->header().payload_bits - pos);
+            reader->read_bits(pos, count, bits);
+            pos += count;
+            return count > 0;
+        };
+        args = with_container_codec(parser, reader->header());
+    } else {
+        file = std::make_shared<bitshield::io::InputFile>(input_file);
+        if (format.empty() && bitshield::io::is_container(*file)) {
+            format = "bsh";
+        }
+        if (format == "bsh") {
+            auto reader = std::make_shared<bitshield::io::ContainerStreamReader>(*file);
+            source = [file, reader](std::vector<uint8_t>& bits) {
+                return reader->next(bits);
+            };
+            args = with_container_codec(parser, reader->header());
+        }
+    }
+    
+    std::string codec = args.get_value("--codec");
+    if (codec.empty()) {
+        throw std::runtime_error("--codec is required for decode command");
+    }
+    
+    // Block codecs default to bit format
     if (format.empty()) {
-        format = (codec == "hamming") ? "legacy" : "text";
+        format = (codec == "repetition") ? "text" : "legacy";
     }
-    std::vector<uint8_t> encoded;
     
-    if (format == "legacy") {
-        if (codec == "hamming") {
-            // For Hamming, read pure bit format (no N prefix)
-            encoded = bitshield::io::read_bit_format(input_file);
+    if (format == "bsh") {
+        // Opened above
+    } else if (format == "legacy") {
+        if (codec != "repetition") {
+            // Block codecs read pure bit format (no N prefix)
+            source = bit_format_source(file, false);
         } else {
             // For repetition, read legacy format with N
-            auto [n, bits] = bitshield::io::read_legacy_format(input_file);
-            encoded = bits;
-            std::string n_str = parser.get_value("--n");
+            source = bit_format_source(file, true);
+            std::string n_str = args.get_value("--n");
             if (n_str.empty()) {
                 // Could use n from file, but for consistency require --n
                 throw std::runtime_error("--n is required for repetition codec");
             }
         }
     } else {
-        encoded = bitshield::io::read_text_format(input_file);
+        source = text_source(file);
     }
     
-    std::vector<uint8_t> decoded;
+    // Without --output the decoded text goes to stdout
+    run_stream(args, codec_from_args(args, codec), bitshield::codec::ChunkedCoder::Mode::decode,
+               source, text_sink(parser.get_value("--output", "-")));
+}
+
+void cmd_convert(const ArgParser& parser) {
+    std::string input_file = parser.get_value("--input");
+    std::string output = parser.get_value("--output");
+    if (input_file.empty() || output.empty()) {
+        throw std::runtime_error("--input and --output are required for convert command");
+    }
     
-    if (codec == "repetition") {
-        std::string n_str = parser.get_value("--n");
-        if (n_str.empty()) {
-            throw std::runtime_error("--n is required for repetition codec");
-        }
-        int n = std::stoi(n_str);
-        decoded = bitshield::codec::repetition::decode(encoded, n);
-    } else if (codec == "hamming") {
-        decoded = bitshield::codec::hamming74::decode_bits(encoded);
+    // Containers convert to legacy bit files and everything else to containers
+    bool from_container = bitshield::io::is_container(input_file);
+    std::string to = parser.get_value("--to", from_container ? "legacy" : "bsh");
+    
+    std::vector<uint8_t> bits;
+    ArgParser args = parser;
+    if (from_container) {
+        bitshield::io::ContainerReader reader(input_file);
+        bits = reader.read_all();
+        args = with_container_codec(parser, reader.header());
     } else {
-        throw std::runtime_error("Unknown codec: " + codec);
+        std::string from = parser.get_value("--from", "legacy");
+        if (from == "legacy") {
+            bits = bitshield::io::read_bit_format(input_file);
+        } else if (from == "text") {
+            bits = bitshield::io::read_text_format(input_file);
+        } else {
+            throw std::runtime_error("Unknown format: " + from);
+        }
     }
     
-    std::string output = parser.get_value("--output");
-    if (!output.empty()) {
-        bitshield::io::write_text_format(output, decoded);
+    if (to == "bsh") {
+        bitshield::io::write_container(output, bits, args.get_value("--codec"), codec_parameters(args));
+    } else if (to == "legacy") {
+        bitshield::io::write_bit_format(output, bits);
+    } else if (to == "text") {
+        bitshield::io::write_text_format(output, bits);
     } else {
-        // Output to stdout
-        std::string text = bitshield::util::bits_to_text(decoded);
-        std::cout << text;
+        throw std::runtime_error("Unknown format: " + to);
     }
 }
 
+// Trial of simulate and sweep: transmit, decode and count the message bits
+// decoded wrongly. Trial i of a seeded run uses sim::trial_seed(seed, i), so
+// results do not depend on which worker runs it; without --seed every trial
+// draws fresh randomness.
+bitshield::sim::Trial make_trial(
+    const bitshield::codec::Codec& codec,
+    const ChannelFn& channel,
+    std::optional<uint32_t> seed,
+    bool soft,
+    bool use_arena
+) {
+    return [codec, channel, seed, soft, use_arena](const bitshield::sim::Reference& reference, uint64_t i,
+                                                   bitshield::util::BitArena& arena, bitshield::sim::Tally& tally) {
+        std::optional<uint32_t> trial_seed;
+        if (seed) {
+            trial_seed = bitshield::sim::trial_seed(*seed, i);
+        }
+        
+        Received received = channel(reference.encoded, trial_seed, static_cast<size_t>(i));
+        bitshield::metrics::ChannelStats stats = bitshield::metrics::channel_stats(reference.encoded, received.bits, received.erasures);
+        
+        std::vector<uint8_t> owned;
+        bitshield::util::ConstBitSpan decoded;
+        if (use_arena) {
+            if (!received.llrs.empty() && soft) {
+                decoded = bitshield::codec::decode_llr(codec, received.llrs, arena);
+            } else if (!received.erasures.empty()) {
+                decoded = bitshield::codec::decode_with_erasures(codec, received.bits, received.erasures, arena);
+            } else {
+                decoded = bitshield::codec::decode(codec, received.bits, arena);
+            }
+        } else {
+            if (!received.llrs.empty() && soft) {
+                owned = bitshield::codec::decode_llr(codec, received.llrs);
+            } else if (!received.erasures.empty()) {
+                owned = bitshield::codec::decode_with_erasures(codec, received.bits, received.erasures);
+            } else {
+                owned = codec.decode(received.bits);
+            }
+            decoded = owned;
+        }
+        
+        // Block codecs pad the message; only the original bits are compared
+        // (a short result counts its missing bits as 0)
+        const std::vector<uint8_t>& message = reference.message;
+        size_t message_errors = 0;
+        for (size_t j = 0; j < message.size(); ++j) {
+            uint8_t bit = j < decoded.size() ? decoded[j] : 0;
+            if (message[j] != bit) {
+                message_errors++;
+            }
+        }
+        tally.record(message_errors, stats);
+    };
+}
+
+// Worker pool settings from --threads, --batch, --pin, --numa and --no-steal
+bitshield::sim::Options sim_options_from_args(const ArgParser& parser) {
+    int batch = std::stoi(parser.get_value("--batch", "64"));
+    if (batch <= 0) {
+        throw std::runtime_error("--batch must be > 0");
+    }
+    int threads = std::stoi(parser.get_value("--threads", "1"));
+    if (threads <= 0) {
+        throw std::runtime_error("--threads must be > 0");
+    }
+    
+    bitshield::sim::Options options;
+    options.batch = static_cast<uint64_t>(batch);
+    options.workers = static_cast<size_t>(threads);
+    options.steal = !parser.has_flag("--no-steal");
+    if (parser.has_flag("--numa")) {
+        options.placement = bitshield::sim::Placement::numa;
+    } else if (parser.has_flag("--pin")) {
+        options.placement = bitshield::sim::Placement::pin;
+    }
+    return options;
+}
+
+// Worker count and per-node throughput of a run
+void print_workers(const bitshield::sim::Options& options, const bitshield::sim::Result& result) {
+    std::cout << "  Workers: " << options.workers << " (" << result.pinned_workers << " pinned)\n";
+    std::cout << std::setprecision(1);
+    for (const bitshield::sim::NodeStats& node : result.nodes) {
+        std::cout << "  " << (node.node < 0 ? std::string("Unpinned") : "Node " + std::to_string(node.node))
+                  << ": " << node.workers << " workers, " << node.trials << " trials, "
+                  << node.throughput(result.wall_seconds) << " trials/s\n";
+    }
+}
+
+// Identifies the options that decide a simulation's results, so a checkpoint
+// is only resumed (and shard results only merged) by the same simulation.
+// Options that only affect speed or output are left out, as are the extra
+// flags given, and the rest are sorted so their order does not matter.
+uint64_t run_fingerprint(const ArgParser& parser, const std::vector<std::string>& extra_ignored = {}) {
+    std::vector<std::string> ignored_flags = {
+        "--threads", "--pin", "--numa", "--no-steal", "--arena", "--batch",
+        "--checkpoint", "--checkpoint-interval", "--resume", "--io", "--result", "--histogram",
+    };
+    ignored_flags.insert(ignored_flags.end(), extra_ignored.begin(), extra_ignored.end());
+    const std::vector<std::string>& args = parser.args();
+    std::vector<std::string> options;
+    for (size_t i = 0; i < args.size(); ++i) {
+        std::string option = args[i];
+        bool has_value = args[i].rfind("--", 0) == 0 && i + 1 < args.size() && args[i + 1].rfind("--", 0) != 0;
+        if (has_value) {
+            option += '\0' + args[++i];
+        }
+        std::string flag = option.substr(0, option.find('\0'));
+        if (std::find(ignored_flags.begin(), ignored_flags.end(), flag) == ignored_flags.end()) {
+            options.push_back(option);
+        }
+    }
+    std::sort(options.begin(), options.end());
+    std::string joined;
+    for (const std::string& option : options) {
+        joined += option + '\n';
+    }
+    return bitshield::crc::compute(
+        bitshield::crc::Algorithm::crc64,
+        reinterpret_cast<const uint8_t*>(joined.data()),
+        joined.size()
+    );
+}
+
+// --checkpoint saves progress every --checkpoint-interval seconds (default 60)
+// and when SIGINT or SIGTERM stops the run; --resume continues from the file
+// if it exists
+void checkpoint_from_args(
+    const ArgParser& parser,
+    bitshield::sim::Options& options,
+    std::optional<bitshield::sim::Checkpoint>& resume
+) {
+    options.checkpoint = parser.get_value("--checkpoint");
+    if (options.checkpoint.empty()) {
+        if (parser.has_flag("--resume")) {
+            throw std::runtime_error("--resume requires --checkpoint");
+        }
+        return;
+    }
+    // A resumed unseeded run would not match the trials it replaces
+    if (parser.get_value("--seed").empty()) {
+        throw std::runtime_error("--checkpoint requires --seed");
+    }
+    options.checkpoint_seconds = std::stod(parser.get_value("--checkpoint-interval", "60"));
+    if (options.checkpoint_seconds <= 0.0) {
+        throw std::runtime_error("--checkpoint-interval must be > 0");
+    }
+    options.fingerprint = run_fingerprint(parser);
+    
+    if (parser.has_flag("--resume") && std::filesystem::exists(options.checkpoint)) {
+        resume = bitshield::sim::load_checkpoint(options.checkpoint);
+        if (resume->fingerprint != options.fingerprint) {
+            throw std::runtime_error("Checkpoint " + options.checkpoint + " was saved by a simulation with different options");
+        }
+        // Tasks are numbered by the batch size the checkpoint was saved with
+        options.batch = resume->batch;
+        options.resume = &*resume;
+    }
+    
+    std::signal(SIGINT, request_stop);
+    std::signal(SIGTERM, request_stop);
+    options.stop = &g_stop;
+}
+
+// A run stopped by a signal has saved its progress; report it instead of results
+void check_complete(const bitshield::sim::Options& options, const bitshield::sim::Result& result) {
+    if (!result.complete) {
+        throw std::runtime_error(
+            "Stopped after " + std::to_string(result.tally.trials) + " trials; progress saved to " +
+            options.checkpoint + " (rerun with --resume to continue)"
+        );
+    }
+}
+
+// --trials: a positive trial count (stoull alone would wrap "-1" to 2^64 - 1)
+uint64_t trials_from_args(const ArgParser& parser) {
+    std::string text = parser.get_value("--trials", "1");
+    uint64_t trials = text.find('-') == std::string::npos ? std::stoull(text) : 0;
+    if (trials == 0) {
+        throw std::runtime_error("--trials must be > 0");
+    }
+    return trials;
+}
+
+// --shard i/N: run shard i (counting from 0) of N; the whole run by default
+std::pair<uint32_t, uint32_t> shard_from_args(const ArgParser& parser) {
+    std::string spec = parser.get_value("--shard");
+    if (spec.empty()) {
+        return {0, 1};
+    }
+    size_t slash = spec.find('/');
+    if (slash == std::string::npos) {
+        throw std::runtime_error("--shard must be given as i/N");
+    }
+    uint32_t index = std::stoul(spec.substr(0, slash));
+    uint32_t count = std::stoul(spec.substr(slash + 1));
+    if (count == 0 || index >= count) {
+        throw std::runtime_error("--shard i/N needs 0 <= i < N");
+    }
+    // Unseeded shards draw fresh randomness and would not add up to one run
+    if (count > 1 && parser.get_value("--seed").empty()) {
+        throw std::runtime_error("--shard requires --seed");
+    }
+    return {index, count};
+}
+
+// Trials per error count; the last bin also holds every larger count
+void print_histogram(const std::string& title, const std::vector<uint64_t>& bins, uint64_t trials) {
+    std::cout << "  " << title << ":\n";
+    for (size_t k = 0; k < bins.size(); ++k) {
+        if (bins[k] == 0) {
+            continue;
+        }
+        std::string label = std::to_string(k) + (k + 1 == bitshield::sim::Tally::kHistogramBins ? "+" : "");
+        std::cout << "    " << std::setw(5) << label << ": " << bins[k] << " ("
+                  << static_cast<double>(bins[k]) / static_cast<double>(std::max<uint64_t>(trials, 1)) << ")\n";
+    }
+}
+
+// simulate's statistics for the trials of one tally
+void print_simulation(const bitshield::sim::Tally& tally, size_t message_bits, bool histograms) {
+    double trials = static_cast<double>(tally.trials);
+    double ber = trials > 0 ? static_cast<double>(tally.bit_errors) / (message_bits * trials) : 0.0;
+    double success_rate = trials > 0 ? (trials - tally.failed_messages) / trials : 0.0;
+    
+    std::cout << std::fixed << std::setprecision(6);
+    std::cout << "Simulation Results:\n";
+    std::cout << "  Trials: " << tally.trials << "\n";
+    std::cout << "  Channel Error Rate: " << tally.channel.error_rate() << "\n";
+    std::cout << "  Channel Erasure Rate: " << tally.channel.erasure_rate() << "\n";
+    std::cout << "  Bit Error Rate (BER): " << ber << "\n";
+    std::cout << "  Message Success Rate: " << success_rate << "\n";
+    if (histograms) {
+        print_histogram("Message Bit Errors per Trial", tally.error_histogram, tally.trials);
+        print_histogram("Channel Errors per Trial", tally.channel_histogram, tally.trials);
+    }
+}
+
+// sweep's table: one row per (codec, point) job
+void print_sweep(
+    const std::string& parameter,
+    const std::vector<std::pair<std::string, std::string>>& rows,
+    const std::vector<bitshield::sim::Tally>& tallies,
+    size_t message_bits,
+    bool histograms
+) {
+    std::cout << std::fixed << std::setprecision(6);
+    std::cout << "Sweep Results:\n";
+    std::cout << "  " << std::left << std::setw(12) << "Codec" << std::setw(10) << parameter
+              << std::setw(14) << "Channel Err" << std::setw(14) << "Erasures"
+              << std::setw(14) << "BER" << "Success" << std::right << "\n";
+    for (size_t j = 0; j < rows.size(); ++j) {
+        const bitshield::sim::Tally& tally = tallies[j];
+        double trials = static_cast<double>(tally.trials);
+        double ber = trials > 0 ? static_cast<double>(tally.bit_errors) / (message_bits * trials) : 0.0;
+        double success_rate = trials > 0 ? (trials - tally.failed_messages) / trials : 0.0;
+        std::cout << "  " << std::left << std::setw(12) << rows[j].first << std::setw(10) << rows[j].second
+                  << std::setw(14) << tally.channel.error_rate() << std::setw(14) << tally.channel.erasure_rate()
+                  << std::setw(14) << ber << success_rate << std::right << "\n";
+    }
+    if (histograms) {
+        for (size_t j = 0; j < rows.size(); ++j) {
+            print_histogram(rows[j].first + " " + parameter + "=" + rows[j].second + " Message Bit Errors per Trial",
+                            tallies[j].error_histogram, tallies[j].trials);
+        }
+    }
+}
+
+// --result: write the run's tallies as a mergeable shard result
+void write_result(
+    const ArgParser& parser,
+    const std::vector<std::pair<std::string, std::string>>& metadata,
+    const std::vector<std::string>& labels,
+    const std::vector<uint64_t>& trials,
+    const bitshield::sim::Result& result
+) {
+    std::string path = parser.get_value("--result");
+    if (path.empty()) {
+        return;
+    }
+    auto [index, count] = shard_from_args(parser);
+    bitshield::sim::ShardResult shard;
+    shard.fingerprint = run_fingerprint(parser, {"--shard"});
+    shard.shard_count = count;
+    shard.shards = {index};
+    shard.seconds = result.wall_seconds;
+    shard.metadata = metadata;
+    shard.labels = labels;
+    shard.trials = trials;
+    shard.jobs = result.jobs;
+    bitshield::sim::save_result(shard, path);
+}
+
 void cmd_simulate(const ArgParser& parser) {
     std::string codec = parser.get_value("--codec");
     if (codec.empty()) {
@@ -196,98 +925,583 @@ void cmd_simulate(const ArgParser& parser) {
         throw std::runtime_error("--text is required for simulate command");
     }
     
-    std::string p_str = parser.get_value("--p");
-    if (p_str.empty()) {
-        throw std::runtime_error("--p is required for simulate command");
+    uint64_t trials = trials_from_args(parser);
+    std::optional<uint32_t> seed;
+    std::string seed_str = parser.get_value("--seed");
+    if (!seed_str.empty()) {
+        seed = static_cast<uint32_t>(std::stoul(seed_str));
     }
-    double p = std::stod(p_str);
     
-    int trials = 1;
-    std::string trials_str = parser.get_value("--trials");
-    if (!trials_str.empty()) {
-        trials = std::stoi(trials_str);
+    std::vector<uint8_t> original_bits = bitshield::util::text_to_bits(text);
+    bitshield::codec::Codec selected = codec_from_args(parser, codec);
+    std::vector<uint8_t> encoded = selected.encode(original_bits);
+    
+    // --shard i/N runs a contiguous slice of the trial indices; trial seeds
+    // depend only on the index, so the shards add up to the whole run
+    auto [shard, shards] = shard_from_args(parser);
+    auto [first, last] = bitshield::sim::shard_range(trials, shard, shards);
+    
+    // --arena: decoded bits of each batch of trials live in the worker's arena
+    bitshield::sim::Job job{
+        bitshield::sim::Reference{original_bits, encoded},
+        last - first,
+        make_trial(
+            selected,
+            channel_from_args(parser, selected),
+            seed,
+            !parser.has_flag("--hard"),
+            parser.has_flag("--arena")
+        ),
+        first
+    };
+    bitshield::sim::Options options = sim_options_from_args(parser);
+    std::optional<bitshield::sim::Checkpoint> resume;
+    checkpoint_from_args(parser, options, resume);
+    
+    bitshield::sim::Result result = bitshield::sim::run_jobs({job}, options);
+    check_complete(options, result);
+    write_result(
+        parser,
+        {{"command", "simulate"}, {"message_bits", std::to_string(original_bits.size())}},
+        {codec},
+        {trials},
+        result
+    );
+    
+    print_simulation(result.tally, original_bits.size(), parser.has_flag("--histogram"));
+    if (shards > 1) {
+        std::cout << "  Shard: " << shard << "/" << shards << " (trials " << first << " to " << last << ")\n";
+    }
+    if (result.resumed_trials > 0) {
+        std::cout << "  Resumed: " << result.resumed_trials << " trials from " << options.checkpoint << "\n";
+    }
+    std::cout << "  Time: " << result.wall_seconds * 1000.0 << " ms\n";
+    if (options.workers > 1 || options.placement != bitshield::sim::Placement::none) {
+        print_workers(options, result);
+    }
+}
+
+// Split a comma-separated list, keeping each item as written
+std::vector<std::string> split_list(const std::string& list) {
+    std::vector<std::string> items;
+    std::istringstream iss(list);
+    std::string item;
+    while (std::getline(iss, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+void cmd_sweep(const ArgParser& parser) {
+    std::vector<std::string> codecs = split_list(parser.get_value("--codec"));
+    if (codecs.empty()) {
+        throw std::runtime_error("--codec is required for sweep command");
     }
     
-    uint32_t seed = 0;
+    std::string text = parser.get_value("--text");
+    if (text.empty()) {
+        throw std::runtime_error("--text is required for sweep command");
+    }
+    
+    // The swept parameter: Eb/N0 for awgn, otherwise the channel's --p
+    std::string flag = parser.has_flag("--ebn0") ? "--ebn0" : "--p";
+    std::vector<std::string> points = split_list(parser.get_value(flag));
+    if (points.empty()) {
+        throw std::runtime_error("--p or --ebn0 is required for sweep command");
+    }
+    
+    uint64_t trials = trials_from_args(parser);
+    std::optional<uint32_t> seed;
     std::string seed_str = parser.get_value("--seed");
-    bool use_seed = !seed_str.empty();
-    if (use_seed) {
-        seed = std::stoul(seed_str);
+    if (!seed_str.empty()) {
+        seed = static_cast<uint32_t>(std::stoul(seed_str));
     }
+    bool soft = !parser.has_flag("--hard");
+    bool use_arena = parser.has_flag("--arena");
+    auto [shard, shards] = shard_from_args(parser);
+    auto [first, last] = bitshield::sim::shard_range(trials, shard, shards);
     
-    std::vector<uint8_t> original_bits = bitshield::util::text_to_bits(text);
-    std::vector<uint8_t> encoded;
+    // One job per (codec, point); each uses the same seeds as a simulate
+    // run of that point, so its row matches simulate's results
+    std::vector<uint8_t> message = bitshield::util::text_to_bits(text);
+    std::vector<bitshield::sim::Job> jobs;
+    std::vector<std::pair<std::string, std::string>> rows;
+    for (const std::string& name : codecs) {
+        bitshield::codec::Codec selected = codec_from_args(parser, name);
+        std::vector<uint8_t> encoded = selected.encode(message);
+        for (const std::string& point : points) {
+            ChannelFn channel = channel_from_args(parser.with_value(flag, point), selected);
+            jobs.push_back(bitshield::sim::Job{
+                bitshield::sim::Reference{message, encoded},
+                last - first,
+                make_trial(selected, channel, seed, soft, use_arena),
+                first
+            });
+            rows.emplace_back(name, point);
+        }
+    }
     
-    if (codec == "repetition") {
-        std::string n_str = parser.get_value("--n");
-        if (n_str.empty()) {
-            throw std::runtime_error("--n is required for repetition codec");
+    bitshield::sim::Options options = sim_options_from_args(parser);
+    std::optional<bitshield::sim::Checkpoint> resume;
+    checkpoint_from_args(parser, options, resume);
+    bitshield::sim::Result result = bitshield::sim::run_jobs(jobs, options);
+    check_complete(options, result);
+    
+    std::vector<std::string> labels;
+    for (const auto& [name, point] : rows) {
+        labels.push_back(name + " " + point);
+    }
+    write_result(
+        parser,
+        {{"command", "sweep"}, {"message_bits", std::to_string(message.size())}, {"parameter", flag.substr(2)}},
+        labels,
+        std::vector<uint64_t>(jobs.size(), trials),
+        result
+    );
+    
+    print_sweep(flag.substr(2), rows, result.jobs, message.size(), parser.has_flag("--histogram"));
+    std::cout << std::setprecision(3);
+    std::cout << "  Trials: " << result.tally.trials << "\n";
+    if (shards > 1) {
+        std::cout << "  Shard: " << shard << "/" << shards << " (trials " << first << " to " << last << " of each point)\n";
+    }
+    if (result.resumed_trials > 0) {
+        std::cout << "  Resumed: " << result.resumed_trials << " trials from " << options.checkpoint << "\n";
+    }
+    std::cout << "  Time: " << result.wall_seconds * 1000.0 << " ms\n";
+    std::cout << "  Tail: " << result.tail_seconds * 1000.0 << " ms (first idle worker to end)\n";
+    std::cout << "  Tasks: " << result.tasks << " (" << result.steals << " stolen)\n";
+    print_workers(options, result);
+}
+
+void cmd_merge(const ArgParser& parser) {
+    std::vector<std::string> inputs = split_list(parser.get_value("--input"));
+    if (inputs.empty()) {
+        throw std::runtime_error("--input is required for merge command");
+    }
+    
+    std::vector<bitshield::sim::ShardResult> results;
+    for (const std::string& input : inputs) {
+        results.push_back(bitshield::sim::load_result(input));
+    }
+    bitshield::sim::ShardResult merged = bitshield::sim::merge_results(results);
+    
+    if (!merged.complete() && !parser.has_flag("--partial")) {
+        std::string missing;
+        for (uint32_t shard = 0; shard < merged.shard_count; ++shard) {
+            if (!std::binary_search(merged.shards.begin(), merged.shards.end(), shard)) {
+                missing += (missing.empty() ? "" : ", ") + std::to_string(shard);
+            }
         }
-        int n = std::stoi(n_str);
-        encoded = bitshield::codec::repetition::encode(original_bits, n);
-    } else if (codec == "hamming") {
-        encoded = bitshield::codec::hamming74::encode_bits(original_bits);
+        throw std::runtime_error(
+            "Missing shards " + missing + " of " + std::to_string(merged.shard_count) +
+            " (use --partial to merge the shards given)"
+        );
+    }
+    
+    std::string output = parser.get_value("--result");
+    if (!output.empty()) {
+        bitshield::sim::save_result(merged, output);
+    }
+    
+    auto meta = [&merged](const std::string& key) {
+        for (const auto& [name, value] : merged.metadata) {
+            if (name == key) {
+                return value;
+            }
+        }
+        throw std::runtime_error("Result files lack " + key);
+    };
+    size_t message_bits = std::stoul(meta("message_bits"));
+    bool histograms = parser.has_flag("--histogram");
+    
+    if (meta("command") == "simulate") {
+        print_simulation(merged.jobs.at(0), message_bits, histograms);
     } else {
-        throw std::runtime_error("Unknown codec: " + codec);
+        std::vector<std::pair<std::string, std::string>> rows;
+        for (const std::string& label : merged.labels) {
+            size_t space = label.find(' ');
+            rows.emplace_back(label.substr(0, space), space == std::string::npos ? "" : label.substr(space + 1));
+        }
+        print_sweep(meta("parameter"), rows, merged.jobs, message_bits, histograms);
+        uint64_t total = 0;
+        for (const bitshield::sim::Tally& tally : merged.jobs) {
+            total += tally.trials;
+        }
+        std::cout << "  Trials: " << total << "\n";
     }
+    std::cout << "  Shards: " << merged.shards.size() << " of " << merged.shard_count << "\n";
+    std::cout << std::setprecision(3);
+    std::cout << "  Time: " << merged.seconds * 1000.0 << " ms (summed over shards)\n";
+}
+
+void benchmark_crc(const std::string& name, size_t size_bytes, uint32_t seed) {
+    using bitshield::crc::Algorithm;
+    using bitshield::crc::Implementation;
     
-    size_t total_errors = 0;
-    size_t successful_messages = 0;
+    const std::pair<const char*, Algorithm> algorithms[] = {
+        {"crc8", Algorithm::crc8}, {"crc16", Algorithm::crc16}, {"crc32", Algorithm::crc32},
+        {"crc32c", Algorithm::crc32c}, {"crc64", Algorithm::crc64},
+    };
+    const std::pair<const char*, Implementation> implementations[] = {
+        {"slicing8", Implementation::slicing8}, {"pclmul", Implementation::pclmul},
+    };
+    
+    std::vector<uint8_t> data(size_bytes);
+    std::mt19937 rng(seed);
+    for (auto& byte : data) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    
+    bool found = false;
     bitshield::metrics::Timer timer;
+    for (const auto& [algo_name, algo] : algorithms) {
+        if (name != "all" && name != algo_name) {
+            continue;
+        }
+        found = true;
+        for (const auto& [impl_name, impl] : implementations) {
+            if (!bitshield::crc::is_available(algo, impl)) {
+                continue;
+            }
+            timer.start();
+            uint64_t value = bitshield::crc::compute_with(algo, impl, data.data(), data.size());
+            timer.stop();
+            
+            double throughput = data.size() / timer.elapsed_seconds() / 1e9;  // GB/s
+            std::cout << algo_name << " [" << impl_name << "]: " << std::hex << value << std::dec
+                      << ", " << std::fixed << std::setprecision(2) << timer.elapsed_milliseconds()
+                      << " ms, Throughput: " << throughput << " GB/s\n";
+        }
+    }
+    if (!found) {
+        throw std::runtime_error("Unknown CRC: " + name);
+    }
+}
+
+void benchmark_awgn(size_t size_bytes, uint32_t seed) {
+    std::vector<uint8_t> bits(size_bytes / sizeof(float));
+    std::mt19937 rng(seed);
+    for (auto& bit : bits) {
+        bit = static_cast<uint8_t>(rng() & 1);
+    }
     
+    bitshield::metrics::Timer timer;
+    auto report = [&](const char* label, size_t bytes) {
+        double samples = bits.size() / timer.elapsed_seconds() / 1e6;  // Msamples/s
+        double throughput = bytes / timer.elapsed_seconds() / 1e9;     // GB/s
+        std::cout << label << ": " << std::fixed << std::setprecision(2) << timer.elapsed_milliseconds()
+                  << " ms, Throughput: " << samples << " Msamples/s (" << throughput << " GB/s)\n";
+    };
+    
+    std::vector<float> samples(bits.size());
     timer.start();
-    for (int i = 0; i < trials; ++i) {
-        uint32_t trial_seed = use_seed ? seed + i : 0;
-        std::optional<uint32_t> opt_seed = trial_seed > 0 ? std::make_optional(trial_seed) : std::nullopt;
-        
-        std::vector<uint8_t> noisy = bitshield::channel::apply_noise(encoded, p, opt_seed);
+    bitshield::channel::gaussian_fill(samples.data(), samples.size(), seed);
+    timer.stop();
+    report("Gaussian samples", samples.size() * sizeof(float));
+    
+    timer.start();
+    std::vector<float> llrs = bitshield::channel::awgn_llr(bits, 3.0, 0.5, seed);
+    timer.stop();
+    report("AWGN float LLRs", llrs.size() * sizeof(float));
+    
+    timer.start();
+    std::vector<int8_t> quantized = bitshield::channel::awgn_llr_quantized(bits, 3.0, 0.5, 8.0f, seed);
+    timer.stop();
+    report("AWGN int8 LLRs", quantized.size());
+}
+
+void benchmark_bits(size_t size_bytes, uint32_t seed) {
+    std::vector<uint8_t> bytes(size_bytes);
+    std::mt19937 rng(seed);
+    for (auto& byte : bytes) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    
+    bitshield::metrics::Timer timer;
+    auto report = [&](const char* label) {
+        double throughput = size_bytes / timer.elapsed_seconds() / 1e9;  // GB/s of packed bytes
+        std::cout << label << ": " << std::fixed << std::setprecision(2) << timer.elapsed_milliseconds()
+                  << " ms, Throughput: " << throughput << " GB/s\n";
+    };
+    
+    std::vector<uint8_t> bits(size_bytes * 8);
+    timer.start();
+    bitshield::util::bytes_to_bits(bytes.data(), bytes.size(), bits.data());
+    timer.stop();
+    report("bytes_to_bits");
+    
+    std::vector<uint8_t> packed(size_bytes);
+    timer.start();
+    bitshield::util::bits_to_bytes(bits.data(), bits.size(), packed.data());
+    timer.stop();
+    report("bits_to_bytes");
+    if (packed != bytes) {
+        throw std::runtime_error("bits_to_bytes did not restore the input");
+    }
+    
+    std::string text(bytes.begin(), bytes.end());
+    bits.clear();
+    bits.shrink_to_fit();
+    timer.start();
+    std::vector<uint8_t> text_bits = bitshield::util::text_to_bits(text);
+    timer.stop();
+    report("text_to_bits");
+    
+    timer.start();
+    std::string round_trip = bitshield::util::bits_to_text(text_bits);
+    timer.stop();
+    report("bits_to_text");
+    if (round_trip != text) {
+        throw std::runtime_error("bits_to_text did not restore the input");
+    }
+}
+
+// Trial loop of benchmark --arena: Bernoulli noise on the encoded message,
+// decode and count bit errors
+void benchmark_arena(
+    const bitshield::codec::Codec& codec,
+    size_t size_bytes,
+    int trials,
+    int batch,
+    double p,
+    uint32_t seed
+) {
+    std::vector<uint8_t> data(size_bytes * 8);
+    std::mt19937 rng(seed);
+    for (auto& bit : data) {
+        bit = static_cast<uint8_t>(rng() & 1);
+    }
+    std::vector<uint8_t> encoded = codec.encode(data);
+    size_t mask_bytes = (encoded.size() + 7) / 8;
+    
+    auto count_errors = [&](bitshield::util::ConstBitSpan decoded) {
+        size_t errors = 0;
+        for (size_t j = 0; j < data.size(); ++j) {
+            errors += data[j] != decoded[j];
+        }
+        return errors;
+    };
+    
+    // Both loops take their temporaries from the heap through this resource,
+    // so it counts the allocator calls each of them makes. Allocations inside
+    // codecs without an into-form are not counted.
+    bitshield::util::CountingResource counting(std::pmr::new_delete_resource());
+    
+    bitshield::metrics::Timer timer;
+    size_t start_rss = 0;
+    auto begin = [&] {
+        bitshield::metrics::reset_peak_rss();
+        start_rss = bitshield::metrics::peak_rss_bytes();
+        counting.reset_counts();
+        timer.start();
+    };
+    auto report = [&](const char* label, size_t errors) {
+        timer.stop();
+        size_t peak = bitshield::metrics::peak_rss_bytes();
+        std::cout << label << ": " << std::fixed << std::setprecision(2) << timer.elapsed_milliseconds() << " ms, "
+                  << counting.allocations() << " allocator calls (" << counting.bytes() / 1e6 << " MB), peak RSS "
+                  << peak / 1e6 << " MB (+" << (peak > start_rss ? peak - start_rss : 0) / 1e6 << " MB), "
+                  << errors << " bit errors\n";
+    };
+    
+    // Vectors: every trial allocates the mask, the received bits and the result
+    size_t errors = 0;
+    begin();
+    for (int t = 0; t < trials; ++t) {
+        std::pmr::vector<uint8_t> mask(mask_bytes, 0, &counting);
+        bitshield::channel::xor_bernoulli_mask(mask.data(), encoded.size(), p, seed + t);
+        std::pmr::vector<uint8_t> received(encoded.begin(), encoded.end(), &counting);
+        bitshield::util::BitSpan received_bits(received.data(), received.size());
+        bitshield::channel::apply_mask_in_place(received_bits, mask.data(), mask_bytes);
         
-        std::vector<uint8_t> decoded;
-        if (codec == "repetition") {
-            int n = std::stoi(parser.get_value("--n"));
-            decoded = bitshield::codec::repetition::decode(noisy, n);
+        std::pmr::vector<uint8_t> decoded(&counting);
+        if (codec.decode_into) {
+            decoded.resize(bitshield::codec::coded_size(codec, received.size(), false));
+            codec.decode_into(received_bits, bitshield::util::BitSpan(decoded.data(), decoded.size()));
         } else {
-            decoded = bitshield::codec::hamming74::decode_bits(noisy);
+            std::vector<uint8_t> result = codec.decode(received_bits);
+            decoded.assign(result.begin(), result.end());
         }
+        errors += count_errors(bitshield::util::ConstBitSpan(decoded.data(), decoded.size()));
+    }
+    report("vectors", errors);
+    
+    // Arena: the same temporaries come from one buffer, reset per batch
+    errors = 0;
+    begin();
+    {
+        bitshield::util::BitArena arena(bitshield::util::BitArena::kDefaultBytes, &counting);
+        for (int t = 0; t < trials; ++t) {
+            if (t % batch == 0) {
+                arena.reset();
+            }
+            uint8_t* mask = arena.bytes(mask_bytes);
+            std::memset(mask, 0, mask_bytes);
+            bitshield::channel::xor_bernoulli_mask(mask, encoded.size(), p, seed + t);
+            bitshield::util::BitSpan received = arena.bits(encoded.size());
+            std::copy(encoded.begin(), encoded.end(), received.begin());
+            bitshield::channel::apply_mask_in_place(received, mask, mask_bytes);
+            errors += count_errors(bitshield::codec::decode(codec, received, arena));
+        }
+    }
+    report("arena", errors);
+}
+
+void benchmark_io(const std::string& name, size_t size_bytes) {
+    std::vector<bitshield::io::IoBackend> backends;
+    if (name == "all") {
+        backends = {bitshield::io::IoBackend::blocking, bitshield::io::IoBackend::uring, bitshield::io::IoBackend::threads};
+    } else {
+        backends = {bitshield::io::parse_backend(name)};
+    }
+    
+    std::string path = "bitshield_io_benchmark.tmp";
+    std::vector<uint8_t> block(size_t{1} << 20);
+    
+    // Copies per byte count read(2)/write(2)-style transfers and user-space
+    // staging. Both writers produce each block with memset: "write" into its
+    // own buffer, "fill" in place through reserve/commit.
+    bitshield::metrics::Timer timer;
+    auto report = [&](const char* backend, const char* label) {
+        double throughput = size_bytes / timer.elapsed_seconds() / 1e9;  // GB/s
+        double copies = bitshield::io::copy_stats().copies_per_byte(size_bytes);
+        std::cout << std::left << std::setw(9) << backend << std::right << label << ": "
+                  << std::fixed << std::setprecision(2) << timer.elapsed_milliseconds()
+                  << " ms, Throughput: " << throughput << " GB/s, " << copies << " copies/byte\n";
+    };
+    
+    bitshield::io::IoOptions saved = bitshield::io::io_options();
+    bool written = false;
+    for (bitshield::io::IoBackend backend : backends) {
+        const char* title = bitshield::io::backend_name(backend);
+        if (!bitshield::io::is_available(backend)) {
+            std::cout << title << ": not available\n";
+            continue;
+        }
+        bitshield::io::IoOptions options = saved;
+        options.backend = backend;
+        bitshield::io::set_io_options(options);
         
-        // Calculate errors
-        for (size_t j = 0; j < original_bits.size() && j < decoded.size(); ++j) {
-            if (original_bits[j] != decoded[j]) {
-                total_errors++;
+        bitshield::io::reset_copy_stats();
+        timer.start();
+        {
+            bitshield::io::OutputFile file(path);
+            for (size_t done = 0; done < size_bytes; done += block.size()) {
+                size_t size = std::min(block.size(), size_bytes - done);
+                std::memset(block.data(), static_cast<int>(done >> 20), size);
+                file.write(block.data(), size);
             }
+            file.flush();
         }
+        timer.stop();
+        report(title, " write");
         
-        if (decoded == original_bits) {
-            successful_messages++;
+        bitshield::io::reset_copy_stats();
+        timer.start();
+        {
+            bitshield::io::OutputFile file(path);
+            for (size_t done = 0; done < size_bytes;) {
+                size_t size = size_bytes - done;
+                uint8_t* out = file.reserve(size);
+                std::memset(out, static_cast<int>(done >> 20), size);
+                file.commit(size);
+                done += size;
+            }
+            file.flush();
         }
+        timer.stop();
+        report(title, " fill");
+        
+        // Reads are served from the page cache unless the file exceeds memory
+        bitshield::io::reset_copy_stats();
+        timer.start();
+        {
+            bitshield::io::InputFile file(path);
+            while (file.read(block.data(), block.size()) > 0) {
+            }
+        }
+        timer.stop();
+        report(title, " read");
+        written = true;
+    }
+    bitshield::io::set_io_options(saved);
+    if (!written) {
+        return;
     }
-    timer.stop();
-    
-    double ber = static_cast<double>(total_errors) / (original_bits.size() * trials);
-    double success_rate = static_cast<double>(successful_messages) / trials;
     
-    std::cout << std::fixed << std::setprecision(6);
-    std::cout << "Simulation Results:\n";
-    std::cout << "  Trials: " << trials << "\n";
-    std::cout << "  Bit Error Rate (BER): " << ber << "\n";
-    std::cout << "  Message Success Rate: " << success_rate << "\n";
-    std::cout << "  Time: " << timer.elapsed_milliseconds() << " ms\n";
+    // Baseline without copies: sum the file from its mapping
+    bitshield::io::reset_copy_stats();
+    timer.start();
+    {
+        bitshield::io::MappedFile file(path);
+        uint64_t sum = 0;
+        for (size_t i = 0; i + 8 <= file.size(); i += 8) {
+            uint64_t word;
+            std::memcpy(&word, file.data() + i, 8);
+            sum += word;
+        }
+        bitshield::io::count_bytes(bitshield::io::ByteMove::mapped_in, file.size());
+        block[0] = static_cast<uint8_t>(sum);
+    }
+    timer.stop();
+    report("mapped", " read");
+    std::remove(path.c_str());
 }
 
 void cmd_benchmark(const ArgParser& parser) {
-    std::string codec = parser.get_value("--codec");
-    if (codec.empty()) {
-        throw std::runtime_error("--codec is required for benchmark command");
-    }
-    
     std::string n_str = parser.get_value("--n");
     std::string size_str = parser.get_value("--size", "1MB");
     
-    // Parse size (simple: assume MB)
+    // Parse size (MB, or KB for the many small messages of --arena)
     size_t size_bytes = 1024 * 1024;  // Default 1MB
     if (size_str.find("MB") != std::string::npos) {
         size_t mb = std::stoul(size_str);
         size_bytes = mb * 1024 * 1024;
+    } else if (size_str.find("KB") != std::string::npos) {
+        size_t kb = std::stoul(size_str);
+        size_bytes = kb * 1024;
+    }
+    
+    std::string crc = parser.get_value("--crc");
+    if (!crc.empty()) {
+        benchmark_crc(crc, size_bytes, std::stoul(parser.get_value("--seed", "0")));
+        return;
+    }
+    
+    if (parser.has_flag("--awgn")) {
+        benchmark_awgn(size_bytes, std::stoul(parser.get_value("--seed", "0")));
+        return;
+    }
+    
+    if (parser.has_flag("--bits")) {
+        benchmark_bits(size_bytes, std::stoul(parser.get_value("--seed", "0")));
+        return;
+    }
+    
+    std::string io = parser.get_value("--io");
+    if (!io.empty()) {
+        benchmark_io(io, size_bytes);
+        return;
+    }
+    
+    std::string codec = parser.get_value("--codec");
+    if (codec.empty()) {
+        throw std::runtime_error("--codec is required for benchmark command");
+    }
+    
+    if (parser.has_flag("--arena")) {
+        benchmark_arena(
+            codec_from_args(parser, codec),
+            size_bytes,
+            std::stoi(parser.get_value("--trials", "100")),
+            std::max(1, std::stoi(parser.get_value("--batch", "16"))),
+            std::stod(parser.get_value("--p", "0.01")),
+            std::stoul(parser.get_value("--seed", "1"))
+        );
+        return;
     }
     
     uint32_t seed = 0;
@@ -331,18 +1545,111 @@ void cmd_benchmark(const ArgParser& parser) {
                       << " ms, Throughput: " << std::fixed << std::setprecision(2) 
                       << throughput << " Mbps\n";
         }
-    } else if (codec == "hamming") {
+    } else {
+        bitshield::codec::Codec selected = codec_from_args(parser, codec);
+        
         timer.start();
-        std::vector<uint8_t> encoded = bitshield::codec::hamming74::encode_bits(test_bits);
-        std::vector<uint8_t> decoded = bitshield::codec::hamming74::decode_bits(encoded);
+        std::vector<uint8_t> encoded = selected.encode(test_bits);
+        std::vector<uint8_t> decoded = selected.decode(encoded);
         timer.stop();
         
+        std::string label = codec == "hamming" ? "Hamming(7,4)" : selected.name;
         double throughput = (test_bits.size() * 2) / timer.elapsed_seconds() / 1e6;  // Mbps
-        std::cout << "Hamming(7,4): " << timer.elapsed_milliseconds() 
+        std::cout << label << ": " << timer.elapsed_milliseconds() 
                   << " ms, Throughput: " << std::fixed << std::setprecision(2) 
                   << throughput << " Mbps\n";
-    } else {
-        throw std::runtime_error("Unknown codec: " + codec);
+        
+        if (parser.has_flag("--soft")) {
+            // Compare hard and soft decoding of the same codewords
+            std::vector<float> llrs = bitshield::llr::from_bits(encoded, 2.0f);
+            
+            timer.start();
+            decoded = selected.decode(encoded);
+            timer.stop();
+            double hard_ms = timer.elapsed_milliseconds();
+            
+            timer.start();
+            decoded = bitshield::codec::decode_llr(selected, llrs);
+            timer.stop();
+            double soft_ms = timer.elapsed_milliseconds();
+            
+            std::cout << label << " decode: hard " << hard_ms << " ms, soft " << soft_ms << " ms"
+                      << (selected.decode_soft ? "" : " (hard-decision fallback)") << "\n";
+        }
+    }
+}
+
+void cmd_fountain(const ArgParser& parser) {
+    std::string input_file = parser.get_value("--input");
+    if (input_file.empty()) {
+        throw std::runtime_error("--input is required for fountain command");
+    }
+    
+    size_t symbol_size = std::stoul(parser.get_value("--symbol-size", "1024"));
+    double overhead = std::stod(parser.get_value("--overhead", "0.2"));
+    double erasure = std::stod(parser.get_value("--erasure", "0.0"));
+    if (overhead < 0.0) {
+        throw std::runtime_error("--overhead must be >= 0");
+    }
+    if (erasure < 0.0 || erasure >= 1.0) {
+        throw std::runtime_error("--erasure must be in [0, 1)");
+    }
+    
+    uint32_t seed = 0;
+    std::string seed_str = parser.get_value("--seed");
+    if (!seed_str.empty()) {
+        seed = std::stoul(seed_str);
+    }
+    
+    auto [size, symbols] = bitshield::io::read_symbols(input_file, symbol_size);
+    if (symbols.empty()) {
+        throw std::runtime_error("Input file is empty");
+    }
+    size_t k = symbols.size();
+    
+    // Send enough packets that the expected number of survivors meets the overhead target
+    size_t received_target = static_cast<size_t>(std::ceil(k * (1.0 + overhead)));
+    size_t sent = static_cast<size_t>(std::ceil(received_target / (1.0 - erasure)));
+    
+    bitshield::metrics::Timer timer;
+    timer.start();
+    std::vector<bitshield::codec::lt::Packet> packets = bitshield::codec::lt::encode(symbols, sent, seed);
+    timer.stop();
+    double encode_ms = timer.elapsed_milliseconds();
+    
+    std::vector<uint8_t> erased = bitshield::channel::erasure_pattern(sent, erasure, seed);
+    std::vector<bitshield::codec::lt::Packet> received;
+    received.reserve(sent);
+    for (size_t i = 0; i < sent; ++i) {
+        if (!erased[i]) {
+            received.push_back(std::move(packets[i]));
+        }
+    }
+    
+    timer.start();
+    bitshield::codec::lt::DecodeResult result =
+        bitshield::codec::lt::decode(received, k, symbol_size, seed);
+    timer.stop();
+    double decode_ms = timer.elapsed_milliseconds();
+    
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Fountain Transfer:\n";
+    std::cout << "  Source symbols: " << k << " x " << symbol_size << " bytes\n";
+    std::cout << "  Packets sent: " << sent << "\n";
+    std::cout << "  Packets received: " << received.size() << "\n";
+    std::cout << "  Recovered by peeling: " << result.peeled << "\n";
+    std::cout << "  Recovered by elimination: " << result.eliminated << "\n";
+    std::cout << "  Decode: " << (result.success ? "success" : "failure") << "\n";
+    std::cout << "  Encode time: " << encode_ms << " ms\n";
+    std::cout << "  Decode time: " << decode_ms << " ms\n";
+    
+    if (!result.success) {
+        throw std::runtime_error("Not enough packets received to recover the input");
+    }
+    
+    std::string output = parser.get_value("--output");
+    if (!output.empty()) {
+        bitshield::io::write_symbols(output, result.symbols, size);
     }
 }
 
@@ -359,14 +1666,30 @@ int main(int argc, char* argv[]) {
         ArgParser parser(argc, argv);
         std::string cmd = parser.get_subcommand();
         
+        // --io selects the file backend; benchmark --io compares backends instead
+        std::string io = parser.get_value("--io");
+        if (!io.empty() && cmd != "benchmark") {
+            bitshield::io::IoOptions options = bitshield::io::io_options();
+            options.backend = bitshield::io::parse_backend(io);
+            bitshield::io::set_io_options(options);
+        }
+        
         if (cmd == "encode") {
             cmd_encode(parser);
         } else if (cmd == "decode") {
             cmd_decode(parser);
+        } else if (cmd == "convert") {
+            cmd_convert(parser);
         } else if (cmd == "simulate") {
             cmd_simulate(parser);
+        } else if (cmd == "sweep") {
+            cmd_sweep(parser);
+        } else if (cmd == "merge") {
+            cmd_merge(parser);
         } else if (cmd == "benchmark") {
             cmd_benchmark(parser);
+        } else if (cmd == "fountain") {
+            cmd_fountain(parser);
         } else {
             std::cerr << "Unknown command: " << cmd << "\n";
             parser.print_usage();
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <bitshield/bitspan.hpp>
+#include <memory_resource>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+
+namespace bitshield::util {
+
+/**
+ * Memory resource that forwards to an upstream resource and counts the
+ * calls and bytes passing through it.
+ */
+class CountingResource : public std::pmr::memory_resource {
+public:
+    explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream_(upstream) {}
+    
+    size_t allocations() const { return allocations_; }
+    size_t bytes() const { return bytes_; }            // Total bytes allocated
+    size_t live_bytes() const { return live_bytes_; }
+    size_t peak_bytes() const { return peak_bytes_; }  // Highest live_bytes since construction or reset
+    
+    void reset_counts();
+    
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    
+    std::pmr::memory_resource* upstream_;
+    size_t allocations_ = 0;
+    size_t bytes_ = 0;
+    size_t live_bytes_ = 0;
+    size_t peak_bytes_ = 0;
+};
+
+/**
+ * Monotonic arena for per-trial temporaries.
+ * Allocations bump a pointer through one owned buffer and are never freed
+ * individually; reset() makes the whole buffer available again. When a
+ * batch outgrows the buffer the overflow comes from the upstream resource,
+ * and the next reset() grows the buffer to the batch's high-water mark, so
+ * a steady workload stops touching the upstream allocator after its first
+ * batch. Not thread-safe: use one arena per thread.
+ */
+class BitArena {
+public:
+    static constexpr size_t kDefaultBytes = size_t{1} << 16;
+    
+    /**
+     * @param initial_bytes Size of the first buffer (grown by reset() as needed)
+     * @param upstream Source of the buffer and of overflow blocks
+     */
+    explicit BitArena(
+        size_t initial_bytes = kDefaultBytes,
+        std::pmr::memory_resource* upstream = std::pmr::get_default_resource()
+    );
+    
+    BitArena(const BitArena&) = delete;
+    BitArena& operator=(const BitArena&) = delete;
+    ~BitArena();
+    
+    /**
+     * Allocate room for count bits (one value per byte), valid until the
+     * next reset(). The contents are unspecified.
+     * 
+     * @param count Number of bits
+     * @return Span over the new bits
+     */
+    BitSpan bits(size_t count);
+    
+    /**
+     * Allocate count bytes, e.g. for a packed mask, valid until the next reset().
+     * 
+     * @param count Number of bytes
+     * @return Pointer to the new bytes
+     */
+    uint8_t* bytes(size_t count);
+    
+    /**
+     * Memory resource for std::pmr containers whose storage should live in
+     * the arena. Their memory is only reclaimed by reset().
+     */
+    std::pmr::memory_resource* resource() { return &*resource_; }
+    
+    /**
+     * Release everything allocated since the last reset, growing the buffer
+     * first if this batch needed overflow blocks.
+     */
+    void reset();
+    
+    size_t capacity() const { return capacity_; }  // Bytes in the owned buffer
+    size_t used() const { return used_; }          // Bytes handed out since the last reset
+    
+private:
+    void allocate_buffer(size_t bytes);
+    
+    std::pmr::memory_resource* upstream_;
+    CountingResource overflow_;
+    uint8_t* buffer_ = nullptr;
+    size_t capacity_ = 0;
+    size_t used_ = 0;
+    std::optional<std::pmr::monotonic_buffer_resource> resource_;
+};
+
+} // namespace bitshield::util
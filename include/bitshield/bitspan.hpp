@@ -0,0 +1,190 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+
+namespace bitshield::util {
+
+/**
+ * Non-owning read-only view of unpacked bits (one 0/1 value per byte).
+ * Converts implicitly from a bit vector, so functions taking a ConstBitSpan
+ * accept vectors, slices of vectors and ranges of caller-owned buffers
+ * without copying. The viewed bits must outlive the span. The pointer and
+ * length constructor is explicit so a brace list such as {0, 1} is rejected
+ * instead of being read as a pointer and a length.
+ */
+class ConstBitSpan {
+public:
+    ConstBitSpan() = default;
+    explicit ConstBitSpan(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+    ConstBitSpan(const std::vector<uint8_t>& bits) : data_(bits.data()), size_(bits.size()) {}
+    
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    
+    const uint8_t* begin() const { return data_; }
+    const uint8_t* end() const { return data_ + size_; }
+    uint8_t operator[](size_t i) const { return data_[i]; }
+    
+    /**
+     * View count bits starting at offset.
+     * 
+     * @throws std::invalid_argument if the range passes the end of the span
+     */
+    ConstBitSpan subspan(size_t offset, size_t count) const {
+        if (offset > size_ || count > size_ - offset) {
+            throw std::invalid_argument("Bit span range passes the end of the span");
+        }
+        return ConstBitSpan(data_ + offset, count);
+    }
+    
+    ConstBitSpan subspan(size_t offset) const { return subspan(offset, offset <= size_ ? size_ - offset : 0); }
+    
+    std::vector<uint8_t> to_vector() const { return {data_, data_ + size_}; }
+    
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * Non-owning writable view of unpacked bits, used by the functions that
+ * write their result into caller-provided storage.
+ */
+class BitSpan {
+public:
+    BitSpan() = default;
+    explicit BitSpan(uint8_t* data, size_t size) : data_(data), size_(size) {}
+    BitSpan(std::vector<uint8_t>& bits) : data_(bits.data()), size_(bits.size()) {}
+    
+    operator ConstBitSpan() const { return ConstBitSpan(data_, size_); }
+    
+    uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    
+    uint8_t* begin() const { return data_; }
+    uint8_t* end() const { return data_ + size_; }
+    uint8_t& operator[](size_t i) const { return data_[i]; }
+    
+    /**
+     * View count bits starting at offset.
+     * 
+     * @throws std::invalid_argument if the range passes the end of the span
+     */
+    BitSpan subspan(size_t offset, size_t count) const {
+        if (offset > size_ || count > size_ - offset) {
+            throw std::invalid_argument("Bit span range passes the end of the span");
+        }
+        return BitSpan(data_ + offset, count);
+    }
+    
+    BitSpan subspan(size_t offset) const { return subspan(offset, offset <= size_ ? size_ - offset : 0); }
+    
+private:
+    uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * Non-owning read-only view of a flat array of values, e.g. channel LLRs.
+ * Converts implicitly from a vector, as ConstBitSpan does, so soft-input
+ * functions accept vectors and ranges of caller-owned buffers alike.
+ */
+template <typename T>
+class ConstSpan {
+public:
+    ConstSpan() = default;
+    explicit ConstSpan(const T* data, size_t size) : data_(data), size_(size) {}
+    ConstSpan(const std::vector<T>& values) : data_(values.data()), size_(values.size()) {}
+    
+    const T* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+    const T& operator[](size_t i) const { return data_[i]; }
+    
+    /**
+     * View count values starting at offset.
+     * 
+     * @throws std::invalid_argument if the range passes the end of the span
+     */
+    ConstSpan subspan(size_t offset, size_t count) const {
+        if (offset > size_ || count > size_ - offset) {
+            throw std::invalid_argument("Span range passes the end of the span");
+        }
+        return ConstSpan(data_ + offset, count);
+    }
+    
+private:
+    const T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * Non-owning view of bits packed MSB-first (as by bits_to_bytes) starting
+ * at any bit of a byte buffer, e.g. a range of a memory-mapped container.
+ * Error and erasure masks are passed as packed spans; a packed byte vector
+ * converts implicitly to a view of all of its bits.
+ */
+class PackedBitSpan {
+public:
+    PackedBitSpan() = default;
+    explicit PackedBitSpan(const uint8_t* bytes, uint64_t offset, size_t size)
+        : bytes_(bytes + offset / 8), offset_(static_cast<unsigned>(offset % 8)), size_(size) {}
+    PackedBitSpan(const std::vector<uint8_t>& bytes) : bytes_(bytes.data()), size_(bytes.size() * 8) {}
+    
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    
+    uint8_t operator[](size_t i) const {
+        uint64_t bit = offset_ + i;
+        return (bytes_[bit >> 3] >> (7 - (bit & 7))) & 1;
+    }
+    
+    /**
+     * Viewed bits 8k to 8k + 7 as one MSB-first byte, so loops over sparse
+     * masks can skip whole zero bytes. Bits past size() are unspecified.
+     */
+    uint8_t byte(size_t k) const {
+        size_t first = 8 * k;
+        unsigned window = static_cast<unsigned>(bytes_[k]) << 8;
+        if (offset_ != 0 && first + 8 - offset_ < size_) {
+            window |= bytes_[k + 1];
+        }
+        return static_cast<uint8_t>(window >> (8 - offset_));
+    }
+    
+    /**
+     * View count bits starting at offset.
+     * 
+     * @throws std::invalid_argument if the range passes the end of the span
+     */
+    PackedBitSpan subspan(size_t offset, size_t count) const {
+        if (offset > size_ || count > size_ - offset) {
+            throw std::invalid_argument("Bit span range passes the end of the span");
+        }
+        return PackedBitSpan(bytes_, offset_ + offset, count);
+    }
+    
+    /**
+     * Unpack the viewed bits into out; whole bytes go through the vector
+     * kernel of bytes_to_bits.
+     * 
+     * @param out Destination holding at least size() bits
+     * @throws std::invalid_argument if out is too small
+     */
+    void unpack(BitSpan out) const;
+    
+private:
+    const uint8_t* bytes_ = nullptr;
+    unsigned offset_ = 0;
+    size_t size_ = 0;
+};
+
+} // namespace bitshield::util
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <cstdint>
+#include <cstddef>
 #include <string>
 
 namespace bitshield::util {
@@ -32,5 +33,26 @@ std::vector<uint8_t> bytes_to_bits(const std::vector<uint8_t>& bytes);
  */
 std::vector<uint8_t> bits_to_bytes(const std::vector<uint8_t>& bits);
 
-} // namespace bitshield::util
+/**
+ * Expand bytes to bits (MSB first) into a caller-provided buffer.
+ * Uses AVX2 when the CPU supports it (4 bytes per step), else a table.
+ * 
+ * @param bytes Source bytes
+ * @param size Number of bytes
+ * @param bits Destination with room for 8 * size values
+ */
+void bytes_to_bits(const uint8_t* bytes, size_t size, uint8_t* bits);
 
+/**
+ * Pack bits (MSB first) into a caller-provided buffer. Only the lowest bit
+ * of each value is used; an incomplete last byte is padded with zeros.
+ * Uses AVX2 when the CPU supports it (32 bits per step), else a multiply
+ * that gathers eight bits at a time.
+ * 
+ * @param bits Source bits
+ * @param count Number of bits
+ * @param bytes Destination with room for (count + 7) / 8 bytes
+ */
+void bits_to_bytes(const uint8_t* bits, size_t count, uint8_t* bytes);
+
+} // namespace bitshield::util
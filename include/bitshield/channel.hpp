@@ -1,8 +1,10 @@
 #pragma once
 
+#include <bitshield/bitspan.hpp>
 #include <vector>
 #include <cstdint>
 #include <optional>
+#include <cstddef>
 
 namespace bitshield::channel {
 
@@ -16,10 +18,59 @@ namespace bitshield::channel {
  * @throws std::invalid_argument if p < 0.0 or p > 1.0
  */
 std::vector<uint8_t> apply_noise(
-    const std::vector<uint8_t>& bits,
+    util::ConstBitSpan bits,
     double p,
     std::optional<uint32_t> seed = std::nullopt
 );
 
+/**
+ * Generate an erasure pattern for a packet erasure channel.
+ * Each of count symbols is independently lost with probability p.
+ * 
+ * @param count Number of transmitted symbols
+ * @param p Erasure probability (0.0 to 1.0)
+ * @param seed Optional random seed for determinism
+ * @return Per-symbol flags (1 = erased, 0 = received)
+ * @throws std::invalid_argument if p < 0.0 or p > 1.0
+ */
+std::vector<uint8_t> erasure_pattern(
+    size_t count,
+    double p,
+    std::optional<uint32_t> seed = std::nullopt
+);
+
+/**
+ * Flip the bits selected by a packed error mask.
+ * Channel models that generate errors in bulk produce masks packed MSB-first
+ * (as by util::bits_to_bytes) and apply them with this function.
+ * 
+ * @param bits Input bits
+ * @param mask Error mask (1 = flip) covering at least bits.size() bits
+ * @return Bit vector with the masked bits flipped
+ * @throws std::invalid_argument if the mask is too short
+ */
+std::vector<uint8_t> apply_mask(util::ConstBitSpan bits, util::PackedBitSpan mask);
+
+/**
+ * Flip the bits selected by a packed error mask in place, so a buffer can
+ * be reused across trials or a slice of a larger buffer corrupted.
+ * 
+ * @param bits Bits to corrupt
+ * @param mask Error mask (1 = flip) covering at least bits.size() bits
+ * @throws std::invalid_argument if the mask is too short
+ */
+void apply_mask_in_place(util::BitSpan bits, util::PackedBitSpan mask);
+
+/**
+ * Flip the bits selected by a packed error mask held in caller storage,
+ * e.g. arena memory.
+ * 
+ * @param bits Bits to corrupt
+ * @param mask Error mask packed MSB-first
+ * @param mask_size Bytes in the mask, at least (bits.size() + 7) / 8
+ * @throws std::invalid_argument if the mask is too short
+ */
+void apply_mask_in_place(util::BitSpan bits, const uint8_t* mask, size_t mask_size);
+
 } // namespace bitshield::channel
 
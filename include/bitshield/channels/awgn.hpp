@@ -0,0 +1,78 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <cstddef>
+#include <bitshield/bitspan.hpp>
+
+namespace bitshield::channel {
+
+/**
+ * Noise standard deviation of a BPSK/AWGN channel.
+ * Symbols have unit energy, so sigma^2 = 1 / (2 * rate * Eb/N0).
+ * 
+ * @param ebn0_db Eb/N0 in dB (energy per information bit over noise density)
+ * @param rate Code rate k/n (must be in (0, 1])
+ * @return Noise standard deviation
+ * @throws std::invalid_argument if rate is not in (0, 1]
+ */
+double awgn_sigma(double ebn0_db, double rate);
+
+/**
+ * Fill a buffer with standard normal samples.
+ * Samples come from a counter-based generator (a keyed integer hash of the
+ * sample index) through a Box-Muller transform evaluated with polynomial
+ * log/sin/cos, so blocks of samples are computed with vector instructions.
+ * Sample i of a stream depends only on (seed, i): any range can be generated
+ * independently, and gaussian_fill(out, n, seed, first) returns samples
+ * first .. first + n - 1 of the stream. Tails are cut at about 6.66 sigma.
+ * 
+ * @param out Output buffer
+ * @param count Number of samples
+ * @param seed Stream seed
+ * @param first Index of the first sample in the stream
+ */
+void gaussian_fill(float* out, size_t count, uint64_t seed, uint64_t first = 0);
+
+/**
+ * Transmit bits over a BPSK/AWGN channel and return channel LLRs.
+ * Bit 0 maps to +1 and bit 1 to -1; the receiver observes y = x + n with
+ * n ~ N(0, sigma^2) and outputs L = 2y / sigma^2.
+ * 
+ * @param bits Input bit vector
+ * @param ebn0_db Eb/N0 in dB
+ * @param rate Code rate used to convert Eb/N0 to symbol SNR (must be in (0, 1])
+ * @param seed Optional random seed for determinism
+ * @return LLR vector (same size as input)
+ * @throws std::invalid_argument if rate is not in (0, 1]
+ */
+std::vector<float> awgn_llr(
+    util::ConstBitSpan bits,
+    double ebn0_db,
+    double rate,
+    std::optional<uint32_t> seed = std::nullopt
+);
+
+/**
+ * Transmit bits over a BPSK/AWGN channel and return int8 quantised LLRs.
+ * Equivalent to llr::quantize(awgn_llr(bits, ebn0_db, rate, seed), scale)
+ * without materialising the float LLRs.
+ * 
+ * @param bits Input bit vector
+ * @param ebn0_db Eb/N0 in dB
+ * @param rate Code rate used to convert Eb/N0 to symbol SNR (must be in (0, 1])
+ * @param scale Quantisation scale applied before rounding (must be > 0)
+ * @param seed Optional random seed for determinism
+ * @return Quantised LLR vector (same size as input)
+ * @throws std::invalid_argument if rate is not in (0, 1] or scale <= 0
+ */
+std::vector<int8_t> awgn_llr_quantized(
+    util::ConstBitSpan bits,
+    double ebn0_db,
+    double rate,
+    float scale,
+    std::optional<uint32_t> seed = std::nullopt
+);
+
+} // namespace bitshield::channel
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <cstddef>
+#include <bitshield/bitspan.hpp>
+
+namespace bitshield::channel {
+
+/**
+ * Generate the erasure mask of a binary erasure channel.
+ * Each bit is independently erased with probability p. Erasures are kept in
+ * a packed mask parallel to the bit vector rather than as a third symbol
+ * value, so bit vectors stay 0/1 throughout.
+ * 
+ * @param nbits Number of transmitted bits
+ * @param p Erasure probability (0.0 to 1.0)
+ * @param seed Optional random seed for determinism
+ * @return Erasure mask packed MSB-first ((nbits + 7) / 8 bytes, 1 = erased)
+ * @throws std::invalid_argument if p < 0.0 or p > 1.0
+ */
+std::vector<uint8_t> erasure_mask(
+    size_t nbits,
+    double p,
+    std::optional<uint32_t> seed = std::nullopt
+);
+
+/**
+ * Apply an erasure mask to a bit vector as the receiver would see it:
+ * erased positions are cleared to 0 so no information leaks through them.
+ * 
+ * @param bits Transmitted bits
+ * @param erasures Erasure mask (1 = erased) covering at least bits.size() bits
+ * @return Received bit vector
+ * @throws std::invalid_argument if the erasure mask is too short
+ */
+std::vector<uint8_t> apply_erasures(util::ConstBitSpan bits, util::PackedBitSpan erasures);
+
+} // namespace bitshield::channel
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <cstddef>
+#include <bitshield/bitspan.hpp>
+
+namespace bitshield::channel {
+
+/**
+ * XOR an independent Bernoulli(p) error mask onto a packed bit buffer.
+ * Every bit position draws a 32-bit integer from a counter-based generator
+ * (a keyed integer hash of the bit index) and flips when it falls below the
+ * fixed-point threshold round(p * 2^32), so whole blocks of flips come from
+ * vector compares instead of one floating-point draw per bit. p = 0.5 uses
+ * the raw hash words, 32 flips per draw; p = 0 and p = 1 are exact.
+ * Bits past nbits are left untouched.
+ * 
+ * @param packed Buffer packed MSB-first, at least (nbits + 7) / 8 bytes
+ * @param nbits Number of bits to cover
+ * @param p Bit-flip probability (0.0 to 1.0)
+ * @param seed Stream seed
+ * @throws std::invalid_argument if p < 0.0 or p > 1.0
+ */
+void xor_bernoulli_mask(uint8_t* packed, size_t nbits, double p, uint64_t seed);
+
+/**
+ * Generate the error mask of a binary symmetric channel in bulk.
+ * Intended for mid-range p (about 0.01 to 0.5), where gap sampling draws
+ * almost once per bit anyway; see xor_bernoulli_mask.
+ * 
+ * @param nbits Number of transmitted bits
+ * @param p Bit-flip probability (0.0 to 1.0)
+ * @param seed Optional random seed for determinism
+ * @return Error mask packed MSB-first ((nbits + 7) / 8 bytes, 1 = flipped)
+ * @throws std::invalid_argument if p < 0.0 or p > 1.0
+ */
+std::vector<uint8_t> bernoulli_mask(
+    size_t nbits,
+    double p,
+    std::optional<uint32_t> seed = std::nullopt
+);
+
+/**
+ * Flip each bit of a bit vector independently with probability p, using
+ * bernoulli_mask. Statistically equivalent to apply_noise, but a different
+ * random stream.
+ * 
+ * @param bits Input bit vector
+ * @param p Bit-flip probability (0.0 to 1.0)
+ * @param seed Optional random seed for determinism
+ * @return Bit vector with noise applied
+ * @throws std::invalid_argument if p < 0.0 or p > 1.0
+ */
+std::vector<uint8_t> apply_bernoulli(
+    util::ConstBitSpan bits,
+    double p,
+    std::optional<uint32_t> seed = std::nullopt
+);
+
+} // namespace bitshield::channel
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <cstddef>
+#include <bitshield/bitspan.hpp>
+
+namespace bitshield::channel {
+
+/**
+ * Generate an error mask with exactly weight errors in every block.
+ * Positions within a block are uniformly random and distinct (Floyd's
+ * sampling, weight draws per block). A trailing partial block receives
+ * min(weight, size) errors. Use block_size = nbits for a fixed number of
+ * errors in the whole buffer.
+ * 
+ * @param nbits Number of transmitted bits
+ * @param block_size Bits per block, typically the codeword length (must be > 0)
+ * @param weight Errors per block (must be <= block_size)
+ * @param seed Optional random seed for determinism
+ * @return Error mask packed MSB-first ((nbits + 7) / 8 bytes, 1 = flipped)
+ * @throws std::invalid_argument if block_size == 0 or weight > block_size
+ */
+std::vector<uint8_t> fixed_weight_mask(
+    size_t nbits,
+    size_t block_size,
+    size_t weight,
+    std::optional<uint32_t> seed = std::nullopt
+);
+
+/**
+ * Flip exactly weight bits in every block of a bit vector.
+ * 
+ * @param bits Input bit vector
+ * @param block_size Bits per block (must be > 0)
+ * @param weight Errors per block (must be <= block_size)
+ * @param seed Optional random seed for determinism
+ * @return Bit vector with the errors applied
+ * @throws std::invalid_argument if block_size == 0 or weight > block_size
+ */
+std::vector<uint8_t> apply_fixed_weight(
+    util::ConstBitSpan bits,
+    size_t block_size,
+    size_t weight,
+    std::optional<uint32_t> seed = std::nullopt
+);
+
+} // namespace bitshield::channel
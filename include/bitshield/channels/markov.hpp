@@ -0,0 +1,87 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <cstddef>
+#include <bitshield/bitspan.hpp>
+
+namespace bitshield::channel {
+
+/**
+ * Hidden Markov burst-error channel.
+ * The channel moves between states according to a row-stochastic transition
+ * matrix and flips each bit independently with the error rate of the state it
+ * is in. Two states give the classic Gilbert-Elliott model.
+ */
+struct MarkovChannel {
+    std::vector<std::vector<double>> transitions;  // transitions[i][j] = P(next = j | current = i)
+    std::vector<double> error_rates;               // Bit-flip probability in each state
+    size_t initial_state = 0;                      // State of the first bit
+};
+
+/**
+ * Build a two-state Gilbert-Elliott channel (state 0 = good, 1 = bad).
+ * Bursts last 1 / p_bad_to_good bits on average.
+ * 
+ * @param p_good_to_bad Probability of entering the bad state after a good bit
+ * @param p_bad_to_good Probability of leaving the bad state after a bad bit
+ * @param error_good Bit-flip probability in the good state
+ * @param error_bad Bit-flip probability in the bad state
+ * @return Channel description starting in the good state
+ * @throws std::invalid_argument if a probability is outside [0, 1]
+ */
+MarkovChannel gilbert_elliott(double p_good_to_bad, double p_bad_to_good, double error_good, double error_bad);
+
+/**
+ * Stationary state distribution of a Markov channel.
+ * 
+ * @param channel Channel description
+ * @return Long-run fraction of bits spent in each state
+ * @throws std::invalid_argument if the channel description is invalid
+ */
+std::vector<double> stationary_distribution(const MarkovChannel& channel);
+
+/**
+ * Long-run bit error rate of a Markov channel.
+ * 
+ * @param channel Channel description
+ * @return Stationary-weighted average of the per-state error rates
+ * @throws std::invalid_argument if the channel description is invalid
+ */
+double average_error_rate(const MarkovChannel& channel);
+
+/**
+ * Generate a packed error mask from a Markov channel.
+ * State sojourn lengths and the gaps between flips inside a sojourn are drawn
+ * from geometric distributions, so the cost is proportional to the number of
+ * state changes and errors rather than to the number of bits.
+ * 
+ * @param channel Channel description
+ * @param nbits Number of transmitted bits
+ * @param seed Optional random seed for determinism
+ * @return Error mask packed MSB-first ((nbits + 7) / 8 bytes, 1 = flipped)
+ * @throws std::invalid_argument if the channel description is invalid
+ */
+std::vector<uint8_t> markov_error_mask(
+    const MarkovChannel& channel,
+    size_t nbits,
+    std::optional<uint32_t> seed = std::nullopt
+);
+
+/**
+ * Pass a bit vector through a Markov channel.
+ * 
+ * @param bits Input bit vector
+ * @param channel Channel description
+ * @param seed Optional random seed for determinism
+ * @return Bit vector with burst errors applied
+ * @throws std::invalid_argument if the channel description is invalid
+ */
+std::vector<uint8_t> apply_markov(
+    util::ConstBitSpan bits,
+    const MarkovChannel& channel,
+    std::optional<uint32_t> seed = std::nullopt
+);
+
+} // namespace bitshield::channel
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <bitshield/bitspan.hpp>
+#include <bitshield/io.hpp>
+
+namespace bitshield::channel {
+
+/**
+ * Channel that replays a recorded error trace.
+ * The trace is a packed binary error mask (MSB-first, 1 = flipped bit, as
+ * written by util::bits_to_bytes) captured from a real link. It is mapped
+ * read-only and never copied: every transmission XORs a window of the trace
+ * onto the encoded stream. Windows are addressed by trace bit position, so
+ * concurrent trials can replay different slices of one shared trace.
+ */
+class TraceChannel {
+public:
+    /**
+     * Open a trace file.
+     * 
+     * @param path Packed error mask file
+     * @param offset First trace bit used; window positions are relative to it
+     * @param loop Wrap windows around the end of the trace instead of failing
+     * @throws std::runtime_error if the file cannot be opened
+     * @throws std::invalid_argument if the trace is empty or offset is past its end
+     */
+    explicit TraceChannel(const std::string& path, uint64_t offset = 0, bool loop = true);
+    
+    /**
+     * Replay an already mapped trace (shared between channels).
+     * 
+     * @param trace Mapped trace file
+     * @param offset First trace bit used
+     * @param loop Wrap windows around the end of the trace instead of failing
+     * @throws std::invalid_argument if the trace is empty or offset is past its end
+     */
+    TraceChannel(std::shared_ptr<const io::MappedFile> trace, uint64_t offset = 0, bool loop = true);
+    
+    /**
+     * Number of usable trace bits (from the offset to the end of the trace).
+     */
+    uint64_t length() const { return length_; }
+    
+    /**
+     * Fraction of flipped bits over the usable part of the trace.
+     */
+    double error_rate() const;
+    
+    /**
+     * Copy a window of the trace into a packed error mask.
+     * 
+     * @param position Window start, in bits after the offset
+     * @param nbits Window length
+     * @return Error mask packed MSB-first ((nbits + 7) / 8 bytes)
+     * @throws std::invalid_argument if the window passes the end of a non-looping trace
+     */
+    std::vector<uint8_t> mask(uint64_t position, size_t nbits) const;
+    
+    /**
+     * XOR a window of the trace onto a bit vector.
+     * Reads the mapped trace directly; no mask is materialised.
+     * 
+     * @param bits Transmitted bit vector
+     * @param position Window start, in bits after the offset
+     * @return Received bit vector
+     * @throws std::invalid_argument if the window passes the end of a non-looping trace
+     */
+    std::vector<uint8_t> apply(util::ConstBitSpan bits, uint64_t position) const;
+    
+    /**
+     * XOR a window of the trace onto bits in place.
+     * 
+     * @param bits Transmitted bits, replaced by the received bits
+     * @param position Window start, in bits after the offset
+     * @throws std::invalid_argument if the window passes the end of a non-looping trace
+     */
+    void apply_in_place(util::BitSpan bits, uint64_t position) const;
+    
+private:
+    // Visit the trace bits of a window as (trace bit index, count) runs that
+    // stop at the end of the trace, wrapping if looping
+    template <typename Visit>
+    void for_each_run(uint64_t position, size_t nbits, Visit visit) const;
+    
+    std::shared_ptr<const io::MappedFile> trace_;
+    uint64_t offset_ = 0;
+    uint64_t length_ = 0;
+    bool loop_ = true;
+};
+
+} // namespace bitshield::channel
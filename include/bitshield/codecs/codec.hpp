@@ -0,0 +1,277 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <bitshield/arena.hpp>
+#include <bitshield/bitspan.hpp>
+#include <bitshield/interleaver.hpp>
+
+namespace bitshield::codec {
+
+/**
+ * Bit transform used for a codec's encode and decode steps. The input is a
+ * view, so slices of larger buffers are coded without copying them out.
+ */
+using BitTransform = std::function<std::vector<uint8_t>(util::ConstBitSpan)>;
+
+/**
+ * Soft-input decode step: channel LLRs in, decoded bits out.
+ */
+using SoftDecode = std::function<std::vector<uint8_t>(util::ConstSpan<float>)>;
+
+/**
+ * Erasure-aware decode step: received bits and an erasure mask (1 = erased)
+ * in, decoded bits out.
+ */
+using ErasureDecode = std::function<std::vector<uint8_t>(util::ConstBitSpan, util::PackedBitSpan)>;
+
+/**
+ * Encode or decode step that writes into caller-provided storage sized for
+ * whole blocks (see coded_size).
+ */
+using BitTransformInto = std::function<void(util::ConstBitSpan, util::BitSpan)>;
+
+/**
+ * SoftDecode writing into caller-provided storage, as BitTransformInto.
+ */
+using SoftDecodeInto = std::function<void(util::ConstSpan<float>, util::BitSpan)>;
+
+/**
+ * ErasureDecode writing into caller-provided storage, as BitTransformInto.
+ */
+using ErasureDecodeInto = std::function<void(util::ConstBitSpan, util::PackedBitSpan, util::BitSpan)>;
+
+/**
+ * Type-erased block codec.
+ * encode maps data_bits input bits to code_bits output bits per block
+ * (padding the final block with zeros); decode is the inverse and requires
+ * a whole number of codewords unless the wrapped codec accepts partial ones.
+ * decode_soft is empty for codecs without a soft-input decoder; use
+ * decode_llr to fall back to hard decisions for those. Likewise
+ * decode_erasures is optional; decode_with_erasures falls back for codecs
+ * without it. encode_into, decode_into, decode_soft_into and
+ * decode_erasures_into are optional forms that write into caller storage;
+ * the arena entry points use them to avoid heap allocation. stream_blocks is the number of blocks that must be coded
+ * together for chunked coding to match whole-buffer coding (a stage that
+ * permutes bits across blocks raises it), or 0 if only the whole stream
+ * can be coded at once.
+ */
+struct Codec {
+    std::string name;
+    size_t data_bits = 1;
+    size_t code_bits = 1;
+    BitTransform encode;
+    BitTransform decode;
+    SoftDecode decode_soft;
+    ErasureDecode decode_erasures;
+    BitTransformInto encode_into;
+    BitTransformInto decode_into;
+    SoftDecodeInto decode_soft_into;
+    ErasureDecodeInto decode_erasures_into;
+    size_t stream_blocks = 1;
+};
+
+/**
+ * Output size of encode_into or decode_into (and of the soft and erasure
+ * _into forms, which decode): whole blocks covering the input.
+ * 
+ * @param codec Codec
+ * @param input_bits Input bits
+ * @param encode true for encode_into, false for decode_into
+ * @return Output bits
+ */
+size_t coded_size(const Codec& codec, size_t input_bits, bool encode);
+
+/**
+ * Encode into arena storage. Uses encode_into when the codec has it, so no
+ * heap allocation happens once the arena is large enough; otherwise the
+ * result of encode is copied into the arena.
+ * 
+ * @param codec Codec
+ * @param bits Input bits
+ * @param arena Arena holding the result until its next reset
+ * @return Encoded bits
+ */
+util::BitSpan encode(const Codec& codec, util::ConstBitSpan bits, util::BitArena& arena);
+
+/**
+ * Decode into arena storage, as encode with an arena.
+ * 
+ * @param codec Codec
+ * @param bits Received bits
+ * @param arena Arena holding the result until its next reset
+ * @return Decoded bits
+ * @throws std::invalid_argument if the codec rejects the input
+ */
+util::BitSpan decode(const Codec& codec, util::ConstBitSpan bits, util::BitArena& arena);
+
+/**
+ * Incremental encoder or decoder for streams larger than memory.
+ * Input is buffered until a whole number of coding units (stream_blocks
+ * blocks) is available and then coded in chunks, so the output is
+ * identical to coding the whole stream at once while at most one chunk of
+ * input is held. Codecs with stream_blocks == 0 are buffered until finish().
+ */
+class ChunkedCoder {
+public:
+    enum class Mode {
+        encode,
+        decode
+    };
+    
+    /**
+     * Default input bits coded per step.
+     */
+    static constexpr size_t kDefaultChunkBits = size_t{1} << 20;
+    
+    /**
+     * @param codec Codec
+     * @param mode Encode or decode
+     * @param chunk_bits Input bits coded per step, rounded down to whole coding units (at least one)
+     */
+    ChunkedCoder(const Codec& codec, Mode mode, size_t chunk_bits = kDefaultChunkBits);
+    
+    /**
+     * Add input bits. Whole chunks are coded straight from bits when
+     * nothing is buffered, so only the unaligned remainder is copied.
+     * 
+     * @param bits Next input bits of the stream
+     * @return Output bits completed by this input (possibly empty)
+     * @throws std::invalid_argument if the codec rejects a chunk
+     */
+    std::vector<uint8_t> push(util::ConstBitSpan bits);
+    
+    /**
+     * Code the buffered tail of the stream (encode pads the final block as
+     * Codec::encode does; decode requires the codec's block alignment).
+     * 
+     * @return Remaining output bits
+     * @throws std::invalid_argument if the codec rejects the tail
+     */
+    std::vector<uint8_t> finish();
+    
+    size_t chunk_bits() const { return chunk_bits_; }  // Input bits per step, 0 = whole stream
+    
+private:
+    std::vector<uint8_t> code(util::ConstBitSpan bits) const;
+    
+    Codec codec_;
+    Mode mode_;
+    size_t chunk_bits_;
+    std::vector<uint8_t> pending_;
+};
+
+/**
+ * Decode channel LLRs with the codec's soft decoder, or with hard
+ * decisions and the hard decoder if the codec has none.
+ * 
+ * @param codec Codec
+ * @param llrs Channel LLRs
+ * @return Decoded bit vector
+ */
+std::vector<uint8_t> decode_llr(const Codec& codec, util::ConstSpan<float> llrs);
+
+/**
+ * decode_llr into arena storage, through decode_soft_into when the codec
+ * has it; a codec without a soft decoder takes hard decisions in the arena.
+ * 
+ * @param codec Codec
+ * @param llrs Channel LLRs
+ * @param arena Arena holding the result until its next reset
+ * @return Decoded bits
+ */
+util::BitSpan decode_llr(const Codec& codec, util::ConstSpan<float> llrs, util::BitArena& arena);
+
+/**
+ * Decode bits received over an erasure channel.
+ * Uses the codec's erasure decoder when present. Otherwise a soft decoder
+ * is given zero LLRs at erased positions, and as a last resort the hard
+ * decoder sees the received bits as they are.
+ * 
+ * @param codec Codec
+ * @param bits Received bits (values at erased positions are ignored when possible)
+ * @param erasures Erasure mask (1 = erased) covering at least bits.size() bits
+ * @return Decoded bit vector
+ * @throws std::invalid_argument if the erasure mask is too short
+ */
+std::vector<uint8_t> decode_with_erasures(const Codec& codec, util::ConstBitSpan bits, util::PackedBitSpan erasures);
+
+/**
+ * decode_with_erasures into arena storage, through decode_erasures_into
+ * when the codec has it.
+ * 
+ * @param codec Codec
+ * @param bits Received bits
+ * @param erasures Erasure mask (1 = erased) covering at least bits.size() bits
+ * @param arena Arena holding the result until its next reset
+ * @return Decoded bits
+ * @throws std::invalid_argument if the erasure mask is too short
+ */
+util::BitSpan decode_with_erasures(
+    const Codec& codec,
+    util::ConstBitSpan bits,
+    util::PackedBitSpan erasures,
+    util::BitArena& arena
+);
+
+/**
+ * Repetition code: 1 data bit -> n code bits.
+ * 
+ * @param n Repetition factor (must be > 0)
+ * @throws std::invalid_argument if n <= 0
+ */
+Codec make_repetition(int n);
+
+/**
+ * Hamming(7,4): 4 data bits -> 7 code bits.
+ */
+Codec make_hamming74();
+
+/**
+ * 2D Hamming(7,4) product code: 16 data bits -> 49 code bits.
+ * 
+ * @param max_iterations Maximum iterative row/column decoding passes (must be > 0)
+ * @throws std::invalid_argument if max_iterations <= 0
+ */
+Codec make_product(int max_iterations = 4);
+
+/**
+ * Serially concatenated code: outer -> block interleaver -> inner.
+ * A frame holds at least depth outer codewords, rounded up so that the
+ * interleaved outer output fills a whole number of inner blocks. Within a
+ * frame the interleaver writes outer codewords as rows and reads columns,
+ * so a burst of inner decoding failures is spread across outer codewords.
+ * 
+ * @param outer Outer codec (applied first on encode)
+ * @param inner Inner codec (applied last on encode)
+ * @param depth Minimum number of outer codewords per interleaver frame (must be > 0)
+ * @throws std::invalid_argument if depth == 0
+ */
+Codec make_concatenated(const Codec& outer, const Codec& inner, size_t depth);
+
+/**
+ * Wrap a codec with an interleaver on the channel side.
+ * Encoding interleaves the codec output; decoding deinterleaves before the
+ * codec sees the bits, so channel bursts are spread across codewords.
+ * 
+ * @param codec Codec to wrap
+ * @param spec Interleaver applied to the encoded stream
+ * @return Codec with the same block sizes
+ * @throws std::invalid_argument if the spec dimensions are invalid
+ */
+Codec make_interleaved(const Codec& codec, const interleaver::Spec& spec);
+
+/**
+ * Construct a codec by name.
+ * 
+ * @param name "repetition", "hamming" or "product"
+ * @param n Repetition factor for "repetition", iteration limit for "product" (0 = default)
+ * @return Codec
+ * @throws std::invalid_argument if the name is unknown or parameters are invalid
+ */
+Codec make_codec(const std::string& name, int n = 0);
+
+} // namespace bitshield::codec
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <bitshield/bitspan.hpp>
 #include <vector>
 #include <cstdint>
+#include <cstddef>
 
 namespace bitshield::codec::hamming74 {
 
@@ -14,7 +16,7 @@ namespace bitshield::codec::hamming74 {
  * @return 7-bit codeword
  * @throws std::invalid_argument if data_bits.size() != 4
  */
-std::vector<uint8_t> encode(const std::vector<uint8_t>& data_bits);
+std::vector<uint8_t> encode(util::ConstBitSpan data_bits);
 
 /**
  * Decode a 7-bit Hamming codeword to 4 data bits with error correction.
@@ -24,26 +26,119 @@ std::vector<uint8_t> encode(const std::vector<uint8_t>& data_bits);
  * @return 4-bit data vector
  * @throws std::invalid_argument if codeword.size() != 7
  */
-std::vector<uint8_t> decode(const std::vector<uint8_t>& codeword);
+std::vector<uint8_t> decode(util::ConstBitSpan codeword);
+
+/**
+ * Correct up to 1 bit error in a 7-bit codeword in place.
+ * The codeword bits are bits[0], bits[stride], ..., bits[6 * stride], so
+ * rows and columns of a shared buffer can be decoded without copying.
+ * 
+ * @param bits Pointer to the first codeword bit
+ * @param stride Distance between consecutive codeword bits
+ * @return true if a bit was flipped
+ */
+bool correct(uint8_t* bits, size_t stride = 1);
 
 /**
  * Encode a bit vector using Hamming(7,4).
  * Input is padded with zeros if not a multiple of 4 bits.
  * 
- * @param bits Input bit vector
+ * @param bits Input bits
  * @return Encoded bit vector (multiple of 7 bits)
  */
-std::vector<uint8_t> encode_bits(const std::vector<uint8_t>& bits);
+std::vector<uint8_t> encode_bits(util::ConstBitSpan bits);
+
+/**
+ * Encode bits using Hamming(7,4) into caller-provided storage.
+ * 
+ * @param bits Input bits (zero-padded to a multiple of 4)
+ * @param encoded Receives (bits.size() + 3) / 4 * 7 bits in its first elements
+ * @throws std::invalid_argument if encoded is too small
+ */
+void encode_bits(util::ConstBitSpan bits, util::BitSpan encoded);
 
 /**
  * Decode a bit vector using Hamming(7,4).
  * Input must be a multiple of 7 bits.
  * 
- * @param encoded Encoded bit vector
+ * @param encoded Encoded bits
  * @return Decoded bit vector (multiple of 4 bits)
  * @throws std::invalid_argument if encoded.size() is not a multiple of 7
  */
-std::vector<uint8_t> decode_bits(const std::vector<uint8_t>& encoded);
+std::vector<uint8_t> decode_bits(util::ConstBitSpan encoded);
 
-} // namespace bitshield::codec::hamming74
+/**
+ * Decode bits using Hamming(7,4) into caller-provided storage, e.g. a
+ * buffer reused across trials. The input is not modified.
+ * 
+ * @param encoded Encoded bits (multiple of 7)
+ * @param decoded Receives encoded.size() / 7 * 4 bits in its first elements
+ * @throws std::invalid_argument if encoded.size() is not a multiple of 7 or decoded is too small
+ */
+void decode_bits(util::ConstBitSpan encoded, util::BitSpan decoded);
+
+/**
+ * Decode a bit vector received over an erasure channel.
+ * The erased positions of each codeword are filled by trying every
+ * completion and keeping the first one that forms a valid codeword, so up
+ * to two erasures per codeword are always recovered. If no completion is a
+ * codeword the erased bits are zeroed and one error is corrected as in
+ * decode_bits.
+ * 
+ * @param encoded Received bits (values at erased positions are ignored)
+ * @param erasures Erasure mask (1 = erased) covering at least encoded.size() bits
+ * @return Decoded bit vector (multiple of 4 bits)
+ * @throws std::invalid_argument if encoded.size() is not a multiple of 7 or the erasure mask is too short
+ */
+std::vector<uint8_t> decode_erasure_bits(util::ConstBitSpan encoded, util::PackedBitSpan erasures);
+
+/**
+ * Erasure-aware decode into caller-provided storage.
+ * 
+ * @param encoded Received bits (multiple of 7; values at erased positions are ignored)
+ * @param erasures Erasure mask (1 = erased) covering at least encoded.size() bits
+ * @param decoded Receives encoded.size() / 7 * 4 bits in its first elements
+ * @throws std::invalid_argument if encoded.size() is not a multiple of 7, the erasure mask is too short or decoded is too small
+ */
+void decode_erasure_bits(util::ConstBitSpan encoded, util::PackedBitSpan erasures, util::BitSpan decoded);
+
+/**
+ * Soft-decision maximum-likelihood decode using Hamming(7,4).
+ * Each 7-LLR block is correlated with all 16 codewords (in BPSK form) and
+ * the best-matching codeword is selected, which also resolves many
+ * double-error patterns the hard syndrome decoder miscorrects.
+ * 
+ * @param llrs Channel LLRs (see llr.hpp for the sign convention)
+ * @return Decoded bit vector (multiple of 4 bits)
+ * @throws std::invalid_argument if llrs.size() is not a multiple of 7
+ */
+std::vector<uint8_t> decode_soft_bits(util::ConstSpan<float> llrs);
+
+/**
+ * Soft-decision maximum-likelihood decode from int8 quantised LLRs.
+ * 
+ * @param llrs Quantised channel LLRs
+ * @return Decoded bit vector (multiple of 4 bits)
+ * @throws std::invalid_argument if llrs.size() is not a multiple of 7
+ */
+std::vector<uint8_t> decode_soft_bits(util::ConstSpan<int8_t> llrs);
+
+/**
+ * Soft-decision decode into caller-provided storage.
+ * 
+ * @param llrs Channel LLRs (multiple of 7)
+ * @param decoded Receives llrs.size() / 7 * 4 bits in its first elements
+ * @throws std::invalid_argument if llrs.size() is not a multiple of 7 or decoded is too small
+ */
+void decode_soft_bits(util::ConstSpan<float> llrs, util::BitSpan decoded);
 
+/**
+ * Soft-decision decode of int8 quantised LLRs into caller-provided storage.
+ * 
+ * @param llrs Quantised channel LLRs (multiple of 7)
+ * @param decoded Receives llrs.size() / 7 * 4 bits in its first elements
+ * @throws std::invalid_argument if llrs.size() is not a multiple of 7 or decoded is too small
+ */
+void decode_soft_bits(util::ConstSpan<int8_t> llrs, util::BitSpan decoded);
+
+} // namespace bitshield::codec::hamming74
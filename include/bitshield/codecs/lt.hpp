@@ -0,0 +1,116 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace bitshield::codec::lt {
+
+/**
+ * Robust soliton degree distribution parameters.
+ * c scales the size of the decoding ripple, delta bounds the failure
+ * probability of the peeling decoder after k + O(sqrt(k) ln^2(k/delta)) packets.
+ */
+struct Parameters {
+    double c = 0.1;
+    double delta = 0.5;
+};
+
+/**
+ * Encoded LT packet.
+ * The packet id, together with the encoder seed, determines which source
+ * symbols were XORed into the payload, so only the id travels with the data.
+ */
+struct Packet {
+    uint32_t id = 0;
+    std::vector<uint8_t> payload;
+};
+
+/**
+ * Outcome of an LT decode attempt.
+ */
+struct DecodeResult {
+    bool success = false;
+    std::vector<std::vector<uint8_t>> symbols;  // Recovered source symbols (valid if success)
+    size_t peeled = 0;                          // Symbols recovered by the peeling decoder
+    size_t eliminated = 0;                      // Symbols recovered by Gaussian elimination
+};
+
+/**
+ * Compute the robust soliton degree distribution for k source symbols.
+ * 
+ * @param k Number of source symbols (must be > 0)
+ * @param params Distribution parameters
+ * @return Probability of each degree; index 0 is unused and always 0
+ * @throws std::invalid_argument if k == 0, k >= 2^32, c <= 0 or delta not in (0, 1)
+ */
+std::vector<double> robust_soliton(size_t k, const Parameters& params = Parameters{});
+
+/**
+ * Source symbol indices combined into the packet with the given id.
+ * 
+ * @param id Packet id
+ * @param k Number of source symbols
+ * @param seed Encoder seed
+ * @param params Distribution parameters
+ * @return Sorted, distinct source symbol indices
+ */
+std::vector<size_t> neighbours(
+    uint32_t id,
+    size_t k,
+    uint32_t seed,
+    const Parameters& params = Parameters{}
+);
+
+/**
+ * Generate encoded packets with consecutive ids starting at first_id.
+ * All source symbols must have the same size.
+ * 
+ * @param symbols Source symbols
+ * @param count Number of packets to generate
+ * @param seed Encoder seed (the decoder must use the same seed)
+ * @param params Distribution parameters
+ * @param first_id Id of the first generated packet
+ * @return Encoded packets
+ * @throws std::invalid_argument if symbols is empty or symbol sizes differ
+ */
+std::vector<Packet> encode(
+    const std::vector<std::vector<uint8_t>>& symbols,
+    size_t count,
+    uint32_t seed,
+    const Parameters& params = Parameters{},
+    uint32_t first_id = 0
+);
+
+/**
+ * Decode source symbols from received packets.
+ * Runs the peeling (belief propagation) decoder first and falls back to
+ * Gaussian elimination over GF(2) on the remaining packets when the ripple
+ * empties before all symbols are recovered.
+ * 
+ * @param packets Received packets (any order, duplicates allowed)
+ * @param k Number of source symbols
+ * @param symbol_size Size of each symbol in bytes
+ * @param seed Encoder seed
+ * @param params Distribution parameters
+ * @return Decode result; success is false if the packets do not determine all symbols
+ * @throws std::invalid_argument if k == 0 or a payload size differs from symbol_size
+ */
+DecodeResult decode(
+    const std::vector<Packet>& packets,
+    size_t k,
+    size_t symbol_size,
+    uint32_t seed,
+    const Parameters& params = Parameters{}
+);
+
+/**
+ * XOR src into dst, word at a time.
+ * 
+ * @param dst Destination buffer
+ * @param src Source buffer
+ * @param size Number of bytes
+ */
+void xor_into(uint8_t* dst, const uint8_t* src, size_t size);
+
+} // namespace bitshield::codec::lt
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <bitshield/bitspan.hpp>
+#include <vector>
+#include <cstdint>
+
+namespace bitshield::codec::product {
+
+/**
+ * Encode a bit vector using the 2D Hamming(7,4) x Hamming(7,4) product code.
+ * Each block of 16 data bits is arranged as a 4x4 array; rows and then
+ * columns are Hamming(7,4) encoded, giving a 49-bit (7x7, row-major) codeword.
+ * Input is padded with zeros if not a multiple of 16 bits.
+ * 
+ * @param bits Input bits
+ * @return Encoded bit vector (multiple of 49 bits)
+ */
+std::vector<uint8_t> encode_bits(util::ConstBitSpan bits);
+
+/**
+ * Encode bits using the product code into caller-provided storage.
+ * 
+ * @param bits Input bits (zero-padded to a multiple of 16)
+ * @param encoded Receives (bits.size() + 15) / 16 * 49 bits in its first elements
+ * @throws std::invalid_argument if encoded is too small
+ */
+void encode_bits(util::ConstBitSpan bits, util::BitSpan encoded);
+
+/**
+ * Decode a bit vector using the 2D Hamming(7,4) product code.
+ * Rows and columns of each block are corrected in place on a working copy
+ * of the block and the row/column passes are repeated until no further corrections are made
+ * or max_iterations is reached.
+ * 
+ * @param encoded Encoded bits
+ * @param max_iterations Maximum number of row+column passes (must be > 0)
+ * @return Decoded bit vector (multiple of 16 bits)
+ * @throws std::invalid_argument if encoded.size() is not a multiple of 49 or max_iterations <= 0
+ */
+std::vector<uint8_t> decode_bits(util::ConstBitSpan encoded, int max_iterations = 4);
+
+/**
+ * Decode bits using the product code into caller-provided storage.
+ * 
+ * @param encoded Encoded bits (multiple of 49)
+ * @param decoded Receives encoded.size() / 49 * 16 bits in its first elements
+ * @param max_iterations Maximum number of row+column passes (must be > 0)
+ * @throws std::invalid_argument if encoded.size() is not a multiple of 49, max_iterations <= 0 or decoded is too small
+ */
+void decode_bits(util::ConstBitSpan encoded, util::BitSpan decoded, int max_iterations = 4);
+
+} // namespace bitshield::codec::product
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <bitshield/bitspan.hpp>
 #include <vector>
 #include <cstdint>
 
@@ -9,23 +10,107 @@ namespace bitshield::codec::repetition {
  * Encode bits using repetition code.
  * Each bit is repeated n times.
  * 
- * @param bits Input bit vector
+ * @param bits Input bits
  * @param n Repetition factor (must be > 0)
  * @return Encoded bit vector
  * @throws std::invalid_argument if n <= 0
  */
-std::vector<uint8_t> encode(const std::vector<uint8_t>& bits, int n);
+std::vector<uint8_t> encode(util::ConstBitSpan bits, int n);
+
+/**
+ * Encode bits using repetition code into caller-provided storage.
+ * 
+ * @param bits Input bits
+ * @param encoded Receives bits.size() * n bits in its first elements
+ * @param n Repetition factor (must be > 0)
+ * @throws std::invalid_argument if n <= 0 or encoded is too small
+ */
+void encode(util::ConstBitSpan bits, util::BitSpan encoded, int n);
 
 /**
  * Decode bits using repetition code with majority vote.
  * Groups of n bits are decoded by majority vote.
  * 
- * @param encoded Encoded bit vector
+ * @param encoded Encoded bits
  * @param n Repetition factor (must be > 0)
  * @return Decoded bit vector
  * @throws std::invalid_argument if n <= 0
  */
-std::vector<uint8_t> decode(const std::vector<uint8_t>& encoded, int n);
+std::vector<uint8_t> decode(util::ConstBitSpan encoded, int n);
 
-} // namespace bitshield::codec::repetition
+/**
+ * Decode bits using repetition code into caller-provided storage.
+ * 
+ * @param encoded Encoded bits
+ * @param decoded Receives (encoded.size() + n - 1) / n bits in its first elements
+ * @param n Repetition factor (must be > 0)
+ * @throws std::invalid_argument if n <= 0 or decoded is too small
+ */
+void decode(util::ConstBitSpan encoded, util::BitSpan decoded, int n);
+
+/**
+ * Decode over an erasure channel by majority vote over the non-erased copies
+ * of each group. Groups whose copies are all erased, or whose votes tie,
+ * decode to 0 as in decode.
+ * 
+ * @param encoded Received bits (values at erased positions are ignored)
+ * @param erasures Erasure mask (1 = erased) covering at least encoded.size() bits
+ * @param n Repetition factor (must be > 0)
+ * @return Decoded bit vector
+ * @throws std::invalid_argument if n <= 0 or the erasure mask is too short
+ */
+std::vector<uint8_t> decode_erasures(util::ConstBitSpan encoded, util::PackedBitSpan erasures, int n);
+
+/**
+ * Erasure-aware decode into caller-provided storage.
+ * 
+ * @param encoded Received bits (values at erased positions are ignored)
+ * @param erasures Erasure mask (1 = erased) covering at least encoded.size() bits
+ * @param decoded Receives (encoded.size() + n - 1) / n bits in its first elements
+ * @param n Repetition factor (must be > 0)
+ * @throws std::invalid_argument if n <= 0, the erasure mask is too short or decoded is too small
+ */
+void decode_erasures(util::ConstBitSpan encoded, util::PackedBitSpan erasures, util::BitSpan decoded, int n);
+
+/**
+ * Soft-decision decode: sum the LLRs of each group of n copies.
+ * A negative sum decodes to 1, otherwise 0 (ties decode to 0 as in decode).
+ * 
+ * @param llrs Channel LLRs (see llr.hpp for the sign convention)
+ * @param n Repetition factor (must be > 0)
+ * @return Decoded bit vector
+ * @throws std::invalid_argument if n <= 0
+ */
+std::vector<uint8_t> decode_soft(util::ConstSpan<float> llrs, int n);
+
+/**
+ * Soft-decision decode from int8 quantised LLRs.
+ * 
+ * @param llrs Quantised channel LLRs
+ * @param n Repetition factor (must be > 0)
+ * @return Decoded bit vector
+ * @throws std::invalid_argument if n <= 0
+ */
+std::vector<uint8_t> decode_soft(util::ConstSpan<int8_t> llrs, int n);
 
+/**
+ * Soft-decision decode into caller-provided storage.
+ * 
+ * @param llrs Channel LLRs
+ * @param decoded Receives (llrs.size() + n - 1) / n bits in its first elements
+ * @param n Repetition factor (must be > 0)
+ * @throws std::invalid_argument if n <= 0 or decoded is too small
+ */
+void decode_soft(util::ConstSpan<float> llrs, util::BitSpan decoded, int n);
+
+/**
+ * Soft-decision decode of int8 quantised LLRs into caller-provided storage.
+ * 
+ * @param llrs Quantised channel LLRs
+ * @param decoded Receives (llrs.size() + n - 1) / n bits in its first elements
+ * @param n Repetition factor (must be > 0)
+ * @throws std::invalid_argument if n <= 0 or decoded is too small
+ */
+void decode_soft(util::ConstSpan<int8_t> llrs, util::BitSpan decoded, int n);
+
+} // namespace bitshield::codec::repetition
@@ -0,0 +1,268 @@
+#pragma once
+
+#include <bitshield/bitspan.hpp>
+#include <bitshield/io.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace bitshield::io {
+
+/**
+ * Current version of the .bsh container format.
+ */
+constexpr uint16_t kContainerVersion = 1;
+
+/**
+ * Default payload bytes per container chunk.
+ */
+constexpr uint32_t kContainerChunkBytes = 64 * 1024;
+
+/**
+ * Metadata stored in a .bsh container header.
+ * The codec is recorded by name plus the (key, value) parameters needed to
+ * rebuild it (for the CLI: its codec options without the leading dashes,
+ * e.g. {"n", "5"}), so a container can be decoded without repeating them.
+ */
+struct ContainerHeader {
+    uint16_t version = kContainerVersion;
+    std::string codec;
+    std::vector<std::pair<std::string, std::string>> parameters;
+    uint64_t payload_bits = 0;
+    uint32_t chunk_bytes = kContainerChunkBytes;
+};
+
+/**
+ * Header payload length of containers written in one pass, whose length is
+ * only known at the end (the footer always holds the actual length).
+ */
+constexpr uint64_t kContainerUnknownLength = ~uint64_t{0};
+
+/**
+ * Write bits to a .bsh container.
+ * 
+ * Layout (integers little-endian):
+ * - Header: magic "BSH1", version, header size, payload bit length (or
+ *   kContainerUnknownLength), chunk size, codec name and parameters,
+ *   CRC-32C of the header
+ * - Chunks: payload packed MSB-first (as by util::bits_to_bytes), chunk_bytes
+ *   per chunk except the last, each as a record of its size, the bytes and
+ *   their CRC-32C; a zero size record ends the payload
+ * - Index: file offset of the bytes, size and CRC-32C of every chunk
+ * - Footer: index offset, chunk count, payload bit length, CRC-32C of the
+ *   index, magic "BSHX"
+ * The size records and the terminator let the file be read front to back
+ * from a pipe; the index and footer give random access to files.
+ * 
+ * @param path File path, or "-" for standard output
+ * @param bits Payload bit vector
+ * @param codec Codec name (may be empty)
+ * @param parameters Codec parameters
+ * @param chunk_bytes Payload bytes per chunk (must be > 0)
+ * @throws std::invalid_argument if chunk_bytes == 0 or a string exceeds 65535 bytes
+ * @throws std::runtime_error if the file cannot be written
+ */
+void write_container(
+    const std::string& path,
+    const std::vector<uint8_t>& bits,
+    const std::string& codec,
+    const std::vector<std::pair<std::string, std::string>>& parameters = {},
+    uint32_t chunk_bytes = kContainerChunkBytes
+);
+
+/**
+ * Incremental .bsh writer: bits are packed as they arrive and every full
+ * chunk is written immediately, so memory use is bounded by one chunk.
+ */
+class ContainerWriter {
+public:
+    /**
+     * Write the header.
+     * 
+     * @param path File path, or "-" for standard output
+     * @param codec Codec name (may be empty)
+     * @param parameters Codec parameters
+     * @param chunk_bytes Payload bytes per chunk (must be > 0)
+     * @param payload_bits Total bits if known in advance, else kContainerUnknownLength
+     * @throws std::invalid_argument if chunk_bytes == 0 or a string exceeds 65535 bytes
+     * @throws std::runtime_error if the file cannot be written
+     */
+    ContainerWriter(
+        const std::string& path,
+        const std::string& codec,
+        const std::vector<std::pair<std::string, std::string>>& parameters = {},
+        uint32_t chunk_bytes = kContainerChunkBytes,
+        uint64_t payload_bits = kContainerUnknownLength
+    );
+    
+    ContainerWriter(const ContainerWriter&) = delete;
+    ContainerWriter& operator=(const ContainerWriter&) = delete;
+    
+    /**
+     * Append payload bits.
+     * 
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void write(const std::vector<uint8_t>& bits);
+    
+    /**
+     * Write the last chunk, the index and the footer.
+     * 
+     * @throws std::invalid_argument if fewer or more bits were written than announced
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void finish();
+    
+private:
+    void flush_chunk();
+    
+    OutputFile file_;
+    uint32_t chunk_bytes_;
+    uint64_t expected_bits_;
+    uint64_t bits_ = 0;
+    uint64_t offset_ = 0;
+    std::vector<uint8_t> chunk_;
+    unsigned partial_ = 0;        // Bits of the incomplete last byte, MSB-aligned
+    std::vector<uint8_t> index_;
+};
+
+/**
+ * Check whether a file starts with the .bsh magic.
+ * 
+ * @param path File path
+ * @return true if the file is a .bsh container
+ */
+bool is_container(const std::string& path);
+
+/**
+ * Check whether an input stream starts with the .bsh magic, without consuming it.
+ * 
+ * @param file Input file
+ * @return true if the stream is a .bsh container
+ */
+bool is_container(InputFile& file);
+
+/**
+ * Random-access reader for .bsh containers.
+ * The file is memory-mapped; the header, footer and index are validated on
+ * open, and a chunk's CRC is checked every time the chunk is read, so the
+ * reader holds no mutable state and can be shared between threads.
+ */
+class ContainerReader {
+public:
+    /**
+     * Open a container.
+     * 
+     * @param path File path
+     * @throws std::runtime_error if the file cannot be read, is not a container,
+     *         has an unsupported version or fails a header or index check
+     */
+    explicit ContainerReader(const std::string& path);
+    
+    const ContainerHeader& header() const { return header_; }
+    size_t chunk_count() const { return index_.size(); }
+    
+    /**
+     * Read a range of payload bits, touching only the chunks it overlaps.
+     * 
+     * @param first Index of the first bit
+     * @param count Number of bits
+     * @return Bit vector (one 0/1 value per element)
+     * @throws std::invalid_argument if the range passes the end of the payload
+     * @throws std::runtime_error if a chunk fails its CRC check
+     */
+    std::vector<uint8_t> read_bits(uint64_t first, uint64_t count) const;
+    
+    /**
+     * Read a range of payload bits into a reusable vector, unpacking
+     * straight from the mapped chunks.
+     * 
+     * @param first Index of the first bit
+     * @param count Number of bits
+     * @param bits Receives the bits (resized to count)
+     * @throws std::invalid_argument if the range passes the end of the payload
+     * @throws std::runtime_error if a chunk fails its CRC check
+     */
+    void read_bits(uint64_t first, uint64_t count, std::vector<uint8_t>& bits) const;
+    
+    /**
+     * Read a range of payload bits into caller-owned storage, e.g. a slice
+     * of a buffer reused across calls.
+     * 
+     * @param first Index of the first bit
+     * @param count Number of bits
+     * @param bits Receives the bits in its first count elements
+     * @throws std::invalid_argument if the range passes the end of the payload or bits is too small
+     * @throws std::runtime_error if a chunk fails its CRC check
+     */
+    void read_bits(uint64_t first, uint64_t count, util::BitSpan bits) const;
+    
+    /**
+     * Read the whole payload.
+     * 
+     * @return Bit vector
+     * @throws std::runtime_error if a chunk fails its CRC check
+     */
+    std::vector<uint8_t> read_all() const;
+    
+private:
+    struct IndexEntry {
+        uint64_t offset;
+        uint32_t size;
+        uint32_t crc;
+    };
+    
+    const uint8_t* chunk(size_t i) const;
+    
+    MappedFile file_;
+    ContainerHeader header_;
+    std::vector<IndexEntry> index_;
+};
+
+/**
+ * Sequential .bsh reader for streams that cannot be mapped, such as
+ * standard input. Chunks are read front to back and CRC-checked one at a
+ * time; the index and footer are checked against them at the end.
+ */
+class ContainerStreamReader {
+public:
+    /**
+     * Read and validate the header.
+     * 
+     * @param file Input positioned at the start of the container (must outlive the reader)
+     * @throws std::runtime_error if the input is not a valid container
+     */
+    explicit ContainerStreamReader(InputFile& file);
+    
+    /**
+     * Header; payload_bits is only final once next() has returned false.
+     */
+    const ContainerHeader& header() const { return header_; }
+    
+    /**
+     * Read the payload bits of the next chunk.
+     * 
+     * @param bits Receives the bits of the next chunk
+     * @return false once the payload is exhausted
+     * @throws std::runtime_error if a chunk, the index or the footer is invalid
+     */
+    bool next(std::vector<uint8_t>& bits);
+    
+private:
+    bool read_record(std::vector<uint8_t>& bytes);
+    void read_trailer();
+    
+    InputFile& file_;
+    ContainerHeader header_;
+    uint64_t offset_ = 0;
+    std::vector<uint8_t> held_;    // Last chunk read, emitted once the next record shows it is not the final one
+    std::vector<uint8_t> following_;   // Record after held_, reused between calls
+    bool have_held_ = false;
+    bool done_ = false;
+    uint64_t emitted_bits_ = 0;
+    std::vector<uint8_t> index_;   // Index entries rebuilt from the chunks read
+};
+
+} // namespace bitshield::io
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace bitshield::crc {
+
+/**
+ * Supported CRC algorithms (Rocksoft model names in parentheses).
+ */
+enum class Algorithm {
+    crc8,    // CRC-8/SMBUS:       poly 0x07, init 0, not reflected
+    crc16,   // CRC-16/IBM-3740:   poly 0x1021, init 0xFFFF, not reflected
+    crc32,   // CRC-32/ISO-HDLC:   poly 0x04C11DB7, reflected (zlib, Ethernet)
+    crc32c,  // CRC-32/ISCSI:      poly 0x1EDC6F41, reflected (Castagnoli)
+    crc64    // CRC-64/XZ:         poly 0x42F0E1EBA9EA3693, reflected
+};
+
+/**
+ * Kernel used to process bytes.
+ */
+enum class Implementation {
+    bitwise,    // One bit per step (reference)
+    slicing8,   // Table driven, 8 bytes per step
+    pclmul      // Carry-less multiply folding (x86 PCLMULQDQ), CRC-32 variants only
+};
+
+/**
+ * Rocksoft model parameters of an algorithm.
+ */
+struct Parameters {
+    int width;
+    uint64_t poly;      // Normal (MSB-first) polynomial without the x^width term
+    uint64_t init;
+    bool reflected;     // refin == refout
+    uint64_t xorout;
+    uint64_t check;     // CRC of the ASCII string "123456789"
+};
+
+/**
+ * Get the model parameters of an algorithm.
+ * 
+ * @param algo Algorithm
+ * @return Parameters
+ */
+const Parameters& parameters(Algorithm algo);
+
+/**
+ * Compute the CRC of a byte buffer using the fastest available kernel.
+ * 
+ * @param algo Algorithm
+ * @param data Byte buffer
+ * @param size Number of bytes
+ * @return CRC value (width bits, right-aligned)
+ */
+uint64_t compute(Algorithm algo, const uint8_t* data, size_t size);
+
+/**
+ * Compute the CRC of a byte vector using the fastest available kernel.
+ * 
+ * @param algo Algorithm
+ * @param bytes Byte vector
+ * @return CRC value (width bits, right-aligned)
+ */
+uint64_t compute(Algorithm algo, const std::vector<uint8_t>& bytes);
+
+/**
+ * Compute the CRC of a bit vector (one 0/1 value per element).
+ * Bits are packed MSB-first as by util::bits_to_bytes, so a bit vector of
+ * whole bytes has the same CRC as its packed form. A trailing partial byte
+ * is fed bit by bit in stream order.
+ * 
+ * @param algo Algorithm
+ * @param bits Bit vector
+ * @return CRC value (width bits, right-aligned)
+ */
+uint64_t compute_bits(Algorithm algo, const std::vector<uint8_t>& bits);
+
+/**
+ * Compute the CRC of a byte buffer with a specific kernel.
+ * 
+ * @param algo Algorithm
+ * @param impl Kernel to use
+ * @param data Byte buffer
+ * @param size Number of bytes
+ * @return CRC value (width bits, right-aligned)
+ * @throws std::invalid_argument if the kernel is not available for the algorithm on this CPU
+ */
+uint64_t compute_with(Algorithm algo, Implementation impl, const uint8_t* data, size_t size);
+
+/**
+ * Check whether a kernel can run for an algorithm on this CPU.
+ * 
+ * @param algo Algorithm
+ * @param impl Kernel
+ * @return true if compute_with(algo, impl, ...) is supported
+ */
+bool is_available(Algorithm algo, Implementation impl);
+
+/**
+ * Kernel selected by compute() for an algorithm.
+ * 
+ * @param algo Algorithm
+ * @return Implementation
+ */
+Implementation dispatched(Algorithm algo);
+
+} // namespace bitshield::crc
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <bitshield/bitspan.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace bitshield::interleaver {
+
+/**
+ * Interleaver families.
+ */
+enum class Kind {
+    block,          // Row-column: write rows, read columns
+    helical,        // Row-column with column c rotated by c rows
+    random,         // Seeded pseudo-random permutation per block
+    convolutional   // Forney convolutional interleaver (rows branches, cols delay unit)
+};
+
+/**
+ * Interleaver description usable as a pipeline stage.
+ * block, helical: rows x cols bits per block.
+ * random: rows * cols bits per block, permuted with seed.
+ * convolutional: rows branches, branch j delays by j * cols * rows bits;
+ * the interleaved stream is (rows - 1) * cols * rows bits longer than the input.
+ */
+struct Spec {
+    Kind kind = Kind::block;
+    size_t rows = 1;
+    size_t cols = 1;
+    uint32_t seed = 0;
+};
+
+/**
+ * Block (row-column) interleave a bit vector.
+ * Each block of rows*cols bits is written row by row and read column by
+ * column, so bits that were adjacent end up rows positions apart.
+ * A trailing partial block is passed through unchanged.
+ * 
+ * @param bits Input bit vector
+ * @param rows Number of rows per block (must be > 0)
+ * @param cols Number of columns per block (must be > 0)
+ * @return Interleaved bit vector (same size as input)
+ * @throws std::invalid_argument if rows == 0 or cols == 0
+ */
+std::vector<uint8_t> block_interleave(util::ConstBitSpan bits, size_t rows, size_t cols);
+
+/**
+ * Block interleave into caller-provided storage.
+ * 
+ * @param bits Input bits
+ * @param out Receives bits.size() bits in its first elements (must not overlap bits)
+ * @param rows Number of rows per block (must be > 0)
+ * @param cols Number of columns per block (must be > 0)
+ * @throws std::invalid_argument if rows == 0, cols == 0 or out is too small
+ */
+void block_interleave(util::ConstBitSpan bits, util::BitSpan out, size_t rows, size_t cols);
+
+/**
+ * Invert block_interleave with the same rows and cols.
+ * 
+ * @param bits Interleaved bit vector
+ * @param rows Number of rows per block (must be > 0)
+ * @param cols Number of columns per block (must be > 0)
+ * @return Deinterleaved bit vector (same size as input)
+ * @throws std::invalid_argument if rows == 0 or cols == 0
+ */
+std::vector<uint8_t> block_deinterleave(util::ConstBitSpan bits, size_t rows, size_t cols);
+
+/**
+ * Invert block_interleave into caller-provided storage.
+ * 
+ * @param bits Interleaved bits
+ * @param out Receives bits.size() bits in its first elements (must not overlap bits)
+ * @param rows Number of rows per block (must be > 0)
+ * @param cols Number of columns per block (must be > 0)
+ * @throws std::invalid_argument if rows == 0, cols == 0 or out is too small
+ */
+void block_deinterleave(util::ConstBitSpan bits, util::BitSpan out, size_t rows, size_t cols);
+
+/**
+ * Helical interleave a bit vector.
+ * Like block_interleave, but column c is read starting at row c (mod rows),
+ * so consecutive columns are also staggered against row-aligned bursts.
+ * A trailing partial block is passed through unchanged.
+ * 
+ * @param bits Input bit vector
+ * @param rows Number of rows per block (must be > 0)
+ * @param cols Number of columns per block (must be > 0)
+ * @return Interleaved bit vector (same size as input)
+ * @throws std::invalid_argument if rows == 0 or cols == 0
+ */
+std::vector<uint8_t> helical_interleave(util::ConstBitSpan bits, size_t rows, size_t cols);
+
+/**
+ * Invert helical_interleave with the same rows and cols.
+ * 
+ * @throws std::invalid_argument if rows == 0 or cols == 0
+ */
+std::vector<uint8_t> helical_deinterleave(util::ConstBitSpan bits, size_t rows, size_t cols);
+
+/**
+ * Seeded pseudo-random permutation of [0, size).
+ * The permutation depends only on size and seed (not on the standard library).
+ * 
+ * @param size Permutation length
+ * @param seed Permutation seed
+ * @return perm, where interleaved[i] = input[perm[i]]
+ */
+std::vector<size_t> random_permutation(size_t size, uint32_t seed);
+
+/**
+ * Permute each block of block_size bits with random_permutation(block_size, seed).
+ * A trailing partial block is passed through unchanged.
+ * 
+ * @param bits Input bit vector
+ * @param block_size Block size in bits (must be > 0)
+ * @param seed Permutation seed
+ * @return Interleaved bit vector (same size as input)
+ * @throws std::invalid_argument if block_size == 0
+ */
+std::vector<uint8_t> random_interleave(util::ConstBitSpan bits, size_t block_size, uint32_t seed);
+
+/**
+ * Invert random_interleave with the same block_size and seed.
+ * 
+ * @throws std::invalid_argument if block_size == 0
+ */
+std::vector<uint8_t> random_deinterleave(util::ConstBitSpan bits, size_t block_size, uint32_t seed);
+
+/**
+ * Forney convolutional interleave.
+ * Bit t enters branch t % branches and is delayed by (t % branches) * delay * branches
+ * positions; gaps are filled with zeros and the output is flushed, so it is
+ * (branches - 1) * delay * branches bits longer than the input.
+ * 
+ * @param bits Input bit vector
+ * @param branches Number of branches (must be > 0)
+ * @param delay Delay unit per branch (must be > 0)
+ * @return Interleaved bit vector
+ * @throws std::invalid_argument if branches == 0 or delay == 0
+ */
+std::vector<uint8_t> convolutional_interleave(util::ConstBitSpan bits, size_t branches, size_t delay);
+
+/**
+ * Invert convolutional_interleave with the same branches and delay.
+ * 
+ * @throws std::invalid_argument if branches == 0, delay == 0 or bits is shorter than the flush length
+ */
+std::vector<uint8_t> convolutional_deinterleave(util::ConstBitSpan bits, size_t branches, size_t delay);
+
+/**
+ * Interleave according to a Spec.
+ * 
+ * @throws std::invalid_argument if the spec dimensions are invalid
+ */
+std::vector<uint8_t> interleave(util::ConstBitSpan bits, const Spec& spec);
+
+/**
+ * Deinterleave according to a Spec.
+ * 
+ * @throws std::invalid_argument if the spec dimensions are invalid
+ */
+std::vector<uint8_t> deinterleave(util::ConstBitSpan bits, const Spec& spec);
+
+/**
+ * Deinterleave per-bit values, such as channel LLRs, according to a Spec.
+ * Values move exactly as the bits at the same positions would.
+ * 
+ * @throws std::invalid_argument if the spec dimensions are invalid
+ */
+std::vector<float> deinterleave(util::ConstSpan<float> values, const Spec& spec);
+
+} // namespace bitshield::interleaver
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <bitshield/io_backend.hpp>
+#include <memory>
 #include <vector>
 #include <cstdint>
+#include <cstddef>
 #include <string>
 #include <utility>
 
@@ -38,8 +41,10 @@ std::vector<uint8_t> read_text_format(const std::string& path);
 
 /**
  * Write bits in legacy format (space-separated 0/1 values).
+ * Groups of eight bits are expanded through a table of precomputed strings
+ * and written in 64 KiB chunks with write(2), bypassing iostreams.
  * 
- * @param path File path
+ * @param path File path, or "-" for standard output
  * @param bits Bit vector to write
  * @throws std::runtime_error if file cannot be written
  */
@@ -48,11 +53,282 @@ void write_bit_format(const std::string& path, const std::vector<uint8_t>& bits)
 /**
  * Write bits as text (decoded from bits).
  * 
- * @param path File path
+ * @param path File path, or "-" for standard output
  * @param bits Bit vector to write
  * @throws std::runtime_error if file cannot be written
  */
 void write_text_format(const std::string& path, const std::vector<uint8_t>& bits);
 
+/**
+ * Read a binary file as fixed-size symbols.
+ * The last symbol is padded with zeros to symbol_size bytes.
+ * 
+ * @param path File path
+ * @param symbol_size Symbol size in bytes (must be > 0)
+ * @return Pair of (file size in bytes, symbols)
+ * @throws std::invalid_argument if symbol_size == 0
+ * @throws std::runtime_error if file cannot be read
+ */
+std::pair<size_t, std::vector<std::vector<uint8_t>>> read_symbols(const std::string& path, size_t symbol_size);
+
+/**
+ * Write symbols back to a binary file, truncated to size bytes.
+ * 
+ * @param path File path
+ * @param symbols Symbols to write
+ * @param size Number of bytes to write (drops symbol padding)
+ * @throws std::runtime_error if file cannot be written
+ */
+void write_symbols(const std::string& path, const std::vector<std::vector<uint8_t>>& symbols, size_t size);
+
+/**
+ * Output file written with unbuffered write(2) calls (stdio elsewhere).
+ * Callers batch their data into large chunks. The path "-" selects
+ * standard output, which is left open on destruction. Regular files use
+ * the asynchronous backend selected by set_io_options, if any.
+ */
+class OutputFile {
+public:
+    /**
+     * Create or truncate a file for writing.
+     * 
+     * @param path File path, or "-" for standard output
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    explicit OutputFile(const std::string& path);
+    ~OutputFile();
+    
+    OutputFile(const OutputFile&) = delete;
+    OutputFile& operator=(const OutputFile&) = delete;
+    
+    /**
+     * Write a whole buffer, retrying short writes.
+     * 
+     * @param data Bytes to write
+     * @param size Number of bytes
+     * @throws std::runtime_error if the write fails
+     */
+    void write(const uint8_t* data, size_t size);
+    
+    /**
+     * Buffer space for the caller to fill in place and pass to commit. On
+     * the asynchronous backends this is the block queued for writing, so
+     * data produced there is never copied in user space.
+     * 
+     * @param size Bytes wanted; lowered to the space available (at least 1 if size > 0)
+     * @return Start of the space, valid until the next call on the file
+     * @throws std::runtime_error if an earlier write failed
+     */
+    uint8_t* reserve(size_t& size);
+    
+    /**
+     * Write the first size bytes of the space returned by reserve.
+     * 
+     * @param size Number of bytes
+     * @throws std::runtime_error if the write fails
+     */
+    void commit(size_t size);
+    
+    /**
+     * Wait for queued writes to reach the file (see IoOptions). The
+     * destructor flushes too but cannot report errors.
+     * 
+     * @throws std::runtime_error if a write failed
+     */
+    void flush();
+    
+private:
+    std::string path_;
+    int fd_ = -1;            // POSIX descriptor
+    void* file_ = nullptr;   // std::FILE* without POSIX
+    std::unique_ptr<AsyncWriter> async_;
+    std::vector<uint8_t> staging_;  // reserve() space for blocking writes
+};
+
+/**
+ * Input file read with read(2) calls (stdio elsewhere), for streams that
+ * cannot or should not be mapped. The path "-" selects standard input.
+ * Regular files read ahead with the asynchronous backend selected by
+ * set_io_options, if any.
+ */
+class InputFile {
+public:
+    /**
+     * Open a file for reading.
+     * 
+     * @param path File path, or "-" for standard input
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    explicit InputFile(const std::string& path);
+    ~InputFile();
+    
+    InputFile(const InputFile&) = delete;
+    InputFile& operator=(const InputFile&) = delete;
+    
+    /**
+     * Read up to size bytes; fewer only at the end of the file.
+     * 
+     * @param data Destination buffer
+     * @param size Number of bytes
+     * @return Number of bytes read (0 at the end of the file)
+     * @throws std::runtime_error if the read fails
+     */
+    size_t read(uint8_t* data, size_t size);
+    
+    /**
+     * Look at the next bytes without consuming them (e.g. to sniff a format on stdin).
+     * 
+     * @param data Destination buffer
+     * @param size Number of bytes
+     * @return Number of bytes available (less than size only at the end of the file)
+     * @throws std::runtime_error if the read fails
+     */
+    size_t peek(uint8_t* data, size_t size);
+    
+private:
+    size_t read_some(uint8_t* data, size_t size);
+    
+    std::string path_;
+    int fd_ = -1;            // POSIX descriptor
+    void* file_ = nullptr;   // std::FILE* without POSIX
+    std::vector<uint8_t> lookahead_;
+    std::unique_ptr<AsyncReader> async_;
+};
+
+/**
+ * Streaming reader for the bit format (and the legacy format with its
+ * leading N), decoding one buffer of input per call with the same scanner
+ * and error messages as read_bit_format.
+ */
+class BitFormatReader {
+public:
+    /**
+     * @param file Input file (must outlive the reader)
+     * @param leading_count true for the legacy format, whose first token is N
+     */
+    BitFormatReader(InputFile& file, bool leading_count = false);
+    
+    /**
+     * Read the next bits of the stream.
+     * 
+     * @param bits Receives the bits of the next input buffer (may be empty)
+     * @return false once the input is exhausted
+     * @throws std::runtime_error on invalid tokens, with their byte offset
+     */
+    bool next(std::vector<uint8_t>& bits);
+    
+    int count() const { return count_; }  // N of the legacy format, once read
+    
+private:
+    InputFile& file_;
+    bool leading_count_;
+    std::vector<uint8_t> buffer_;
+    uint64_t offset_ = 0;
+    bool prev_digit_ = false;
+    int count_ = 0;
+};
+
+/**
+ * Streaming writer for the bit format; write_bit_format in pieces.
+ */
+class BitFormatWriter {
+public:
+    /**
+     * @param path File path, or "-" for standard output
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    explicit BitFormatWriter(const std::string& path);
+    ~BitFormatWriter();
+    
+    /**
+     * Append bits to the stream.
+     * 
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void write(const std::vector<uint8_t>& bits);
+    
+    /**
+     * Write buffered output. Called by the destructor, which cannot report errors.
+     * 
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void finish();
+    
+private:
+    OutputFile file_;
+    std::vector<uint8_t> buffer_;
+    size_t used_ = 0;
+};
+
+/**
+ * Streaming writer for the text format; write_text_format in pieces.
+ * Bits are packed straight into the space from OutputFile::reserve.
+ */
+class TextWriter {
+public:
+    /**
+     * @param path File path, or "-" for standard output
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    explicit TextWriter(const std::string& path);
+    ~TextWriter();
+    
+    /**
+     * Append bits to the stream.
+     * 
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void write(const std::vector<uint8_t>& bits);
+    
+    /**
+     * Flush the output; a trailing partial byte is dropped as by bits_to_text.
+     * Called by the destructor, which cannot report errors.
+     * 
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void finish();
+    
+private:
+    OutputFile file_;
+    unsigned partial_ = 0;          // Bits of the incomplete byte, right-aligned
+    size_t partial_bits_ = 0;
+};
+
+/**
+ * Read-only view of a whole file.
+ * On POSIX systems the file is memory-mapped, so multi-gigabyte inputs are
+ * paged in on demand and never copied; elsewhere the contents are read into
+ * an owned buffer. The view is immutable, so one instance can be shared by
+ * concurrent readers.
+ */
+class MappedFile {
+public:
+    /**
+     * Map a file.
+     * 
+     * @param path File path
+     * @throws std::runtime_error if the file cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+    
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool is_mapped() const { return mapped_; }  // false when the fallback buffer is used
+    
+private:
+    void release();
+    
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    std::vector<uint8_t> buffer_;
+};
+
 } // namespace bitshield::io
 
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace bitshield::io {
+
+/**
+ * How InputFile and OutputFile move bytes to and from regular files.
+ * Pipes and terminals always use blocking calls.
+ */
+enum class IoBackend {
+    blocking,   // One read(2)/write(2) at a time
+    uring,      // Linux io_uring with registered buffers (falls back to threads)
+    threads     // pread/pwrite on a small thread pool
+};
+
+/**
+ * Backend selection and queue geometry.
+ */
+struct IoOptions {
+    IoBackend backend = IoBackend::blocking;
+    size_t block_bytes = size_t{1} << 20;   // Bytes per request
+    size_t depth = 4;                       // Requests in flight per file
+};
+
+/**
+ * Set the options used by files opened from now on.
+ * 
+ * @param options Backend, block size and depth
+ * @throws std::invalid_argument if block_bytes or depth is 0
+ */
+void set_io_options(const IoOptions& options);
+
+/**
+ * Options used by newly opened files (blocking by default).
+ * 
+ * @return Current options
+ */
+IoOptions io_options();
+
+/**
+ * Check whether a backend can run here (io_uring may be missing from the
+ * kernel or blocked by a seccomp filter).
+ * 
+ * @param backend Backend
+ * @return true if files can use it
+ */
+bool is_available(IoBackend backend);
+
+/**
+ * Backend name as accepted by parse_backend.
+ * 
+ * @param backend Backend
+ * @return "blocking", "uring" or "threads"
+ */
+const char* backend_name(IoBackend backend);
+
+/**
+ * Parse a backend name.
+ * 
+ * @param name "blocking", "uring" or "threads"
+ * @return Backend
+ * @throws std::invalid_argument for unknown names
+ */
+IoBackend parse_backend(const std::string& name);
+
+/**
+ * Ways the io classes move payload bytes, for counting copies.
+ */
+enum class ByteMove {
+    copied_in,      // Kernel to user space: read(2), pread, io_uring reads
+    copied_out,     // User to kernel space: write(2), pwrite, io_uring writes
+    staged,         // User-space copy inside the io classes (queue slots, peek lookahead)
+    mapped_in       // Used in place from mapped pages, no copy
+};
+
+/**
+ * Bytes moved by the io classes since the last reset_copy_stats, summed
+ * over all threads.
+ */
+struct CopyStats {
+    uint64_t copied_in = 0;
+    uint64_t copied_out = 0;
+    uint64_t staged = 0;
+    uint64_t mapped_in = 0;
+    
+    /**
+     * Copies made per byte of payload.
+     * 
+     * @param payload_bytes Bytes of data the copies served (e.g. decoded output)
+     * @return (copied_in + copied_out + staged) / payload_bytes, or 0 without payload
+     */
+    double copies_per_byte(uint64_t payload_bytes) const {
+        return payload_bytes > 0
+            ? static_cast<double>(copied_in + copied_out + staged) / static_cast<double>(payload_bytes)
+            : 0.0;
+    }
+};
+
+/**
+ * Record bytes moved (called by the io classes; counters are relaxed atomics).
+ * 
+ * @param kind How the bytes were moved
+ * @param bytes Number of bytes
+ */
+void count_bytes(ByteMove kind, uint64_t bytes);
+
+/**
+ * Bytes moved since the last reset.
+ * 
+ * @return Counters
+ */
+CopyStats copy_stats();
+
+/**
+ * Zero the counters returned by copy_stats.
+ */
+void reset_copy_stats();
+
+class IoQueue;
+
+/**
+ * Sequential reader over a regular file that keeps depth block reads in
+ * flight ahead of the consumer.
+ */
+class AsyncReader {
+public:
+    /**
+     * @param fd Open descriptor of a regular file (not owned), read from offset 0
+     * @param options Backend and queue geometry (backend must not be blocking)
+     * @throws std::runtime_error if the backend cannot be set up
+     */
+    AsyncReader(int fd, const IoOptions& options);
+    ~AsyncReader();
+    
+    AsyncReader(const AsyncReader&) = delete;
+    AsyncReader& operator=(const AsyncReader&) = delete;
+    
+    /**
+     * Read up to size bytes; fewer only at the end of the file.
+     * 
+     * @return Number of bytes read (0 at the end of the file)
+     * @throws std::runtime_error if a read fails
+     */
+    size_t read(uint8_t* data, size_t size);
+    
+    IoBackend backend() const;  // Backend in use after any fallback
+    
+private:
+    void submit(size_t slot);
+    void wait_slot(size_t slot);
+    
+    std::unique_ptr<IoQueue> queue_;
+    int fd_;
+    uint64_t next_offset_ = 0;      // File offset of the next read to submit
+    size_t current_ = 0;            // Slot being consumed
+    size_t consumed_ = 0;           // Bytes of the current slot already returned
+    bool eof_submitted_ = false;    // A short read was seen; submit no more
+};
+
+/**
+ * Sequential writer to a regular file that keeps depth block writes in
+ * flight behind the producer.
+ */
+class AsyncWriter {
+public:
+    /**
+     * @param fd Open descriptor of an empty regular file (not owned), written from offset 0
+     * @param options Backend and queue geometry (backend must not be blocking)
+     * @throws std::runtime_error if the backend cannot be set up
+     */
+    AsyncWriter(int fd, const IoOptions& options);
+    ~AsyncWriter();
+    
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+    
+    /**
+     * Queue bytes for writing.
+     * 
+     * @throws std::runtime_error if an earlier write failed
+     */
+    void write(const uint8_t* data, size_t size);
+    
+    /**
+     * Space in the current block for the caller to fill in place and pass
+     * to commit, which saves the copy made by write().
+     * 
+     * @param size Bytes wanted; lowered to the space left in the block
+     * @return Start of the space, valid until the next call on the writer
+     * @throws std::runtime_error if an earlier write failed
+     */
+    uint8_t* reserve(size_t& size);
+    
+    /**
+     * Queue the first size bytes of the space returned by reserve.
+     */
+    void commit(size_t size);
+    
+    /**
+     * Submit the partial block and wait for every write to complete.
+     * 
+     * @throws std::runtime_error if a write failed
+     */
+    void flush();
+    
+    IoBackend backend() const;  // Backend in use after any fallback
+    
+private:
+    void submit_current();
+    void finish_slot(size_t slot);
+    
+    std::unique_ptr<IoQueue> queue_;
+    int fd_;
+    uint64_t next_offset_ = 0;      // File offset of the current slot
+    size_t current_ = 0;            // Slot being filled
+    size_t filled_ = 0;             // Bytes in the current slot
+};
+
+} // namespace bitshield::io
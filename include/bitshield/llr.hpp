@@ -0,0 +1,73 @@
+#pragma once
+
+#include <bitshield/bitspan.hpp>
+#include <vector>
+#include <cstdint>
+
+namespace bitshield::llr {
+
+/**
+ * Log-likelihood ratios, one per code bit: L = ln(P(bit = 0) / P(bit = 1)).
+ * Positive values favour 0, negative values favour 1 and the magnitude is
+ * the reliability. Buffers are flat arrays in bit order so soft decoders can
+ * stream through them exactly like the hard-decision bit vectors.
+ * 
+ * int8 LLRs are the same quantity scaled and saturated to [-127, 127].
+ */
+
+/**
+ * Hard decision on float LLRs.
+ * 
+ * @param llrs LLRs
+ * @return Bit vector (1 where LLR < 0)
+ */
+std::vector<uint8_t> hard_decision(util::ConstSpan<float> llrs);
+
+/**
+ * Hard decision on int8 LLRs.
+ * 
+ * @param llrs Quantised LLRs
+ * @return Bit vector (1 where LLR < 0)
+ */
+std::vector<uint8_t> hard_decision(util::ConstSpan<int8_t> llrs);
+
+/**
+ * Hard decision on float LLRs into caller storage, e.g. arena memory.
+ * 
+ * @param llrs LLRs
+ * @param bits Destination holding at least llrs.size() bits
+ * @throws std::invalid_argument if bits is too small
+ */
+void hard_decision(util::ConstSpan<float> llrs, util::BitSpan bits);
+
+/**
+ * Hard decision on int8 LLRs into caller storage.
+ * 
+ * @param llrs Quantised LLRs
+ * @param bits Destination holding at least llrs.size() bits
+ * @throws std::invalid_argument if bits is too small
+ */
+void hard_decision(util::ConstSpan<int8_t> llrs, util::BitSpan bits);
+
+/**
+ * Quantise float LLRs to int8: round(llr * scale), saturated to [-127, 127].
+ * NaN carries no information and becomes 0, an erasure.
+ * 
+ * @param llrs LLRs
+ * @param scale Quantisation scale (must be > 0)
+ * @return Quantised LLR vector
+ * @throws std::invalid_argument if scale <= 0
+ */
+std::vector<int8_t> quantize(util::ConstSpan<float> llrs, float scale);
+
+/**
+ * Convert hard bits to saturated LLRs of the given magnitude.
+ * Useful to drive soft decoders from a hard-decision channel.
+ * 
+ * @param bits Bit vector
+ * @param magnitude LLR magnitude assigned to every bit
+ * @return LLR vector (+magnitude for 0, -magnitude for 1)
+ */
+std::vector<float> from_bits(util::ConstBitSpan bits, float magnitude = 1.0f);
+
+} // namespace bitshield::llr
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <bitshield/bitspan.hpp>
 #include <vector>
 #include <cstdint>
+#include <cstddef>
 #include <chrono>
 
 namespace bitshield::metrics {
@@ -14,7 +16,7 @@ namespace bitshield::metrics {
  * @return BER (errors / total_bits)
  * @throws std::invalid_argument if vectors have different sizes
  */
-double calculate_ber(const std::vector<uint8_t>& original, const std::vector<uint8_t>& received);
+double calculate_ber(util::ConstBitSpan original, util::ConstBitSpan received);
 
 /**
  * Calculate message success rate.
@@ -25,7 +27,53 @@ double calculate_ber(const std::vector<uint8_t>& original, const std::vector<uin
  * @return Success rate (successful_messages / total_messages)
  * @throws std::invalid_argument if vectors have different sizes
  */
-double calculate_success_rate(const std::vector<uint8_t>& original, const std::vector<uint8_t>& received);
+double calculate_success_rate(util::ConstBitSpan original, util::ConstBitSpan received);
+
+/**
+ * What the channel did to one transmission: bits flipped and bits erased
+ * are reported separately.
+ */
+struct ChannelStats {
+    size_t bits = 0;
+    size_t errors = 0;      // Non-erased bits received with the wrong value
+    size_t erasures = 0;    // Bits the receiver knows were lost
+    
+    double error_rate() const;
+    double erasure_rate() const;
+};
+
+/**
+ * Compare transmitted and received bits, counting erasures and errors.
+ * Erased positions never count as errors.
+ * 
+ * @param sent Transmitted bit vector
+ * @param received Received bit vector
+ * @param erasures Erasure mask, 1 = erased (empty if the channel has no erasures)
+ * @return Channel statistics
+ * @throws std::invalid_argument if the vectors have different sizes or a non-empty mask is too short
+ */
+ChannelStats channel_stats(
+    util::ConstBitSpan sent,
+    util::ConstBitSpan received,
+    util::PackedBitSpan erasures = {}
+);
+
+/**
+ * Peak resident set size of this process (VmHWM on Linux, else the
+ * getrusage maximum).
+ * 
+ * @return Bytes, or 0 where the platform does not report it
+ */
+size_t peak_rss_bytes();
+
+/**
+ * Reset the peak resident set size to the current size, so the next
+ * peak_rss_bytes() reports the peak of the following work only. Linux
+ * only (writes 5 to /proc/self/clear_refs).
+ * 
+ * @return true if the peak was reset
+ */
+bool reset_peak_rss();
 
 /**
  * Simple timer for benchmarking.
@@ -36,7 +84,7 @@ public:
     void stop();
     double elapsed_seconds() const;
     double elapsed_milliseconds() const;
-
+    
 private:
     std::chrono::high_resolution_clock::time_point start_time_;
     std::chrono::high_resolution_clock::time_point end_time_;
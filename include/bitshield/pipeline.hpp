@@ -0,0 +1,154 @@
+#pragma once
+
+#include <bitshield/codecs/codec.hpp>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace bitshield::pipeline {
+
+/**
+ * Bounded lock-free single-producer single-consumer ring buffer.
+ * One thread may call try_push and one other thread try_pop; head and tail
+ * live on separate cache lines so the two sides do not contend.
+ */
+template <typename T>
+class SpscRing {
+public:
+    /**
+     * @param capacity Number of slots, rounded up to a power of two (at least 2)
+     */
+    explicit SpscRing(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        slots_.resize(size);
+        mask_ = size - 1;
+    }
+    
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+    
+    /**
+     * Append a value (producer side).
+     * 
+     * @return false if the ring is full
+     */
+    bool try_push(T value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == slots_.size()) {
+            return false;
+        }
+        slots_[tail & mask_] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * Remove the oldest value (consumer side).
+     * 
+     * @return false if the ring is empty
+     */
+    bool try_pop(T& value) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = std::move(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    
+    size_t capacity() const { return slots_.size(); }
+    
+private:
+    std::vector<T> slots_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+};
+
+/**
+ * Pull-based bit source: fills bits with the next input and returns false
+ * once the input is exhausted.
+ */
+using Source = std::function<bool(std::vector<uint8_t>&)>;
+
+/**
+ * Push-based bit consumer, called with output bits in stream order.
+ */
+using Sink = std::function<void(const std::vector<uint8_t>&)>;
+
+/**
+ * Pipeline configuration.
+ */
+struct Options {
+    size_t workers = 1;                                             // Threads running the codec
+    size_t chunk_bits = codec::ChunkedCoder::kDefaultChunkBits;     // Input bits per chunk
+    size_t depth = 4;                                               // Chunks in flight per worker
+};
+
+/**
+ * Time a stage spent working and waiting on its neighbours.
+ */
+struct StageStats {
+    std::string name;
+    size_t threads = 1;
+    double busy_seconds = 0.0;      // Summed over the stage's threads
+    double wait_seconds = 0.0;      // Blocked on a full or empty ring
+    
+    /**
+     * Fraction of the run the stage's threads were busy.
+     * 
+     * @param wall_seconds Duration of the run
+     * @return Busy time per thread over the wall time (0 to 1)
+     */
+    double utilisation(double wall_seconds) const {
+        return wall_seconds > 0.0 ? busy_seconds / (static_cast<double>(threads) * wall_seconds) : 0.0;
+    }
+};
+
+/**
+ * Outcome of a pipeline run.
+ */
+struct Stats {
+    double wall_seconds = 0.0;
+    uint64_t chunks = 0;
+    uint64_t input_bits = 0;
+    uint64_t output_bits = 0;
+    std::vector<StageStats> stages;     // read, code, write
+};
+
+/**
+ * Encode or decode a stream on three overlapping stages: a reader thread
+ * cuts the source into chunks of whole coding units, worker threads code
+ * independent chunks, and the calling thread writes the results to the
+ * sink in stream order. Stages exchange pooled chunk buffers through SPSC
+ * rings: chunk k goes to worker k mod workers, and the writer collects the
+ * workers round-robin, which restores the stream order. The output is
+ * identical to coding the whole stream at once (see codec::ChunkedCoder);
+ * codecs with stream_blocks == 0 are coded as one chunk. At most
+ * workers * depth chunks are in flight.
+ * 
+ * @param codec Codec
+ * @param mode Encode or decode
+ * @param source Input bits (called on the reader thread)
+ * @param sink Output bits (called on the calling thread)
+ * @param options Worker count, chunk size and queue depth
+ * @return Per-stage timing
+ * @throws std::invalid_argument if workers or depth is 0
+ * @throws Any exception raised by a stage, after all threads have stopped
+ */
+Stats run(
+    const codec::Codec& codec,
+    codec::ChunkedCoder::Mode mode,
+    const Source& source,
+    const Sink& sink,
+    const Options& options = Options{}
+);
+
+} // namespace bitshield::pipeline
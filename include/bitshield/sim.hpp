@@ -0,0 +1,421 @@
+#pragma once
+
+#include <bitshield/arena.hpp>
+#include <bitshield/metrics.hpp>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace bitshield::sim {
+
+/**
+ * CPUs this process may run on, grouped by NUMA node.
+ */
+struct Topology {
+    struct Node {
+        int id = 0;             // Kernel node number
+        std::vector<int> cpus;  // Ascending
+    };
+    
+    std::vector<Node> nodes;    // Ascending id; nodes without usable CPUs are left out
+    
+    size_t cpu_count() const;
+};
+
+/**
+ * Read the NUMA layout from /sys/devices/system/node, keeping only the CPUs
+ * in the process affinity mask. Machines without that information (or
+ * other platforms) are reported as a single node.
+ */
+Topology detect_topology();
+
+/**
+ * Parse a kernel CPU list such as "0-3,8,10-11".
+ * 
+ * @param list CPU list
+ * @return CPU ids in list order
+ * @throws std::invalid_argument if the list is malformed
+ */
+std::vector<int> parse_cpu_list(const std::string& list);
+
+/**
+ * How workers are placed on the machine.
+ */
+enum class Placement {
+    none,   // Let the scheduler move workers freely
+    pin,    // Pin each worker to its own CPU, filling one node before the next
+    numa    // Pin workers round-robin across nodes and give each node its own copy of the reference
+};
+
+/**
+ * CPU and node assigned to one worker.
+ */
+struct WorkerSlot {
+    int node = -1;  // Index into Topology::nodes, -1 when unpinned
+    int cpu = -1;   // -1 when unpinned
+};
+
+/**
+ * Assign workers to CPUs. Workers wrap around when there are more workers
+ * than CPUs, sharing CPUs in the same order.
+ * 
+ * @param topology CPUs available
+ * @param workers Number of workers
+ * @param placement Placement policy
+ * @return One slot per worker
+ */
+std::vector<WorkerSlot> place_workers(const Topology& topology, size_t workers, Placement placement);
+
+/**
+ * Restrict the calling thread to one CPU.
+ * 
+ * @return False if pinning is unsupported or the CPU is not available
+ */
+bool pin_current_thread(int cpu);
+
+/**
+ * Read-only data shared by all trials: the message and its encoding.
+ */
+struct Reference {
+    std::vector<uint8_t> message;
+    std::vector<uint8_t> encoded;
+};
+
+/**
+ * Counters accumulated by trials. Each worker keeps its own tally and the
+ * tallies are summed when the run ends, so the totals do not depend on the
+ * number of workers or on which worker ran which trial.
+ */
+struct Tally {
+    static constexpr size_t kHistogramBins = 256;
+    
+    uint64_t trials = 0;
+    uint64_t bit_errors = 0;            // Message bits decoded wrongly
+    uint64_t failed_messages = 0;       // Trials with at least one bit error
+    metrics::ChannelStats channel;
+    
+    // Trials by error count: bin k counts trials with k errors, and the last
+    // bin every trial with kHistogramBins - 1 or more. Grown on demand.
+    std::vector<uint64_t> error_histogram;      // Message bits decoded wrongly
+    std::vector<uint64_t> channel_histogram;    // Bits the channel flipped
+    
+    /**
+     * Record one trial's outcome (the trial itself is counted by run()).
+     * 
+     * @param message_errors Message bits decoded wrongly
+     * @param channel Channel statistics of the trial's transmission
+     */
+    void record(uint64_t message_errors, const metrics::ChannelStats& channel);
+    
+    void merge(const Tally& other);
+};
+
+/**
+ * Seed of one trial of a seeded run: a counter hash of the run's seed and the
+ * 64-bit trial index. Every (seed, trial) pair gives its own stream, any seed
+ * (0 included) is valid, and trials do not repeat after 2^32.
+ */
+uint32_t trial_seed(uint32_t seed, uint64_t trial);
+
+/**
+ * One trial: transmit reference.encoded, decode and record the errors in
+ * tally (run() counts the trials themselves). The trial index selects the
+ * trial's randomness, so a trial gives the same result on any worker.
+ * Scratch memory may come from arena, which is reset at the start of each
+ * batch. Called concurrently from several workers; must not modify shared
+ * state.
+ */
+using Trial = std::function<void(const Reference& reference, uint64_t trial, util::BitArena& arena, Tally& tally)>;
+
+/**
+ * Bounded lock-free work-stealing deque (Chase-Lev, with the memory orders
+ * of Le et al., "Correct and Efficient Work-Stealing for Weak Memory
+ * Models"). The owning thread pushes and pops at the bottom; any other
+ * thread may steal from the top. T must be trivially copyable.
+ */
+template <typename T>
+class WorkDeque {
+public:
+    /**
+     * @param capacity Number of slots, rounded up to a power of two (at least 2)
+     */
+    explicit WorkDeque(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        slots_ = std::vector<std::atomic<T>>(size);
+        mask_ = size - 1;
+    }
+    
+    WorkDeque(const WorkDeque&) = delete;
+    WorkDeque& operator=(const WorkDeque&) = delete;
+    
+    /**
+     * Add a value at the bottom (owner only).
+     * 
+     * @return false if the deque is full
+     */
+    bool push(T value) {
+        int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        int64_t top = top_.load(std::memory_order_acquire);
+        if (bottom - top >= static_cast<int64_t>(slots_.size())) {
+            return false;
+        }
+        slots_[bottom & mask_].store(value, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return true;
+    }
+    
+    /**
+     * Remove the newest value (owner only).
+     * 
+     * @return false if the deque is empty or a thief took the last value
+     */
+    bool pop(T& value) {
+        int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_relaxed);
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+        value = slots_[bottom & mask_].load(std::memory_order_relaxed);
+        if (top < bottom) {
+            return true;
+        }
+        // Last value: race the thieves for it
+        bool won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return won;
+    }
+    
+    /**
+     * Remove the oldest value (any thread).
+     * 
+     * @return false if the deque is empty or another thread got the value first
+     */
+    bool steal(T& value) {
+        int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = bottom_.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return false;
+        }
+        T stolen = slots_[top & mask_].load(std::memory_order_relaxed);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return false;
+        }
+        value = stolen;
+        return true;
+    }
+    
+    bool empty() const {
+        return top_.load(std::memory_order_acquire) >= bottom_.load(std::memory_order_acquire);
+    }
+    
+    size_t capacity() const { return slots_.size(); }
+    
+private:
+    std::vector<std::atomic<T>> slots_;
+    int64_t mask_ = 0;
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+};
+
+/**
+ * One point of a sweep, e.g. a codec at one error probability.
+ */
+struct Job {
+    Reference reference;
+    uint64_t trials = 0;
+    Trial trial;
+    uint64_t first = 0;     // Index of the first trial, e.g. the start of a shard
+};
+
+/**
+ * Progress of a run: which tasks have completed and the tallies they
+ * produced. Tasks are numbered job by job, each job's trials cut into
+ * batches of batch trials from its first trial. Since a trial's randomness comes from its index,
+ * the completed tasks and their tallies are all the state a resumed run
+ * needs to reach the same totals as an uninterrupted one.
+ */
+struct Checkpoint {
+    uint64_t fingerprint = 0;       // Caller's identifier of the configuration
+    uint64_t batch = 0;
+    std::vector<uint64_t> trials;   // Trials of each job
+    std::vector<Tally> jobs;        // Tallies of the completed tasks, per job
+    std::vector<uint8_t> done;      // One 0/1 flag per task
+    
+    uint64_t completed_trials() const;
+};
+
+/**
+ * Write a checkpoint to a temporary file next to path and rename it over
+ * path, so a crash while saving leaves the previous checkpoint intact.
+ * 
+ * @throws std::runtime_error on I/O failure
+ */
+void save_checkpoint(const Checkpoint& checkpoint, const std::string& path);
+
+/**
+ * Read a checkpoint written by save_checkpoint.
+ * 
+ * @throws std::runtime_error if the file cannot be read, is not a
+ *         checkpoint or fails its CRC check
+ */
+Checkpoint load_checkpoint(const std::string& path);
+
+/**
+ * Simulation configuration.
+ */
+struct Options {
+    size_t workers = 1;
+    Placement placement = Placement::none;
+    uint64_t batch = 64;    // Trials per task
+    bool steal = true;      // false: each worker runs only the tasks it was dealt
+    
+    std::string checkpoint;                     // File progress is saved to ("" = none)
+    double checkpoint_seconds = 60.0;           // Interval between saves
+    uint64_t fingerprint = 0;                   // Stored in checkpoints; a resumed run must match
+    const Checkpoint* resume = nullptr;         // Progress of an earlier run to continue from
+    const std::atomic<bool>* stop = nullptr;    // Once set, workers stop after their running task
+};
+
+/**
+ * Work done by the workers of one node.
+ */
+struct NodeStats {
+    int node = -1;          // Kernel node number, -1 for unpinned workers
+    size_t workers = 0;
+    uint64_t trials = 0;
+    double busy_seconds = 0.0;  // Summed over the node's workers
+    
+    /**
+     * @param wall_seconds Duration of the run
+     * @return Trials completed per second on this node
+     */
+    double throughput(double wall_seconds) const {
+        return wall_seconds > 0.0 ? static_cast<double>(trials) / wall_seconds : 0.0;
+    }
+};
+
+/**
+ * Outcome of a simulation run.
+ */
+struct Result {
+    Tally tally;                    // Summed over all jobs
+    std::vector<Tally> jobs;        // One per job, in job order
+    double wall_seconds = 0.0;
+    double tail_seconds = 0.0;      // From the first worker running out of tasks to the end of the run
+    size_t pinned_workers = 0;      // Workers whose pinning succeeded
+    uint64_t tasks = 0;
+    uint64_t steals = 0;            // Tasks run by a worker they were not dealt to
+    uint64_t resumed_trials = 0;    // Trials taken from options.resume rather than run
+    bool complete = true;           // false if options.stop ended the run early
+    std::vector<NodeStats> nodes;   // Ascending node id
+};
+
+/**
+ * Run a set of jobs on a pool of work-stealing workers. Each job's trials
+ * are cut into tasks of options.batch consecutive trials, and the tasks are
+ * dealt in contiguous runs to per-worker WorkDeques. A worker runs its own
+ * tasks newest first; once its deque is empty it steals the oldest task of
+ * a randomly chosen other worker, so cheap and expensive jobs even out
+ * instead of leaving workers idle at the end. Trials draw their randomness
+ * from their job and index only, so the tallies do not depend on which
+ * worker ran a task.
+ * 
+ * With Placement::pin or numa each worker pins itself before touching any
+ * memory, so its tallies, arena and stack are first touched (and placed) on
+ * its own node; with numa the first worker of each node to run a job
+ * copies that job's reference, and the node's workers read the copy
+ * instead of the caller's buffers.
+ * 
+ * With options.checkpoint set, the calling thread saves the completed tasks
+ * and their tallies every options.checkpoint_seconds, and once more when
+ * the run ends, stops or fails. A run given options.resume skips the tasks
+ * the checkpoint marks done and starts from its tallies.
+ * 
+ * @param jobs Jobs to run
+ * @param options Worker count, placement, batch size, stealing and checkpointing
+ * @return Tallies per job and in total, and per-node work
+ * @throws std::invalid_argument if workers or batch is 0, or if options.resume
+ *         was saved for different jobs, batch size or fingerprint
+ * @throws std::runtime_error if a checkpoint cannot be saved
+ * @throws Any exception raised by a trial, after all workers have stopped
+ */
+Result run_jobs(const std::vector<Job>& jobs, const Options& options = Options{});
+
+/**
+ * Run trials [0, trials) of one job on the worker pool (see run_jobs).
+ * 
+ * @param reference Message and encoding shared by all trials
+ * @param trials Number of trials
+ * @param trial Trial body
+ * @param options Worker count, placement and batch size
+ * @return Summed tally and per-node work
+ * @throws std::invalid_argument if workers or batch is 0
+ * @throws Any exception raised by a trial, after all workers have stopped
+ */
+Result run(const Reference& reference, uint64_t trials, const Trial& trial, const Options& options = Options{});
+
+/**
+ * Trials [first, last) that shard index of count runs: contiguous, disjoint
+ * ranges that together cover [0, trials) and differ in size by at most one.
+ * 
+ * @throws std::invalid_argument if count is 0 or index >= count
+ */
+std::pair<uint64_t, uint64_t> shard_range(uint64_t trials, uint32_t index, uint32_t count);
+
+/**
+ * Mergeable outcome of one or more shards of a simulation. Every count is
+ * an integer, so merging the shards of a simulation gives exactly the
+ * totals of running it in one process.
+ */
+struct ShardResult {
+    uint64_t fingerprint = 0;               // Options deciding the results, excluding the shard
+    uint32_t shard_count = 1;
+    std::vector<uint32_t> shards;           // Shards included, ascending
+    double seconds = 0.0;                   // Wall time, summed over the shards
+    std::vector<std::pair<std::string, std::string>> metadata;   // Caller's description of the run
+    std::vector<std::string> labels;        // One per job
+    std::vector<uint64_t> trials;           // Trials of each job over all shards
+    std::vector<Tally> jobs;                // Tallies of the included shards
+    
+    bool complete() const { return shards.size() == shard_count; }
+};
+
+/**
+ * Write a shard result as a line-based text file.
+ * 
+ * @throws std::invalid_argument if labels, trials and jobs differ in length,
+ *         or a label or metadata entry contains a line break
+ * @throws std::runtime_error on I/O failure
+ */
+void save_result(const ShardResult& result, const std::string& path);
+
+/**
+ * Read a shard result written by save_result.
+ * 
+ * @throws std::runtime_error if the file cannot be read or is malformed
+ */
+ShardResult load_result(const std::string& path);
+
+/**
+ * Combine shard results of the same simulation.
+ * 
+ * @param results Results to merge (at least one)
+ * @return Summed tallies and times over the union of their shards
+ * @throws std::invalid_argument if the results come from different
+ *         simulations or share a shard
+ */
+ShardResult merge_results(const std::vector<ShardResult>& results);
+
+} // namespace bitshield::sim
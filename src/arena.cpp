@@ -0,0 +1,77 @@
+#include <bitshield/arena.hpp>
+#include <cstdint>
+#include <cstddef>
+
+namespace bitshield::util {
+
+void CountingResource::reset_counts() {
+    allocations_ = 0;
+    bytes_ = 0;
+    peak_bytes_ = live_bytes_;
+}
+
+void* CountingResource::do_allocate(size_t bytes, size_t alignment) {
+    void* p = upstream_->allocate(bytes, alignment);
+    allocations_++;
+    bytes_ += bytes;
+    live_bytes_ += bytes;
+    if (live_bytes_ > peak_bytes_) {
+        peak_bytes_ = live_bytes_;
+    }
+    return p;
+}
+
+void CountingResource::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    upstream_->deallocate(p, bytes, alignment);
+    live_bytes_ -= bytes;
+}
+
+bool CountingResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+BitArena::BitArena(size_t initial_bytes, std::pmr::memory_resource* upstream)
+    : upstream_(upstream), overflow_(upstream) {
+    allocate_buffer(initial_bytes > 0 ? initial_bytes : kDefaultBytes);
+}
+
+BitArena::~BitArena() {
+    resource_.reset();
+    if (buffer_) {
+        upstream_->deallocate(buffer_, capacity_, alignof(std::max_align_t));
+    }
+}
+
+BitSpan BitArena::bits(size_t count) {
+    return BitSpan(bytes(count), count);
+}
+
+uint8_t* BitArena::bytes(size_t count) {
+    used_ += count;
+    return static_cast<uint8_t*>(resource_->allocate(count > 0 ? count : 1, 1));
+}
+
+void BitArena::reset() {
+    // Overflow blocks mean the buffer is too small for a batch: replace it
+    // with one that holds everything this batch used
+    if (overflow_.allocations() > 0) {
+        size_t grown = capacity_ + overflow_.bytes();
+        resource_.reset();
+        upstream_->deallocate(buffer_, capacity_, alignof(std::max_align_t));
+        buffer_ = nullptr;
+        capacity_ = 0;
+        overflow_.reset_counts();
+        allocate_buffer(grown);
+    } else {
+        resource_->release();
+    }
+    used_ = 0;
+}
+
+void BitArena::allocate_buffer(size_t bytes) {
+    buffer_ = static_cast<uint8_t*>(upstream_->allocate(bytes, alignof(std::max_align_t)));
+    capacity_ = bytes;
+    resource_.emplace(buffer_, capacity_, &overflow_);
+}
+
+} // namespace bitshield::util
@@ -1,66 +1,173 @@
 #include <bitshield/bitstream.hpp>
+#include <bitshield/bitspan.hpp>
+#include <stdexcept>
+#include <cstring>
 #include <cstdint>
 #include <string>
 #include <vector>
 
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define BITSHIELD_BITSTREAM_AVX2 1
+#include <immintrin.h>
+#endif
+
 namespace bitshield::util {
 
-std::vector<uint8_t> text_to_bits(const std::string& text) {
-    std::vector<uint8_t> bits;
-    bits.reserve(text.size() * 8);
+namespace {
+
+// The eight 0/1 values of every byte, most significant bit first
+struct ExpandTable {
+    uint8_t bits[256][8];
     
-    for (char c : text) {
-        uint8_t byte = static_cast<uint8_t>(c);
-        for (int i = 7; i >= 0; --i) {
-            bits.push_back((byte >> i) & 1);
+    constexpr ExpandTable() : bits() {
+        for (int value = 0; value < 256; ++value) {
+            for (int j = 0; j < 8; ++j) {
+                bits[value][j] = static_cast<uint8_t>((value >> (7 - j)) & 1);
+            }
         }
     }
-    
-    return bits;
+};
+
+constexpr ExpandTable kExpand{};
+
+void expand_portable(const uint8_t* bytes, size_t size, uint8_t* bits) {
+    for (size_t i = 0; i < size; ++i) {
+        std::memcpy(bits + 8 * i, kExpand.bits[bytes[i]], 8);
+    }
 }
 
-std::string bits_to_text(const std::vector<uint8_t>& bits) {
-    std::string text;
-    text.reserve(bits.size() / 8);
-    
-    for (size_t i = 0; i + 7 < bits.size(); i += 8) {
-        uint8_t byte = 0;
-        for (int j = 0; j < 8; ++j) {
-            byte |= (bits[i + j] << (7 - j));
+// Gather eight values into one byte, first value in the MSB: the multiply
+// moves the low bit of byte k to bit 63 - k without carries
+inline uint8_t pack8(const uint8_t* bits) {
+    uint64_t v;
+    std::memcpy(&v, bits, sizeof(v));
+    return static_cast<uint8_t>(((v & 0x0101010101010101ULL) * 0x8040201008040201ULL) >> 56);
+}
+
+void pack_portable(const uint8_t* bits, size_t count, uint8_t* bytes) {
+    size_t whole = count / 8;
+    for (size_t b = 0; b < whole; ++b) {
+        bytes[b] = pack8(bits + 8 * b);
+    }
+    if (count % 8 != 0) {
+        unsigned value = 0;
+        for (size_t j = 0; j < count % 8; ++j) {
+            value |= static_cast<unsigned>(bits[8 * whole + j] & 1) << (7 - j);
         }
-        text += static_cast<char>(byte);
+        bytes[whole] = static_cast<uint8_t>(value);
     }
-    
+}
+
+#ifdef BITSHIELD_BITSTREAM_AVX2
+// Broadcast four bytes, give each its own 8 lanes, and test one bit per lane
+__attribute__((target("avx2")))
+void expand_avx2(const uint8_t* bytes, size_t size, uint8_t* bits) {
+    const __m256i spread = _mm256_setr_epi8(
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+        2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3
+    );
+    const __m256i select = _mm256_set1_epi64x(0x0102040810204080LL);  // 0x80 in the first lane
+    const __m256i one = _mm256_set1_epi8(1);
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        int32_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        __m256i v = _mm256_shuffle_epi8(_mm256_set1_epi32(word), spread);
+        v = _mm256_cmpeq_epi8(_mm256_and_si256(v, select), select);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(bits + 8 * i), _mm256_and_si256(v, one));
+    }
+    expand_portable(bytes + i, size - i, bits + 8 * i);
+}
+
+// Reverse each group of eight values, move their low bits to the sign bits
+// and collect 32 of them with one movemask
+__attribute__((target("avx2")))
+void pack_avx2(const uint8_t* bits, size_t count, uint8_t* bytes) {
+    const __m256i reverse = _mm256_setr_epi8(
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8
+    );
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bits + i));
+        v = _mm256_slli_epi16(_mm256_shuffle_epi8(v, reverse), 7);
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(v));
+        std::memcpy(bytes + i / 8, &mask, sizeof(mask));
+    }
+    pack_portable(bits + i, count - i, bytes + i / 8);
+}
+#endif
+
+using ExpandKernel = void (*)(const uint8_t*, size_t, uint8_t*);
+using PackKernel = void (*)(const uint8_t*, size_t, uint8_t*);
+
+ExpandKernel expand_kernel() {
+#ifdef BITSHIELD_BITSTREAM_AVX2
+    static const ExpandKernel kernel = __builtin_cpu_supports("avx2") ? expand_avx2 : expand_portable;
+    return kernel;
+#else
+    return expand_portable;
+#endif
+}
+
+PackKernel pack_kernel() {
+#ifdef BITSHIELD_BITSTREAM_AVX2
+    static const PackKernel kernel = __builtin_cpu_supports("avx2") ? pack_avx2 : pack_portable;
+    return kernel;
+#else
+    return pack_portable;
+#endif
+}
+
+} // anonymous namespace
+
+void bytes_to_bits(const uint8_t* bytes, size_t size, uint8_t* bits) {
+    expand_kernel()(bytes, size, bits);
+}
+
+void bits_to_bytes(const uint8_t* bits, size_t count, uint8_t* bytes) {
+    pack_kernel()(bits, count, bytes);
+}
+
+std::vector<uint8_t> text_to_bits(const std::string& text) {
+    std::vector<uint8_t> bits(text.size() * 8);
+    bytes_to_bits(reinterpret_cast<const uint8_t*>(text.data()), text.size(), bits.data());
+    return bits;
+}
+
+std::string bits_to_text(const std::vector<uint8_t>& bits) {
+    std::string text(bits.size() / 8, '\0');
+    bits_to_bytes(bits.data(), text.size() * 8, reinterpret_cast<uint8_t*>(&text[0]));
     return text;
 }
 
 std::vector<uint8_t> bytes_to_bits(const std::vector<uint8_t>& bytes) {
-    std::vector<uint8_t> bits;
-    bits.reserve(bytes.size() * 8);
-    
-    for (uint8_t byte : bytes) {
-        for (int i = 7; i >= 0; --i) {
-            bits.push_back((byte >> i) & 1);
-        }
-    }
-    
+    std::vector<uint8_t> bits(bytes.size() * 8);
+    bytes_to_bits(bytes.data(), bytes.size(), bits.data());
     return bits;
 }
 
 std::vector<uint8_t> bits_to_bytes(const std::vector<uint8_t>& bits) {
-    std::vector<uint8_t> bytes;
-    bytes.reserve((bits.size() + 7) / 8);
-    
-    for (size_t i = 0; i < bits.size(); i += 8) {
-        uint8_t byte = 0;
-        for (int j = 0; j < 8 && (i + j) < bits.size(); ++j) {
-            byte |= (bits[i + j] << (7 - j));
-        }
-        bytes.push_back(byte);
+    std::vector<uint8_t> bytes((bits.size() + 7) / 8);
+    bits_to_bytes(bits.data(), bits.size(), bytes.data());
+    return bytes;
+}
+
+void PackedBitSpan::unpack(BitSpan out) const {
+    if (out.size() < size_) {
+        throw std::invalid_argument("Bit span is too small to unpack into");
     }
     
-    return bytes;
+    // Bits up to the first byte boundary, whole bytes, then the tail
+    size_t i = 0;
+    for (; i < size_ && (offset_ + i) % 8 != 0; ++i) {
+        out[i] = (*this)[i];
+    }
+    size_t whole = (size_ - i) / 8;
+    bytes_to_bits(bytes_ + (offset_ + i) / 8, whole, out.data() + i);
+    for (i += whole * 8; i < size_; ++i) {
+        out[i] = (*this)[i];
+    }
 }
 
 } // namespace bitshield::util
-
@@ -1,4 +1,6 @@
 #include <bitshield/channel.hpp>
+#include "packed_bits.hpp"
+#include <algorithm>
 #include <stdexcept>
 #include <random>
 #include <vector>
@@ -7,7 +9,7 @@
 namespace bitshield::channel {
 
 std::vector<uint8_t> apply_noise(
-    const std::vector<uint8_t>& bits,
+    util::ConstBitSpan bits,
     double p,
     std::optional<uint32_t> seed
 ) {
@@ -15,7 +17,7 @@ std::vector<uint8_t> apply_noise(
         throw std::invalid_argument("Noise probability p must be between 0.0 and 1.0");
     }
     
-    std::vector<uint8_t> noisy_bits = bits;
+    std::vector<uint8_t> noisy_bits = bits.to_vector();
     
     // Initialize random number generator
     std::mt19937 rng;
@@ -38,5 +40,66 @@ std::vector<uint8_t> apply_noise(
     return noisy_bits;
 }
 
+std::vector<uint8_t> erasure_pattern(
+    size_t count,
+    double p,
+    std::optional<uint32_t> seed
+) {
+    if (p < 0.0 || p > 1.0) {
+        throw std::invalid_argument("Erasure probability p must be between 0.0 and 1.0");
+    }
+    
+    std::mt19937 rng;
+    if (seed.has_value()) {
+        rng.seed(seed.value());
+    } else {
+        std::random_device rd;
+        rng.seed(rd());
+    }
+    
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    
+    std::vector<uint8_t> erased(count, 0);
+    for (size_t i = 0; i < count; ++i) {
+        if (dist(rng) < p) {
+            erased[i] = 1;
+        }
+    }
+    
+    return erased;
+}
+
+std::vector<uint8_t> apply_mask(util::ConstBitSpan bits, util::PackedBitSpan mask) {
+    if (mask.size() < bits.size()) {
+        throw std::invalid_argument("Error mask is shorter than the bit vector");
+    }
+    
+    std::vector<uint8_t> noisy_bits = bits.to_vector();
+    apply_mask_in_place(noisy_bits, mask);
+    return noisy_bits;
+}
+
+void apply_mask_in_place(util::BitSpan bits, const uint8_t* mask, size_t mask_size) {
+    apply_mask_in_place(bits, util::PackedBitSpan(mask, 0, mask_size * 8));
+}
+
+void apply_mask_in_place(util::BitSpan bits, util::PackedBitSpan mask) {
+    if (mask.size() < bits.size()) {
+        throw std::invalid_argument("Error mask is shorter than the bit vector");
+    }
+    
+    size_t i = 0;
+    for (size_t byte = 0; i < bits.size(); ++byte, i += 8) {
+        uint8_t m = mask.byte(byte);
+        if (m == 0) {
+            continue;  // Error masks are sparse on most channels
+        }
+        size_t end = std::min(i + 8, bits.size());
+        for (size_t j = i; j < end; ++j) {
+            bits[j] ^= packed_bits::test_bit(&m, j - i);
+        }
+    }
+}
+
 } // namespace bitshield::channel
 
@@ -0,0 +1,252 @@
+#include <bitshield/channels/awgn.hpp>
+#include "../rng.hpp"
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <cstdint>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define BITSHIELD_AWGN_AVX2 1
+#endif
+
+namespace bitshield::channel {
+
+namespace {
+
+using rng::StreamKey;
+using rng::make_key;
+
+// Box-Muller pairs produced per block; every step below is a straight-line
+// loop over the pairs of a block, written so compilers emit vector code
+constexpr size_t kPairs = 8;
+constexpr size_t kBlock = 2 * kPairs;
+
+// Samples generated per chunk when producing LLRs
+constexpr size_t kChunk = 4096;
+
+inline float bits_to_float(uint32_t i) {
+    float f;
+    std::memcpy(&f, &i, sizeof(f));
+    return f;
+}
+
+inline uint32_t float_to_bits(float f) {
+    uint32_t i;
+    std::memcpy(&i, &f, sizeof(i));
+    return i;
+}
+
+// Natural log for normal positive floats (Cephes logf polynomial, ~1 ulp)
+inline float log_approx(float x) {
+    uint32_t i = float_to_bits(x);
+    int32_t e = static_cast<int32_t>(i >> 23) - 127;
+    uint32_t mantissa = (i & 0x007FFFFFu) | 0x3F800000u;  // [1, 2)
+    // Halve mantissas above sqrt(2) by decrementing the exponent field; selects
+    // on integers keep the loop free of branches even with trapping FP math
+    uint32_t big = mantissa > 0x3FB504F3u;
+    float m = bits_to_float(mantissa - (big << 23));  // [sqrt(1/2), sqrt(2))
+    float ef = static_cast<float>(e + static_cast<int32_t>(big));
+    
+    float z = m - 1.0f;
+    float z2 = z * z;
+    float p = 7.0376836292e-2f;
+    p = p * z - 1.1514610310e-1f;
+    p = p * z + 1.1676998740e-1f;
+    p = p * z - 1.2420140846e-1f;
+    p = p * z + 1.4249322787e-1f;
+    p = p * z - 1.6668057665e-1f;
+    p = p * z + 2.0000714765e-1f;
+    p = p * z - 2.4999993993e-1f;
+    p = p * z + 3.3333331174e-1f;
+    float y = z * z2 * p;
+    y += -2.12194440e-4f * ef;
+    y += -0.5f * z2;
+    return z + y + 0.693359375f * ef;
+}
+
+// Square root for x >= 0 by Newton iteration on 1/sqrt(x); std::sqrt keeps an
+// errno path that stops compilers from vectorising the loop
+inline float sqrt_approx(float x) {
+    float y = bits_to_float(0x5F375A86u - (float_to_bits(x) >> 1));
+    float h = 0.5f * x;
+    y = y * (1.5f - h * y * y);
+    y = y * (1.5f - h * y * y);
+    y = y * (1.5f - h * y * y);
+    return x * y;
+}
+
+inline float select(uint32_t mask, float a, float b) {
+    return bits_to_float((float_to_bits(a) & mask) | (float_to_bits(b) & ~mask));
+}
+
+// One block of kBlock standard normal samples: cosines first, then sines
+inline void gaussian_block_body(float* out, uint64_t block, const StreamKey& key) {
+    // Counter of the first uniform in this block; bits above 32 perturb the key
+    uint64_t counter = block * kBlock;
+    uint32_t base = static_cast<uint32_t>(counter);
+    uint32_t k1 = key.k1 ^ rng::mix32(static_cast<uint32_t>(counter >> 32));
+    
+    for (size_t l = 0; l < kPairs; ++l) {
+        uint32_t h1 = rng::counter_hash(base + static_cast<uint32_t>(l), key.k0, k1);
+        uint32_t h2 = rng::counter_hash(base + static_cast<uint32_t>(kPairs + l), key.k0, k1);
+        
+        // u1 in (0, 1], so the radius stays finite (tails are cut at about 6.66 sigma)
+        float u1 = static_cast<float>(static_cast<int32_t>(h1 >> 1)) * 4.656612873e-10f + 2.328306437e-10f;
+        float r2 = -2.0f * log_approx(u1);
+        float radius = sqrt_approx(r2);  // log_approx(u1) <= 0 for u1 <= 1
+        
+        // Angle 2*pi*t: quadrant q = round(4t) and offset f in [-pi/4, pi/4], in integers
+        int32_t t = static_cast<int32_t>(h2 >> 8);  // 24-bit fraction
+        int32_t q = (t + (1 << 21)) >> 22;
+        float f = static_cast<float>(t - (q << 22)) * 3.745070261e-7f;  // (pi/2) / 2^22
+        float f2 = f * f;
+        float sf = f + f * f2 * (-1.6666654611e-1f + f2 * (8.3321608736e-3f + f2 * -1.9515295891e-4f));
+        float cf = 1.0f - 0.5f * f2
+            + f2 * f2 * (4.166664568e-2f + f2 * (-1.388731625e-3f + f2 * 2.443315711e-5f));
+        
+        // Rotate (cf, sf) by q quarter turns
+        uint32_t swap = 0u - static_cast<uint32_t>(q & 1);
+        float sine_sign = static_cast<float>(1 - (q & 2));
+        float cosine_sign = static_cast<float>(1 - ((q + 1) & 2));
+        out[l] = radius * cosine_sign * select(swap, sf, cf);
+        out[kPairs + l] = radius * sine_sign * select(swap, cf, sf);
+    }
+}
+
+void gaussian_block_portable(float* out, uint64_t block, const StreamKey& key) {
+    gaussian_block_body(out, block, key);
+}
+
+#ifdef BITSHIELD_AWGN_AVX2
+// Same operations in 8-wide registers; no FMA, so samples match the portable kernel bit for bit
+__attribute__((target("avx2")))
+void gaussian_block_avx2(float* out, uint64_t block, const StreamKey& key) {
+    gaussian_block_body(out, block, key);
+}
+#endif
+
+using BlockKernel = void (*)(float*, uint64_t, const StreamKey&);
+
+BlockKernel block_kernel() {
+#ifdef BITSHIELD_AWGN_AVX2
+    static const BlockKernel kernel = __builtin_cpu_supports("avx2") ? gaussian_block_avx2 : gaussian_block_portable;
+    return kernel;
+#else
+    return gaussian_block_portable;
+#endif
+}
+
+uint64_t resolve_seed(std::optional<uint32_t> seed) {
+    if (seed.has_value()) {
+        return seed.value();
+    }
+    std::random_device rd;
+    return rd();
+}
+
+// Turn unit-variance noise samples into BPSK/AWGN LLRs in place:
+// L = (2 / sigma^2) * (x + sigma * n) with x = +1 for bit 0 and -1 for bit 1
+void bpsk_llrs(const uint8_t* bits, float* samples, size_t count, double sigma) {
+    float gain = static_cast<float>(2.0 / (sigma * sigma));
+    float noise_gain = static_cast<float>(2.0 / sigma);
+    for (size_t i = 0; i < count; ++i) {
+        float x = gain - 2.0f * gain * static_cast<float>(bits[i] & 1);
+        samples[i] = x + noise_gain * samples[i];
+    }
+}
+
+void quantize_llrs(const float* llrs, int8_t* out, size_t count, float scale) {
+    for (size_t i = 0; i < count; ++i) {
+        // Round half to even by adding and removing 1.5 * 2^23, then saturate:
+        // identical to llr::quantize (nearbyint, then saturate) but vectorisable.
+        // Values too large for the trick to round exactly saturate anyway.
+        float v = (llrs[i] * scale + 12582912.0f) - 12582912.0f;
+        v = v == v ? v : 0.0f;  // NaN
+        v = v > 127.0f ? 127.0f : v;
+        v = v < -127.0f ? -127.0f : v;
+        out[i] = static_cast<int8_t>(static_cast<int32_t>(v));
+    }
+}
+
+} // anonymous namespace
+
+double awgn_sigma(double ebn0_db, double rate) {
+    if (!(rate > 0.0 && rate <= 1.0)) {
+        throw std::invalid_argument("Code rate must be in (0, 1]");
+    }
+    double ebn0 = std::pow(10.0, ebn0_db / 10.0);
+    return std::sqrt(1.0 / (2.0 * rate * ebn0));
+}
+
+void gaussian_fill(float* out, size_t count, uint64_t seed, uint64_t first) {
+    StreamKey key = make_key(seed);
+    BlockKernel gaussian_block = block_kernel();
+    
+    uint64_t block = first / kBlock;
+    size_t skip = static_cast<size_t>(first % kBlock);
+    size_t done = 0;
+    
+    float tmp[kBlock];
+    while (done < count) {
+        if (skip == 0 && count - done >= kBlock) {
+            gaussian_block(out + done, block, key);
+            done += kBlock;
+        } else {
+            // Partial block at either end of the range
+            gaussian_block(tmp, block, key);
+            size_t n = kBlock - skip < count - done ? kBlock - skip : count - done;
+            std::memcpy(out + done, tmp + skip, n * sizeof(float));
+            done += n;
+            skip = 0;
+        }
+        block++;
+    }
+}
+
+std::vector<float> awgn_llr(
+    util::ConstBitSpan bits,
+    double ebn0_db,
+    double rate,
+    std::optional<uint32_t> seed
+) {
+    double sigma = awgn_sigma(ebn0_db, rate);
+    
+    std::vector<float> llrs(bits.size());
+    uint64_t stream = resolve_seed(seed);
+    for (size_t offset = 0; offset < bits.size(); offset += kChunk) {
+        size_t count = bits.size() - offset < kChunk ? bits.size() - offset : kChunk;
+        gaussian_fill(llrs.data() + offset, count, stream, offset);
+        bpsk_llrs(bits.data() + offset, llrs.data() + offset, count, sigma);
+    }
+    
+    return llrs;
+}
+
+std::vector<int8_t> awgn_llr_quantized(
+    util::ConstBitSpan bits,
+    double ebn0_db,
+    double rate,
+    float scale,
+    std::optional<uint32_t> seed
+) {
+    if (!(scale > 0.0f)) {
+        throw std::invalid_argument("LLR quantisation scale must be > 0");
+    }
+    double sigma = awgn_sigma(ebn0_db, rate);
+    
+    std::vector<int8_t> llrs(bits.size());
+    uint64_t stream = resolve_seed(seed);
+    float chunk[kChunk];
+    for (size_t offset = 0; offset < bits.size(); offset += kChunk) {
+        size_t count = bits.size() - offset < kChunk ? bits.size() - offset : kChunk;
+        gaussian_fill(chunk, count, stream, offset);
+        bpsk_llrs(bits.data() + offset, chunk, count, sigma);
+        quantize_llrs(chunk, llrs.data() + offset, count, scale);
+    }
+    
+    return llrs;
+}
+
+} // namespace bitshield::channel
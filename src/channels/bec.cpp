@@ -0,0 +1,50 @@
+#include <bitshield/channels/bec.hpp>
+#include <bitshield/channels/markov.hpp>
+#include "../packed_bits.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include <cstdint>
+
+namespace bitshield::channel {
+
+std::vector<uint8_t> erasure_mask(
+    size_t nbits,
+    double p,
+    std::optional<uint32_t> seed
+) {
+    if (p < 0.0 || p > 1.0) {
+        throw std::invalid_argument("Erasure probability p must be between 0.0 and 1.0");
+    }
+    
+    // A single-state Markov channel marks i.i.d. positions with geometric gap sampling
+    MarkovChannel memoryless;
+    memoryless.transitions = {{1.0}};
+    memoryless.error_rates = {p};
+    return markov_error_mask(memoryless, nbits, seed);
+}
+
+std::vector<uint8_t> apply_erasures(util::ConstBitSpan bits, util::PackedBitSpan erasures) {
+    if (erasures.size() < bits.size()) {
+        throw std::invalid_argument("Erasure mask is shorter than the bit vector");
+    }
+    
+    std::vector<uint8_t> received = bits.to_vector();
+    
+    size_t i = 0;
+    for (size_t byte = 0; i < received.size(); ++byte, i += 8) {
+        uint8_t m = erasures.byte(byte);
+        if (m == 0) {
+            continue;
+        }
+        size_t end = std::min(i + 8, received.size());
+        for (size_t j = i; j < end; ++j) {
+            // Keep the bit only where the mask is clear
+            received[j] &= packed_bits::test_bit(&m, j - i) ^ 1;
+        }
+    }
+    
+    return received;
+}
+
+} // namespace bitshield::channel
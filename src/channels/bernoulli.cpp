@@ -0,0 +1,156 @@
+#include <bitshield/channels/bernoulli.hpp>
+#include <bitshield/channel.hpp>
+#include "../rng.hpp"
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <cstdint>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define BITSHIELD_BERNOULLI_AVX2 1
+#endif
+
+namespace bitshield::channel {
+
+namespace {
+
+using rng::StreamKey;
+using rng::make_key;
+
+// Mask bits produced per block; the hash and compare loops below are
+// straight-line loops over a block, written so compilers emit vector code
+constexpr size_t kBlockBits = 256;
+constexpr size_t kBlockBytes = kBlockBits / 8;
+
+// Flips for bits block * kBlockBits .. + kBlockBits - 1, packed MSB-first:
+// bit i flips when the hash of its index is below the threshold
+inline void threshold_block_body(uint8_t* out, uint64_t block, const StreamKey& key, uint32_t threshold) {
+    uint64_t counter = block * kBlockBits;
+    uint32_t base = static_cast<uint32_t>(counter);
+    uint32_t k1 = key.k1 ^ rng::mix32(static_cast<uint32_t>(counter >> 32));
+    
+    uint8_t flags[kBlockBits];
+    for (size_t l = 0; l < kBlockBits; ++l) {
+        uint32_t h = rng::counter_hash(base + static_cast<uint32_t>(l), key.k0, k1);
+        flags[l] = static_cast<uint8_t>(h < threshold);
+    }
+    
+    // Gather eight 0/1 flags into one byte, first flag in the MSB
+    for (size_t b = 0; b < kBlockBytes; ++b) {
+        uint64_t v;
+        std::memcpy(&v, flags + 8 * b, sizeof(v));
+        out[b] = static_cast<uint8_t>((v * 0x8040201008040201ULL) >> 56);
+    }
+}
+
+// p = 0.5: every hash bit is a fair flip, so a block takes kBlockBits / 32 draws
+inline void raw_block_body(uint8_t* out, uint64_t block, const StreamKey& key) {
+    uint64_t counter = block * kBlockBits;
+    uint32_t base = static_cast<uint32_t>(counter);
+    uint32_t k1 = key.k1 ^ rng::mix32(static_cast<uint32_t>(counter >> 32));
+    
+    for (size_t l = 0; l < kBlockBytes / 4; ++l) {
+        uint32_t h = rng::counter_hash(base + static_cast<uint32_t>(l), key.k0, k1);
+        out[4 * l] = static_cast<uint8_t>(h >> 24);
+        out[4 * l + 1] = static_cast<uint8_t>(h >> 16);
+        out[4 * l + 2] = static_cast<uint8_t>(h >> 8);
+        out[4 * l + 3] = static_cast<uint8_t>(h);
+    }
+}
+
+void threshold_block_portable(uint8_t* out, uint64_t block, const StreamKey& key, uint32_t threshold) {
+    threshold_block_body(out, block, key, threshold);
+}
+
+#ifdef BITSHIELD_BERNOULLI_AVX2
+__attribute__((target("avx2")))
+void threshold_block_avx2(uint8_t* out, uint64_t block, const StreamKey& key, uint32_t threshold) {
+    threshold_block_body(out, block, key, threshold);
+}
+#endif
+
+using BlockKernel = void (*)(uint8_t*, uint64_t, const StreamKey&, uint32_t);
+
+BlockKernel block_kernel() {
+#ifdef BITSHIELD_BERNOULLI_AVX2
+    static const BlockKernel kernel = __builtin_cpu_supports("avx2") ? threshold_block_avx2 : threshold_block_portable;
+    return kernel;
+#else
+    return threshold_block_portable;
+#endif
+}
+
+} // anonymous namespace
+
+void xor_bernoulli_mask(uint8_t* packed, size_t nbits, double p, uint64_t seed) {
+    if (p < 0.0 || p > 1.0) {
+        throw std::invalid_argument("Noise probability p must be between 0.0 and 1.0");
+    }
+    if (p == 0.0 || nbits == 0) {
+        return;
+    }
+    
+    size_t nbytes = nbits / 8;
+    uint8_t tail_mask = static_cast<uint8_t>(0xFF00u >> (nbits % 8));
+    if (p == 1.0) {
+        for (size_t i = 0; i < nbytes; ++i) {
+            packed[i] ^= 0xFF;
+        }
+        if (tail_mask != 0) {
+            packed[nbytes] ^= tail_mask;
+        }
+        return;
+    }
+    
+    // p in (0, 1) maps to [0, 2^32 - 1]; the last step is within 2^-32 of 1
+    double scaled = p * 4294967296.0 + 0.5;
+    uint32_t threshold = scaled >= 4294967295.0 ? 0xFFFFFFFFu : static_cast<uint32_t>(scaled);
+    bool raw = threshold == 0x80000000u;
+    BlockKernel threshold_block = block_kernel();
+    StreamKey key = make_key(seed);
+    
+    uint8_t flips[kBlockBytes];
+    for (size_t begin = 0, block = 0; begin * 8 < nbits; begin += kBlockBytes, ++block) {
+        if (raw) {
+            raw_block_body(flips, block, key);
+        } else {
+            threshold_block(flips, block, key, threshold);
+        }
+        size_t end = begin + kBlockBytes < nbytes ? begin + kBlockBytes : nbytes;
+        for (size_t i = begin; i < end; ++i) {
+            packed[i] ^= flips[i - begin];
+        }
+        if (end == nbytes && tail_mask != 0 && nbytes < begin + kBlockBytes) {
+            packed[nbytes] ^= flips[nbytes - begin] & tail_mask;
+        }
+    }
+}
+
+std::vector<uint8_t> bernoulli_mask(
+    size_t nbits,
+    double p,
+    std::optional<uint32_t> seed
+) {
+    uint64_t stream;
+    if (seed.has_value()) {
+        stream = seed.value();
+    } else {
+        std::random_device rd;
+        stream = rd();
+    }
+    
+    std::vector<uint8_t> mask((nbits + 7) / 8, 0);
+    xor_bernoulli_mask(mask.data(), nbits, p, stream);
+    return mask;
+}
+
+std::vector<uint8_t> apply_bernoulli(
+    util::ConstBitSpan bits,
+    double p,
+    std::optional<uint32_t> seed
+) {
+    return apply_mask(bits, bernoulli_mask(bits.size(), p, seed));
+}
+
+} // namespace bitshield::channel
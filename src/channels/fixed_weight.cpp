@@ -0,0 +1,62 @@
+#include <bitshield/channels/fixed_weight.hpp>
+#include <bitshield/channel.hpp>
+#include "../packed_bits.hpp"
+#include "../rng.hpp"
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <cstdint>
+
+namespace bitshield::channel {
+
+std::vector<uint8_t> fixed_weight_mask(
+    size_t nbits,
+    size_t block_size,
+    size_t weight,
+    std::optional<uint32_t> seed
+) {
+    if (block_size == 0) {
+        throw std::invalid_argument("Fixed-weight block size must be > 0");
+    }
+    if (weight > block_size) {
+        throw std::invalid_argument("Fixed-weight error count must not exceed the block size");
+    }
+    
+    std::mt19937 rng;
+    if (seed.has_value()) {
+        rng.seed(seed.value());
+    } else {
+        std::random_device rd;
+        rng.seed(rd());
+    }
+    
+    std::vector<uint8_t> mask((nbits + 7) / 8, 0);
+    for (uint64_t begin = 0; begin < nbits; begin += block_size) {
+        uint64_t size = nbits - begin < block_size ? nbits - begin : block_size;
+        uint64_t count = weight < size ? weight : size;
+        
+        // Floyd's algorithm: count distinct positions from [0, size) in count
+        // draws. The mask itself is the set of chosen positions.
+        for (uint64_t j = size - count; j < size; ++j) {
+            uint64_t t = rng::uniform_below(rng, j + 1);
+            if (packed_bits::test_bit(mask.data(), begin + t)) {
+                packed_bits::set_bit(mask.data(), begin + j);
+            } else {
+                packed_bits::set_bit(mask.data(), begin + t);
+            }
+        }
+    }
+    
+    return mask;
+}
+
+std::vector<uint8_t> apply_fixed_weight(
+    util::ConstBitSpan bits,
+    size_t block_size,
+    size_t weight,
+    std::optional<uint32_t> seed
+) {
+    return apply_mask(bits, fixed_weight_mask(bits.size(), block_size, weight, seed));
+}
+
+} // namespace bitshield::channel
@@ -0,0 +1,218 @@
+#include <bitshield/channels/markov.hpp>
+#include <bitshield/channel.hpp>
+#include "../packed_bits.hpp"
+#include "../rng.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <cstdint>
+
+namespace bitshield::channel {
+
+namespace {
+
+void validate(const MarkovChannel& channel) {
+    size_t states = channel.error_rates.size();
+    if (states == 0) {
+        throw std::invalid_argument("Markov channel requires at least one state");
+    }
+    if (channel.transitions.size() != states) {
+        throw std::invalid_argument("Markov channel transition matrix must have one row per state");
+    }
+    if (channel.initial_state >= states) {
+        throw std::invalid_argument("Markov channel initial state is out of range");
+    }
+    for (size_t i = 0; i < states; ++i) {
+        double e = channel.error_rates[i];
+        if (!(e >= 0.0 && e <= 1.0)) {
+            throw std::invalid_argument("Markov channel error rates must be between 0.0 and 1.0");
+        }
+        const std::vector<double>& row = channel.transitions[i];
+        if (row.size() != states) {
+            throw std::invalid_argument("Markov channel transition matrix must be square");
+        }
+        double sum = 0.0;
+        for (double p : row) {
+            if (!(p >= 0.0 && p <= 1.0)) {
+                throw std::invalid_argument("Markov channel transition probabilities must be between 0.0 and 1.0");
+            }
+            sum += p;
+        }
+        if (std::abs(sum - 1.0) > 1e-9) {
+            throw std::invalid_argument("Markov channel transition rows must sum to 1.0");
+        }
+    }
+}
+
+// Number of consecutive "continue" outcomes before the first "stop" when each
+// trial continues with probability q = exp(log_q), capped at limit.
+uint64_t geometric(std::mt19937& rng, double log_q, uint64_t limit) {
+    if (log_q == 0.0) {
+        return limit;  // q == 1: never stops
+    }
+    double g = std::floor(std::log(rng::uniform_open01(rng)) / log_q);
+    return g >= static_cast<double>(limit) ? limit : static_cast<uint64_t>(g);
+}
+
+// Set bits [begin, end) of an MSB-first packed mask
+void set_range(std::vector<uint8_t>& mask, uint64_t begin, uint64_t end) {
+    while (begin < end && (begin & 7) != 0) {
+        packed_bits::set_bit(mask.data(), begin++);
+    }
+    uint64_t whole = (end - begin) / 8;
+    if (whole > 0) {
+        std::memset(mask.data() + (begin >> 3), 0xFF, whole);
+        begin += whole * 8;
+    }
+    while (begin < end) {
+        packed_bits::set_bit(mask.data(), begin++);
+    }
+}
+
+} // anonymous namespace
+
+MarkovChannel gilbert_elliott(double p_good_to_bad, double p_bad_to_good, double error_good, double error_bad) {
+    for (double p : {p_good_to_bad, p_bad_to_good, error_good, error_bad}) {
+        if (!(p >= 0.0 && p <= 1.0)) {
+            throw std::invalid_argument("Gilbert-Elliott probabilities must be between 0.0 and 1.0");
+        }
+    }
+    
+    MarkovChannel channel;
+    channel.transitions = {
+        {1.0 - p_good_to_bad, p_good_to_bad},
+        {p_bad_to_good, 1.0 - p_bad_to_good},
+    };
+    channel.error_rates = {error_good, error_bad};
+    channel.initial_state = 0;
+    return channel;
+}
+
+std::vector<double> stationary_distribution(const MarkovChannel& channel) {
+    validate(channel);
+    
+    // Solve pi (P - I) = 0 with the last equation replaced by sum(pi) = 1.
+    // Row r of the system is column r of (P - I)^T.
+    size_t n = channel.error_rates.size();
+    std::vector<std::vector<double>> a(n, std::vector<double>(n + 1, 0.0));
+    for (size_t r = 0; r < n; ++r) {
+        for (size_t c = 0; c < n; ++c) {
+            a[r][c] = channel.transitions[c][r] - (r == c ? 1.0 : 0.0);
+        }
+    }
+    std::fill(a[n - 1].begin(), a[n - 1].end(), 1.0);
+    
+    for (size_t col = 0; col < n; ++col) {
+        size_t pivot = col;
+        for (size_t r = col + 1; r < n; ++r) {
+            if (std::abs(a[r][col]) > std::abs(a[pivot][col])) {
+                pivot = r;
+            }
+        }
+        if (std::abs(a[pivot][col]) < 1e-12) {
+            throw std::invalid_argument("Markov channel has no unique stationary distribution");
+        }
+        std::swap(a[pivot], a[col]);
+        for (size_t r = 0; r < n; ++r) {
+            if (r != col && a[r][col] != 0.0) {
+                double f = a[r][col] / a[col][col];
+                for (size_t c = col; c <= n; ++c) {
+                    a[r][c] -= f * a[col][c];
+                }
+            }
+        }
+    }
+    
+    std::vector<double> pi(n);
+    for (size_t i = 0; i < n; ++i) {
+        pi[i] = std::max(0.0, a[i][n] / a[i][i]);
+    }
+    return pi;
+}
+
+double average_error_rate(const MarkovChannel& channel) {
+    std::vector<double> pi = stationary_distribution(channel);
+    double rate = 0.0;
+    for (size_t i = 0; i < pi.size(); ++i) {
+        rate += pi[i] * channel.error_rates[i];
+    }
+    return rate;
+}
+
+std::vector<uint8_t> markov_error_mask(
+    const MarkovChannel& channel,
+    size_t nbits,
+    std::optional<uint32_t> seed
+) {
+    validate(channel);
+    
+    std::mt19937 rng;
+    if (seed.has_value()) {
+        rng.seed(seed.value());
+    } else {
+        std::random_device rd;
+        rng.seed(rd());
+    }
+    
+    size_t states = channel.error_rates.size();
+    std::vector<double> log_stay(states);
+    std::vector<double> log_clean(states);
+    for (size_t s = 0; s < states; ++s) {
+        log_stay[s] = std::log(channel.transitions[s][s]);
+        log_clean[s] = std::log(1.0 - channel.error_rates[s]);
+    }
+    
+    std::vector<uint8_t> mask((nbits + 7) / 8, 0);
+    size_t state = channel.initial_state;
+    uint64_t pos = 0;
+    while (pos < nbits) {
+        // Sojourn: the current bit plus every further bit that stays in this state
+        uint64_t length = 1 + geometric(rng, log_stay[state], nbits - pos - 1);
+        
+        double e = channel.error_rates[state];
+        if (e >= 1.0) {
+            set_range(mask, pos, pos + length);
+        } else if (e > 0.0) {
+            // Skip over runs of clean bits instead of testing every bit
+            uint64_t offset = geometric(rng, log_clean[state], length);
+            while (offset < length) {
+                packed_bits::set_bit(mask.data(), pos + offset);
+                offset += 1 + geometric(rng, log_clean[state], length);
+            }
+        }
+        pos += length;
+        
+        if (pos < nbits) {
+            // Leave the state: pick the next one in proportion to the off-diagonal row
+            const std::vector<double>& row = channel.transitions[state];
+            double target = rng::uniform_open01(rng) * (1.0 - row[state]);
+            size_t next = state;
+            for (size_t j = 0; j < states; ++j) {
+                if (j == state || row[j] <= 0.0) {
+                    continue;
+                }
+                next = j;
+                target -= row[j];
+                if (target < 0.0) {
+                    break;
+                }
+            }
+            state = next;
+        }
+    }
+    
+    return mask;
+}
+
+std::vector<uint8_t> apply_markov(
+    util::ConstBitSpan bits,
+    const MarkovChannel& channel,
+    std::optional<uint32_t> seed
+) {
+    return apply_mask(bits, markov_error_mask(channel, bits.size(), seed));
+}
+
+} // namespace bitshield::channel
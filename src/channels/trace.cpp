@@ -0,0 +1,108 @@
+#include <bitshield/channels/trace.hpp>
+#include "../packed_bits.hpp"
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+namespace bitshield::channel {
+
+TraceChannel::TraceChannel(const std::string& path, uint64_t offset, bool loop)
+    : TraceChannel(std::make_shared<const io::MappedFile>(path), offset, loop) {}
+
+TraceChannel::TraceChannel(std::shared_ptr<const io::MappedFile> trace, uint64_t offset, bool loop)
+    : trace_(std::move(trace)), offset_(offset), loop_(loop) {
+    uint64_t total = static_cast<uint64_t>(trace_->size()) * 8;
+    if (total == 0) {
+        throw std::invalid_argument("Error trace is empty");
+    }
+    if (offset >= total) {
+        throw std::invalid_argument("Error trace offset is past the end of the trace");
+    }
+    length_ = total - offset;
+}
+
+double TraceChannel::error_rate() const {
+    const uint8_t* data = trace_->data();
+    uint64_t errors = 0;
+    uint64_t pos = offset_;
+    uint64_t end = offset_ + length_;
+    for (; pos < end && (pos & 7) != 0; ++pos) {
+        errors += packed_bits::test_bit(data, pos);
+    }
+    // Whole bytes: count set bits a byte at a time
+    for (; pos + 8 <= end; pos += 8) {
+        uint8_t byte = data[pos >> 3];
+        while (byte != 0) {
+            byte &= static_cast<uint8_t>(byte - 1);
+            errors++;
+        }
+    }
+    for (; pos < end; ++pos) {
+        errors += packed_bits::test_bit(data, pos);
+    }
+    return static_cast<double>(errors) / static_cast<double>(length_);
+}
+
+template <typename Visit>
+void TraceChannel::for_each_run(uint64_t position, size_t nbits, Visit visit) const {
+    if (!loop_ && (position > length_ || nbits > length_ - position)) {
+        throw std::invalid_argument("Error trace window passes the end of the trace");
+    }
+    
+    uint64_t pos = position % length_;
+    size_t done = 0;
+    while (done < nbits) {
+        uint64_t run = length_ - pos;
+        if (run > nbits - done) {
+            run = nbits - done;
+        }
+        visit(offset_ + pos, done, static_cast<size_t>(run));
+        done += static_cast<size_t>(run);
+        pos = 0;  // Only reached again when looping
+    }
+}
+
+std::vector<uint8_t> TraceChannel::mask(uint64_t position, size_t nbits) const {
+    const uint8_t* data = trace_->data();
+    std::vector<uint8_t> out((nbits + 7) / 8, 0);
+    for_each_run(position, nbits, [&](uint64_t src, size_t dst, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            uint8_t bit = packed_bits::test_bit(data, src + i);
+            size_t d = dst + i;
+            out[d >> 3] |= static_cast<uint8_t>(bit << (7 - (d & 7)));
+        }
+    });
+    return out;
+}
+
+std::vector<uint8_t> TraceChannel::apply(util::ConstBitSpan bits, uint64_t position) const {
+    std::vector<uint8_t> received = bits.to_vector();
+    apply_in_place(received, position);
+    return received;
+}
+
+void TraceChannel::apply_in_place(util::BitSpan received, uint64_t position) const {
+    const uint8_t* data = trace_->data();
+    for_each_run(position, received.size(), [&](uint64_t src, size_t dst, size_t count) {
+        size_t i = 0;
+        while (i < count) {
+            uint64_t pos = src + i;
+            uint8_t byte = data[pos >> 3];
+            size_t in_byte = 8 - static_cast<size_t>(pos & 7);
+            if (in_byte > count - i) {
+                in_byte = count - i;
+            }
+            // Traces are mostly clean: skip error-free bytes without touching bits
+            if (byte != 0) {
+                for (size_t k = 0; k < in_byte; ++k) {
+                    received[dst + i + k] ^= packed_bits::test_bit(data, pos + k);
+                }
+            }
+            i += in_byte;
+        }
+    });
+}
+
+} // namespace bitshield::channel
@@ -0,0 +1,398 @@
+#include <bitshield/codecs/codec.hpp>
+#include <bitshield/codecs/repetition.hpp>
+#include <bitshield/codecs/hamming74.hpp>
+#include <bitshield/codecs/product.hpp>
+#include <bitshield/interleaver.hpp>
+#include <bitshield/llr.hpp>
+#include <bitshield/bitstream.hpp>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace bitshield::codec {
+
+namespace {
+
+// Run one stage of a composite codec into caller storage, through the
+// stage's _into form when it has one
+void run_into(const Codec& stage, bool encode, util::ConstBitSpan bits, util::BitSpan out) {
+    const BitTransformInto& into = encode ? stage.encode_into : stage.decode_into;
+    if (into) {
+        into(bits, out);
+        return;
+    }
+    std::vector<uint8_t> coded = encode ? stage.encode(bits) : stage.decode(bits);
+    if (coded.size() > out.size()) {
+        throw std::invalid_argument("Codec stage output does not fit its span");
+    }
+    std::copy(coded.begin(), coded.end(), out.begin());
+}
+
+// Per-thread arena for the intermediate buffers of composite codecs. Nested
+// composites allocate from the same arena, which is reset when the
+// outermost one returns, so once warm the stages run without touching the
+// heap.
+class StageScratch {
+public:
+    StageScratch() { depth()++; }
+    ~StageScratch() {
+        if (--depth() == 0) {
+            arena().reset();
+        }
+    }
+    
+    StageScratch(const StageScratch&) = delete;
+    StageScratch& operator=(const StageScratch&) = delete;
+    
+    util::BitSpan bits(size_t count) { return arena().bits(count); }
+    
+private:
+    static util::BitArena& arena() {
+        thread_local util::BitArena scratch;
+        return scratch;
+    }
+    
+    static size_t& depth() {
+        thread_local size_t nesting = 0;
+        return nesting;
+    }
+};
+
+// Copy the result of a codec without an _into form into the arena
+util::BitSpan hold(const std::vector<uint8_t>& bits, util::BitArena& arena) {
+    util::BitSpan out = arena.bits(bits.size());
+    std::copy(bits.begin(), bits.end(), out.begin());
+    return out;
+}
+
+} // anonymous namespace
+
+std::vector<uint8_t> decode_llr(const Codec& codec, util::ConstSpan<float> llrs) {
+    if (codec.decode_soft) {
+        return codec.decode_soft(llrs);
+    }
+    return codec.decode(llr::hard_decision(llrs));
+}
+
+util::BitSpan decode_llr(const Codec& codec, util::ConstSpan<float> llrs, util::BitArena& arena) {
+    if (codec.decode_soft_into) {
+        util::BitSpan out = arena.bits(coded_size(codec, llrs.size(), false));
+        codec.decode_soft_into(llrs, out);
+        return out;
+    }
+    if (codec.decode_soft) {
+        return hold(codec.decode_soft(llrs), arena);
+    }
+    util::BitSpan hard = arena.bits(llrs.size());
+    llr::hard_decision(llrs, hard);
+    return decode(codec, hard, arena);
+}
+
+std::vector<uint8_t> decode_with_erasures(const Codec& codec, util::ConstBitSpan bits, util::PackedBitSpan erasures) {
+    if (erasures.size() < bits.size()) {
+        throw std::invalid_argument("Erasure mask is shorter than the bit vector");
+    }
+    if (codec.decode_erasures) {
+        return codec.decode_erasures(bits, erasures);
+    }
+    if (codec.decode_soft) {
+        // An erasure carries no information: LLR 0, received bits at full confidence
+        std::vector<float> llrs = llr::from_bits(bits);
+        for (size_t i = 0; i < llrs.size(); ++i) {
+            if (erasures[i]) {
+                llrs[i] = 0.0f;
+            }
+        }
+        return codec.decode_soft(llrs);
+    }
+    return codec.decode(bits);
+}
+
+util::BitSpan decode_with_erasures(
+    const Codec& codec,
+    util::ConstBitSpan bits,
+    util::PackedBitSpan erasures,
+    util::BitArena& arena
+) {
+    if (erasures.size() < bits.size()) {
+        throw std::invalid_argument("Erasure mask is shorter than the bit vector");
+    }
+    if (codec.decode_erasures_into) {
+        util::BitSpan out = arena.bits(coded_size(codec, bits.size(), false));
+        codec.decode_erasures_into(bits, erasures, out);
+        return out;
+    }
+    if (codec.decode_erasures || codec.decode_soft) {
+        return hold(decode_with_erasures(codec, bits, erasures), arena);
+    }
+    return decode(codec, bits, arena);
+}
+
+size_t coded_size(const Codec& codec, size_t input_bits, bool encode) {
+    size_t in = encode ? codec.data_bits : codec.code_bits;
+    size_t out = encode ? codec.code_bits : codec.data_bits;
+    return (input_bits + in - 1) / in * out;
+}
+
+util::BitSpan encode(const Codec& codec, util::ConstBitSpan bits, util::BitArena& arena) {
+    if (codec.encode_into) {
+        util::BitSpan out = arena.bits(coded_size(codec, bits.size(), true));
+        codec.encode_into(bits, out);
+        return out;
+    }
+    return hold(codec.encode(bits), arena);
+}
+
+util::BitSpan decode(const Codec& codec, util::ConstBitSpan bits, util::BitArena& arena) {
+    if (codec.decode_into) {
+        util::BitSpan out = arena.bits(coded_size(codec, bits.size(), false));
+        codec.decode_into(bits, out);
+        return out;
+    }
+    return hold(codec.decode(bits), arena);
+}
+
+Codec make_repetition(int n) {
+    if (n <= 0) {
+        throw std::invalid_argument("Repetition factor n must be > 0");
+    }
+    
+    Codec codec;
+    codec.name = "repetition";
+    codec.data_bits = 1;
+    codec.code_bits = static_cast<size_t>(n);
+    codec.encode = [n](util::ConstBitSpan bits) { return repetition::encode(bits, n); };
+    codec.decode = [n](util::ConstBitSpan bits) { return repetition::decode(bits, n); };
+    codec.encode_into = [n](util::ConstBitSpan bits, util::BitSpan out) { repetition::encode(bits, out, n); };
+    codec.decode_into = [n](util::ConstBitSpan bits, util::BitSpan out) { repetition::decode(bits, out, n); };
+    codec.decode_soft = [n](util::ConstSpan<float> llrs) { return repetition::decode_soft(llrs, n); };
+    codec.decode_erasures = [n](util::ConstBitSpan bits, util::PackedBitSpan erasures) {
+        return repetition::decode_erasures(bits, erasures, n);
+    };
+    codec.decode_soft_into = [n](util::ConstSpan<float> llrs, util::BitSpan out) { repetition::decode_soft(llrs, out, n); };
+    codec.decode_erasures_into = [n](util::ConstBitSpan bits, util::PackedBitSpan erasures, util::BitSpan out) {
+        repetition::decode_erasures(bits, erasures, out, n);
+    };
+    return codec;
+}
+
+Codec make_hamming74() {
+    Codec codec;
+    codec.name = "hamming";
+    codec.data_bits = 4;
+    codec.code_bits = 7;
+    codec.encode = [](util::ConstBitSpan bits) { return hamming74::encode_bits(bits); };
+    codec.decode = [](util::ConstBitSpan bits) { return hamming74::decode_bits(bits); };
+    codec.encode_into = [](util::ConstBitSpan bits, util::BitSpan out) { hamming74::encode_bits(bits, out); };
+    codec.decode_into = [](util::ConstBitSpan bits, util::BitSpan out) { hamming74::decode_bits(bits, out); };
+    codec.decode_soft = [](util::ConstSpan<float> llrs) { return hamming74::decode_soft_bits(llrs); };
+    codec.decode_erasures = [](util::ConstBitSpan bits, util::PackedBitSpan erasures) {
+        return hamming74::decode_erasure_bits(bits, erasures);
+    };
+    codec.decode_soft_into = [](util::ConstSpan<float> llrs, util::BitSpan out) { hamming74::decode_soft_bits(llrs, out); };
+    codec.decode_erasures_into = [](util::ConstBitSpan bits, util::PackedBitSpan erasures, util::BitSpan out) {
+        hamming74::decode_erasure_bits(bits, erasures, out);
+    };
+    return codec;
+}
+
+Codec make_product(int max_iterations) {
+    if (max_iterations <= 0) {
+        throw std::invalid_argument("Product code decode requires max_iterations > 0");
+    }
+    
+    Codec codec;
+    codec.name = "product";
+    codec.data_bits = 16;
+    codec.code_bits = 49;
+    codec.encode = [](util::ConstBitSpan bits) { return product::encode_bits(bits); };
+    codec.decode = [max_iterations](util::ConstBitSpan bits) {
+        return product::decode_bits(bits, max_iterations);
+    };
+    codec.encode_into = [](util::ConstBitSpan bits, util::BitSpan out) { product::encode_bits(bits, out); };
+    codec.decode_into = [max_iterations](util::ConstBitSpan bits, util::BitSpan out) {
+        product::decode_bits(bits, out, max_iterations);
+    };
+    return codec;
+}
+
+Codec make_concatenated(const Codec& outer, const Codec& inner, size_t depth) {
+    if (depth == 0) {
+        throw std::invalid_argument("Concatenated code requires interleaver depth > 0");
+    }
+    
+    // Outer codewords per frame: a multiple of depth whose outer output is a
+    // whole number of inner blocks, so frames encode and decode independently
+    size_t outer_span = depth * outer.code_bits;
+    size_t rows = depth * (inner.data_bits / std::gcd(outer_span, inner.data_bits));
+    size_t cols = outer.code_bits;
+    size_t frame_data = rows * outer.data_bits;
+    size_t frame_mid = rows * cols;
+    size_t frame_code = frame_mid / inner.data_bits * inner.code_bits;
+    
+    Codec codec;
+    codec.name = outer.name + "+" + inner.name;
+    codec.data_bits = frame_data;
+    codec.code_bits = frame_code;
+    codec.stream_blocks = outer.stream_blocks == 1 && inner.stream_blocks == 1 ? 1 : 0;
+    
+    // Stages hand their output to the next through scratch spans; only the
+    // final output is written to caller storage
+    codec.encode_into = [outer, inner, rows, cols, frame_data, frame_mid](util::ConstBitSpan bits, util::BitSpan out) {
+        size_t frames = (bits.size() + frame_data - 1) / frame_data;
+        size_t full = bits.size() / frame_data;
+        StageScratch scratch;
+        util::BitSpan mid = scratch.bits(frames * frame_mid);
+        util::BitSpan interleaved = scratch.bits(frames * frame_mid);
+        
+        // Whole frames are encoded straight from the input; only a partial
+        // last frame is copied out and padded with zeros
+        run_into(outer, true, bits.subspan(0, full * frame_data), mid);
+        if (full < frames) {
+            util::BitSpan tail = scratch.bits(frame_data);
+            std::fill(std::copy(bits.begin() + full * frame_data, bits.end(), tail.begin()), tail.end(), 0);
+            run_into(outer, true, tail, mid.subspan(full * frame_mid, frame_mid));
+        }
+        interleaver::block_interleave(mid, interleaved, rows, cols);
+        run_into(inner, true, interleaved, out);
+    };
+    
+    codec.decode_into = [outer, inner, rows, cols, frame_mid, frame_code](util::ConstBitSpan bits, util::BitSpan out) {
+        if (bits.size() % frame_code != 0) {
+            throw std::invalid_argument(
+                "Concatenated decode requires input size to be a multiple of " + std::to_string(frame_code));
+        }
+        StageScratch scratch;
+        util::BitSpan mid = scratch.bits(bits.size() / frame_code * frame_mid);
+        util::BitSpan deinterleaved = scratch.bits(mid.size());
+        run_into(inner, false, bits, mid);
+        interleaver::block_deinterleave(mid, deinterleaved, rows, cols);
+        run_into(outer, false, deinterleaved, out);
+    };
+    
+    codec.encode = [encode_into = codec.encode_into, frame_data, frame_code](util::ConstBitSpan bits) {
+        std::vector<uint8_t> out((bits.size() + frame_data - 1) / frame_data * frame_code);
+        encode_into(bits, out);
+        return out;
+    };
+    
+    codec.decode = [decode_into = codec.decode_into, frame_data, frame_code](util::ConstBitSpan bits) {
+        std::vector<uint8_t> out(bits.size() / frame_code * frame_data);
+        decode_into(bits, out);
+        return out;
+    };
+    
+    return codec;
+}
+
+Codec make_interleaved(const Codec& codec, const interleaver::Spec& spec) {
+    if (spec.rows == 0 || spec.cols == 0) {
+        throw std::invalid_argument("Interleaver dimensions must be > 0");
+    }
+    
+    Codec wrapped = codec;
+    wrapped.name = codec.name + "+interleaver";
+    wrapped.encode_into = nullptr;
+    wrapped.decode_into = nullptr;
+    wrapped.decode_soft_into = nullptr;
+    wrapped.decode_erasures_into = nullptr;
+    // Chunks must hold whole interleaver blocks as well as whole codewords;
+    // the convolutional interleaver spans the whole stream
+    if (spec.kind == interleaver::Kind::convolutional || codec.stream_blocks == 0) {
+        wrapped.stream_blocks = 0;
+    } else {
+        size_t frame = spec.rows * spec.cols;
+        size_t span = codec.stream_blocks * codec.code_bits;
+        wrapped.stream_blocks = codec.stream_blocks * (frame / std::gcd(span, frame));
+    }
+    wrapped.encode = [codec, spec](util::ConstBitSpan bits) {
+        return interleaver::interleave(codec.encode(bits), spec);
+    };
+    wrapped.decode = [codec, spec](util::ConstBitSpan bits) {
+        return codec.decode(interleaver::deinterleave(bits, spec));
+    };
+    if (codec.decode_soft) {
+        // LLRs are deinterleaved with the same permutation as the bits
+        wrapped.decode_soft = [codec, spec](util::ConstSpan<float> llrs) {
+            return codec.decode_soft(interleaver::deinterleave(llrs, spec));
+        };
+    }
+    wrapped.decode_erasures = [codec, spec](util::ConstBitSpan bits, util::PackedBitSpan erasures) {
+        // The erasure mask travels with the bits, so it is deinterleaved the same way
+        std::vector<uint8_t> erased(bits.size());
+        erasures.subspan(0, bits.size()).unpack(erased);
+        return decode_with_erasures(
+            codec,
+            interleaver::deinterleave(bits, spec),
+            util::bits_to_bytes(interleaver::deinterleave(erased, spec))
+        );
+    };
+    return wrapped;
+}
+
+ChunkedCoder::ChunkedCoder(const Codec& codec, Mode mode, size_t chunk_bits)
+    : codec_(codec), mode_(mode), chunk_bits_(0) {
+    if (codec.stream_blocks > 0) {
+        size_t unit = codec.stream_blocks * (mode == Mode::encode ? codec.data_bits : codec.code_bits);
+        chunk_bits_ = chunk_bits < unit ? unit : chunk_bits / unit * unit;
+    }
+}
+
+std::vector<uint8_t> ChunkedCoder::push(util::ConstBitSpan bits) {
+    if (chunk_bits_ == 0) {
+        pending_.insert(pending_.end(), bits.begin(), bits.end());
+        return {};
+    }
+    
+    std::vector<uint8_t> output;
+    auto emit = [&](util::ConstBitSpan chunk) {
+        std::vector<uint8_t> coded = code(chunk);
+        output.insert(output.end(), coded.begin(), coded.end());
+    };
+    
+    // Complete a buffered partial chunk first, then code whole chunks in place
+    size_t used = 0;
+    if (!pending_.empty()) {
+        used = std::min(chunk_bits_ - pending_.size(), bits.size());
+        pending_.insert(pending_.end(), bits.begin(), bits.begin() + used);
+        if (pending_.size() < chunk_bits_) {
+            return output;
+        }
+        emit(pending_);
+        pending_.clear();
+    }
+    for (; bits.size() - used >= chunk_bits_; used += chunk_bits_) {
+        emit(bits.subspan(used, chunk_bits_));
+    }
+    pending_.assign(bits.begin() + used, bits.end());
+    return output;
+}
+
+std::vector<uint8_t> ChunkedCoder::finish() {
+    std::vector<uint8_t> tail;
+    tail.swap(pending_);
+    if (tail.empty()) {
+        return {};
+    }
+    return code(tail);
+}
+
+std::vector<uint8_t> ChunkedCoder::code(util::ConstBitSpan bits) const {
+    return mode_ == Mode::encode ? codec_.encode(bits) : codec_.decode(bits);
+}
+
+Codec make_codec(const std::string& name, int n) {
+    if (name == "repetition") {
+        return make_repetition(n);
+    } else if (name == "hamming") {
+        return make_hamming74();
+    } else if (name == "product") {
+        return n > 0 ? make_product(n) : make_product();
+    }
+    throw std::invalid_argument("Unknown codec: " + name);
+}
+
+} // namespace bitshield::codec
@@ -1,11 +1,12 @@
 #include <bitshield/codecs/hamming74.hpp>
+#include <algorithm>
 #include <stdexcept>
 #include <vector>
 #include <cstdint>
 
 namespace bitshield::codec::hamming74 {
 
-std::vector<uint8_t> encode(const std::vector<uint8_t>& data_bits) {
+std::vector<uint8_t> encode(util::ConstBitSpan data_bits) {
     if (data_bits.size() != 4) {
         throw std::invalid_argument("Hamming(7,4) encode requires exactly 4 data bits");
     }
@@ -24,7 +25,7 @@ std::vector<uint8_t> encode(const std::vector<uint8_t>& data_bits) {
     return {p1, p2, d1, p3, d2, d3, d4};
 }
 
-std::vector<uint8_t> decode(const std::vector<uint8_t>& codeword) {
+std::vector<uint8_t> decode(util::ConstBitSpan codeword) {
     if (codeword.size() != 7) {
         throw std::invalid_argument("Hamming(7,4) decode requires exactly 7 bits");
     }
@@ -46,7 +47,7 @@ std::vector<uint8_t> decode(const std::vector<uint8_t>& codeword) {
     uint8_t syndrome = (s3 << 2) | (s2 << 1) | s1;
     
     // Correct error if any
-    std::vector<uint8_t> corrected = codeword;
+    uint8_t corrected[7] = {p1, p2, d1, p3, d2, d3, d4};
     if (syndrome > 0 && syndrome <= 7) {
         // Flip bit at error position (1-indexed, convert to 0-indexed)
         corrected[syndrome - 1] = corrected[syndrome - 1] ^ 1;
@@ -56,39 +57,278 @@ std::vector<uint8_t> decode(const std::vector<uint8_t>& codeword) {
     return {corrected[2], corrected[4], corrected[5], corrected[6]};
 }
 
-std::vector<uint8_t> encode_bits(const std::vector<uint8_t>& bits) {
-    std::vector<uint8_t> encoded;
-    encoded.reserve((bits.size() + 3) / 4 * 7);
+bool correct(uint8_t* bits, size_t stride) {
+    uint8_t p1 = bits[0];
+    uint8_t p2 = bits[stride];
+    uint8_t d1 = bits[2 * stride];
+    uint8_t p3 = bits[3 * stride];
+    uint8_t d2 = bits[4 * stride];
+    uint8_t d3 = bits[5 * stride];
+    uint8_t d4 = bits[6 * stride];
     
-    for (size_t i = 0; i < bits.size(); i += 4) {
-        std::vector<uint8_t> data_bits(4, 0);
-        for (int j = 0; j < 4 && (i + j) < bits.size(); ++j) {
-            data_bits[j] = bits[i + j];
+    uint8_t s1 = p1 ^ d1 ^ d2 ^ d4;
+    uint8_t s2 = p2 ^ d1 ^ d3 ^ d4;
+    uint8_t s3 = p3 ^ d2 ^ d3 ^ d4;
+    uint8_t syndrome = (s3 << 2) | (s2 << 1) | s1;
+    
+    if (syndrome == 0) {
+        return false;
+    }
+    bits[(syndrome - 1) * stride] ^= 1;
+    return true;
+}
+
+void encode_bits(util::ConstBitSpan bits, util::BitSpan encoded) {
+    size_t blocks = (bits.size() + 3) / 4;
+    if (encoded.size() < blocks * 7) {
+        throw std::invalid_argument("Hamming(7,4) encode output span is too small");
+    }
+    
+    for (size_t b = 0; b < blocks; ++b) {
+        uint8_t d[4] = {0, 0, 0, 0};
+        for (size_t j = 0; j < 4 && 4 * b + j < bits.size(); ++j) {
+            d[j] = bits[4 * b + j];
         }
         
-        std::vector<uint8_t> codeword = encode(data_bits);
-        encoded.insert(encoded.end(), codeword.begin(), codeword.end());
+        // Codeword layout: [p1, p2, d1, p3, d2, d3, d4]
+        uint8_t* codeword = encoded.data() + 7 * b;
+        codeword[0] = d[0] ^ d[1] ^ d[3];
+        codeword[1] = d[0] ^ d[2] ^ d[3];
+        codeword[2] = d[0];
+        codeword[3] = d[1] ^ d[2] ^ d[3];
+        codeword[4] = d[1];
+        codeword[5] = d[2];
+        codeword[6] = d[3];
     }
-    
+}
+
+std::vector<uint8_t> encode_bits(util::ConstBitSpan bits) {
+    std::vector<uint8_t> encoded((bits.size() + 3) / 4 * 7);
+    encode_bits(bits, encoded);
     return encoded;
 }
 
-std::vector<uint8_t> decode_bits(const std::vector<uint8_t>& encoded) {
+void decode_bits(util::ConstBitSpan encoded, util::BitSpan decoded) {
     if (encoded.size() % 7 != 0) {
         throw std::invalid_argument("Hamming(7,4) decode requires input size to be a multiple of 7");
     }
+    if (decoded.size() < encoded.size() / 7 * 4) {
+        throw std::invalid_argument("Hamming(7,4) decode output span is too small");
+    }
+    
+    // The syndrome names the flipped position; only data positions are
+    // written out, so the input is read once and never modified
+    for (size_t i = 0, j = 0; i < encoded.size(); i += 7, j += 4) {
+        const uint8_t* c = encoded.data() + i;
+        uint8_t s1 = c[0] ^ c[2] ^ c[4] ^ c[6];
+        uint8_t s2 = c[1] ^ c[2] ^ c[5] ^ c[6];
+        uint8_t s3 = c[3] ^ c[4] ^ c[5] ^ c[6];
+        unsigned syndrome = (s3 << 2) | (s2 << 1) | s1;
+        decoded[j] = c[2] ^ (syndrome == 3);
+        decoded[j + 1] = c[4] ^ (syndrome == 5);
+        decoded[j + 2] = c[5] ^ (syndrome == 6);
+        decoded[j + 3] = c[6] ^ (syndrome == 7);
+    }
+}
+
+std::vector<uint8_t> decode_bits(util::ConstBitSpan encoded) {
+    if (encoded.size() % 7 != 0) {
+        throw std::invalid_argument("Hamming(7,4) decode requires input size to be a multiple of 7");
+    }
+    std::vector<uint8_t> decoded(encoded.size() / 7 * 4);
+    decode_bits(encoded, decoded);
+    return decoded;
+}
+
+namespace {
+
+// Syndrome contribution of a 7-bit pattern (bit k = codeword position k):
+// position k is covered by the parity checks set in k + 1
+uint8_t pattern_syndrome(unsigned pattern) {
+    uint8_t syndrome = 0;
+    for (unsigned k = 0; k < 7; ++k) {
+        if ((pattern >> k) & 1) {
+            syndrome ^= static_cast<uint8_t>(k + 1);
+        }
+    }
+    return syndrome;
+}
+
+void fill_erasures(uint8_t* codeword, unsigned erased) {
+    unsigned received = 0;
+    for (unsigned k = 0; k < 7; ++k) {
+        received |= static_cast<unsigned>(codeword[k] & 1) << k;
+    }
+    uint8_t base = pattern_syndrome(received & ~erased);
     
-    std::vector<uint8_t> decoded;
-    decoded.reserve(encoded.size() / 7 * 4);
+    // Enumerate the subsets of the erased positions (completions with those bits set)
+    unsigned completion = 0;
+    do {
+        if (pattern_syndrome(completion) == base) {
+            for (unsigned k = 0; k < 7; ++k) {
+                if ((erased >> k) & 1) {
+                    codeword[k] = (completion >> k) & 1;
+                }
+            }
+            return;
+        }
+        completion = (completion - erased) & erased;
+    } while (completion != 0);
     
-    for (size_t i = 0; i < encoded.size(); i += 7) {
-        std::vector<uint8_t> codeword(encoded.begin() + i, encoded.begin() + i + 7);
-        std::vector<uint8_t> data_bits = decode(codeword);
-        decoded.insert(decoded.end(), data_bits.begin(), data_bits.end());
+    // No completion is a codeword: the unerased bits carry errors too
+    for (unsigned k = 0; k < 7; ++k) {
+        if ((erased >> k) & 1) {
+            codeword[k] = 0;
+        }
+    }
+    correct(codeword);
+}
+
+
+// Each codeword bit is a parity of the data value v = d1 d2 d3 d4 (d1 = MSB);
+// these are the masks of data bits feeding positions [p1, p2, d1, p3, d2, d3, d4]
+constexpr int kPositionMask[7] = {0b1101, 0b1011, 0b1000, 0b0111, 0b0100, 0b0010, 0b0001};
+
+// Blocks decoded side by side; metrics are kept as [codeword][lane] so every
+// step below is a straight-line loop over lanes that compiles to vector code
+constexpr size_t kLanes = 8;
+
+template <typename Llr, typename Acc>
+void decode_soft_lanes(const Llr* llrs, uint8_t* out) {
+    // The correlation of a block with codeword v is sum_k L_k * (-1)^<mask_k, v>,
+    // i.e. a 16-point Walsh-Hadamard transform of the LLRs placed at their masks
+    Acc metric[16][kLanes] = {};
+    for (int k = 0; k < 7; ++k) {
+        for (size_t l = 0; l < kLanes; ++l) {
+            metric[kPositionMask[k]][l] = static_cast<Acc>(llrs[l * 7 + k]);
+        }
+    }
+    for (int h = 1; h < 16; h <<= 1) {
+        for (int a = 0; a < 16; a += 2 * h) {
+            for (int b = a; b < a + h; ++b) {
+                for (size_t l = 0; l < kLanes; ++l) {
+                    Acc x = metric[b][l];
+                    Acc y = metric[b + h][l];
+                    metric[b][l] = x + y;
+                    metric[b + h][l] = x - y;
+                }
+            }
+        }
+    }
+    
+    // Branch-free argmax: data from the channel makes the winner unpredictable
+    Acc best_metric[kLanes];
+    int32_t best[kLanes];
+    for (size_t l = 0; l < kLanes; ++l) {
+        best_metric[l] = metric[0][l];
+        best[l] = 0;
+    }
+    for (int v = 1; v < 16; ++v) {
+        for (size_t l = 0; l < kLanes; ++l) {
+            bool better = metric[v][l] > best_metric[l];
+            best_metric[l] = better ? metric[v][l] : best_metric[l];
+            best[l] = better ? v : best[l];
+        }
     }
     
+    for (size_t l = 0; l < kLanes; ++l) {
+        out[4 * l] = (best[l] >> 3) & 1;
+        out[4 * l + 1] = (best[l] >> 2) & 1;
+        out[4 * l + 2] = (best[l] >> 1) & 1;
+        out[4 * l + 3] = best[l] & 1;
+    }
+}
+
+template <typename Llr, typename Acc>
+void decode_soft_impl(util::ConstSpan<Llr> llrs, util::BitSpan decoded) {
+    if (llrs.size() % 7 != 0) {
+        throw std::invalid_argument("Hamming(7,4) decode requires input size to be a multiple of 7");
+    }
+    size_t blocks = llrs.size() / 7;
+    if (decoded.size() < blocks * 4) {
+        throw std::invalid_argument("Hamming(7,4) decode output span is too small");
+    }
+    
+    size_t b = 0;
+    for (; b + kLanes <= blocks; b += kLanes) {
+        decode_soft_lanes<Llr, Acc>(llrs.data() + b * 7, decoded.data() + b * 4);
+    }
+    if (b < blocks) {
+        // Zero-pad the final partial group of blocks
+        Llr tail[kLanes * 7] = {};
+        uint8_t out[kLanes * 4];
+        std::copy(llrs.begin() + b * 7, llrs.end(), tail);
+        decode_soft_lanes<Llr, Acc>(tail, out);
+        std::copy(out, out + (blocks - b) * 4, decoded.begin() + b * 4);
+    }
+}
+
+template <typename Llr, typename Acc>
+std::vector<uint8_t> decode_soft_impl(util::ConstSpan<Llr> llrs) {
+    if (llrs.size() % 7 != 0) {
+        throw std::invalid_argument("Hamming(7,4) decode requires input size to be a multiple of 7");
+    }
+    std::vector<uint8_t> decoded(llrs.size() / 7 * 4);
+    decode_soft_impl<Llr, Acc>(llrs, decoded);
     return decoded;
 }
 
-} // namespace bitshield::codec::hamming74
+} // anonymous namespace
 
+void decode_erasure_bits(util::ConstBitSpan encoded, util::PackedBitSpan erasures, util::BitSpan decoded) {
+    if (encoded.size() % 7 != 0) {
+        throw std::invalid_argument("Hamming(7,4) decode requires input size to be a multiple of 7");
+    }
+    if (erasures.size() < encoded.size()) {
+        throw std::invalid_argument("Erasure mask is shorter than the encoded bit vector");
+    }
+    if (decoded.size() < encoded.size() / 7 * 4) {
+        throw std::invalid_argument("Hamming(7,4) decode output span is too small");
+    }
+    
+    for (size_t i = 0, j = 0; i < encoded.size(); i += 7, j += 4) {
+        unsigned erased = 0;
+        for (size_t k = 0; k < 7; ++k) {
+            erased |= static_cast<unsigned>(erasures[i + k]) << k;
+        }
+        
+        uint8_t codeword[7];
+        std::copy(encoded.begin() + i, encoded.begin() + i + 7, codeword);
+        if (erased == 0) {
+            correct(codeword);
+        } else {
+            fill_erasures(codeword, erased);
+        }
+        decoded[j] = codeword[2];
+        decoded[j + 1] = codeword[4];
+        decoded[j + 2] = codeword[5];
+        decoded[j + 3] = codeword[6];
+    }
+}
+
+std::vector<uint8_t> decode_erasure_bits(util::ConstBitSpan encoded, util::PackedBitSpan erasures) {
+    if (encoded.size() % 7 != 0) {
+        throw std::invalid_argument("Hamming(7,4) decode requires input size to be a multiple of 7");
+    }
+    std::vector<uint8_t> decoded(encoded.size() / 7 * 4);
+    decode_erasure_bits(encoded, erasures, decoded);
+    return decoded;
+}
+
+std::vector<uint8_t> decode_soft_bits(util::ConstSpan<float> llrs) {
+    return decode_soft_impl<float, float>(llrs);
+}
+
+std::vector<uint8_t> decode_soft_bits(util::ConstSpan<int8_t> llrs) {
+    return decode_soft_impl<int8_t, int32_t>(llrs);
+}
+
+void decode_soft_bits(util::ConstSpan<float> llrs, util::BitSpan decoded) {
+    decode_soft_impl<float, float>(llrs, decoded);
+}
+
+void decode_soft_bits(util::ConstSpan<int8_t> llrs, util::BitSpan decoded) {
+    decode_soft_impl<int8_t, int32_t>(llrs, decoded);
+}
+
+} // namespace bitshield::codec::hamming74
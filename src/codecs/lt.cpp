@@ -0,0 +1,305 @@
+#include <bitshield/codecs/lt.hpp>
+#include "../rng.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <cstdint>
+
+namespace bitshield::codec::lt {
+
+namespace {
+
+// Draw j of a packet is a counter-based hash of (seed, id, j): a handful of
+// integer mixes per neighbour instead of seeding a generator per packet
+class PacketDraws {
+public:
+    PacketDraws(uint32_t seed, uint32_t id)
+        : key_(rng::make_key((static_cast<uint64_t>(seed) << 32) | id)) {}
+    
+    uint32_t next() { return rng::counter_hash(j_++, key_.k0, key_.k1); }
+    
+    double uniform01() { return (static_cast<double>(next()) + 0.5) / 4294967296.0; }
+    
+private:
+    rng::StreamKey key_;
+    uint32_t j_ = 0;
+};
+
+std::vector<double> soliton_cdf(size_t k, const Parameters& params) {
+    std::vector<double> pmf = robust_soliton(k, params);
+    std::vector<double> cdf(pmf.size(), 0.0);
+    double sum = 0.0;
+    for (size_t d = 1; d < pmf.size(); ++d) {
+        sum += pmf[d];
+        cdf[d] = sum;
+    }
+    cdf.back() = 1.0;
+    return cdf;
+}
+
+std::vector<size_t> neighbours_from_cdf(uint32_t id, size_t k, uint32_t seed, const std::vector<double>& cdf) {
+    PacketDraws draws(seed, id);
+    
+    double u = draws.uniform01();
+    size_t degree = static_cast<size_t>(std::lower_bound(cdf.begin() + 1, cdf.end(), u) - cdf.begin());
+    degree = std::min(std::max<size_t>(degree, 1), k);
+    
+    // Floyd's algorithm: degree distinct indices from [0, k) in O(degree) draws
+    std::vector<size_t> chosen;
+    chosen.reserve(degree);
+    for (size_t j = k - degree; j < k; ++j) {
+        size_t t = rng::uniform_below(draws.next(), static_cast<uint32_t>(j + 1));
+        if (std::find(chosen.begin(), chosen.end(), t) != chosen.end()) {
+            chosen.push_back(j);
+        } else {
+            chosen.push_back(t);
+        }
+    }
+    std::sort(chosen.begin(), chosen.end());
+    return chosen;
+}
+
+} // anonymous namespace
+
+std::vector<double> robust_soliton(size_t k, const Parameters& params) {
+    if (k == 0) {
+        throw std::invalid_argument("LT code requires at least one source symbol");
+    }
+    if (k > 0xFFFFFFFFULL) {
+        throw std::invalid_argument("LT code supports at most 2^32 - 1 source symbols");
+    }
+    if (params.c <= 0.0 || params.delta <= 0.0 || params.delta >= 1.0) {
+        throw std::invalid_argument("LT parameters require c > 0 and 0 < delta < 1");
+    }
+    
+    std::vector<double> mu(k + 1, 0.0);
+    
+    // Ideal soliton
+    mu[1] = 1.0 / static_cast<double>(k);
+    for (size_t d = 2; d <= k; ++d) {
+        mu[d] = 1.0 / (static_cast<double>(d) * static_cast<double>(d - 1));
+    }
+    
+    // Robust component: boosts low degrees and adds a spike at k / R
+    double kd = static_cast<double>(k);
+    double r = params.c * std::log(kd / params.delta) * std::sqrt(kd);
+    if (r > 0.0) {
+        size_t spike = static_cast<size_t>(std::floor(kd / r));
+        spike = std::min(std::max<size_t>(spike, 1), k);
+        for (size_t d = 1; d < spike; ++d) {
+            mu[d] += r / (static_cast<double>(d) * kd);
+        }
+        mu[spike] += r * std::log(r / params.delta) / kd;
+    }
+    
+    double total = 0.0;
+    for (double m : mu) {
+        total += m;
+    }
+    for (double& m : mu) {
+        m /= total;
+    }
+    
+    return mu;
+}
+
+std::vector<size_t> neighbours(uint32_t id, size_t k, uint32_t seed, const Parameters& params) {
+    return neighbours_from_cdf(id, k, seed, soliton_cdf(k, params));
+}
+
+void xor_into(uint8_t* dst, const uint8_t* src, size_t size) {
+    size_t i = 0;
+    // Four independent 64-bit lanes per step; compilers lower this to vector XORs
+    for (; i + 32 <= size; i += 32) {
+        uint64_t a[4], b[4];
+        std::memcpy(a, dst + i, 32);
+        std::memcpy(b, src + i, 32);
+        a[0] ^= b[0];
+        a[1] ^= b[1];
+        a[2] ^= b[2];
+        a[3] ^= b[3];
+        std::memcpy(dst + i, a, 32);
+    }
+    for (; i < size; ++i) {
+        dst[i] ^= src[i];
+    }
+}
+
+std::vector<Packet> encode(
+    const std::vector<std::vector<uint8_t>>& symbols,
+    size_t count,
+    uint32_t seed,
+    const Parameters& params,
+    uint32_t first_id
+) {
+    if (symbols.empty()) {
+        throw std::invalid_argument("LT encode requires at least one source symbol");
+    }
+    size_t symbol_size = symbols[0].size();
+    for (const auto& symbol : symbols) {
+        if (symbol.size() != symbol_size) {
+            throw std::invalid_argument("LT encode requires all symbols to have the same size");
+        }
+    }
+    
+    std::vector<double> cdf = soliton_cdf(symbols.size(), params);
+    
+    std::vector<Packet> packets;
+    packets.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        Packet packet;
+        packet.id = first_id + static_cast<uint32_t>(i);
+        packet.payload.assign(symbol_size, 0);
+        for (size_t s : neighbours_from_cdf(packet.id, symbols.size(), seed, cdf)) {
+            xor_into(packet.payload.data(), symbols[s].data(), symbol_size);
+        }
+        packets.push_back(std::move(packet));
+    }
+    
+    return packets;
+}
+
+DecodeResult decode(
+    const std::vector<Packet>& packets,
+    size_t k,
+    size_t symbol_size,
+    uint32_t seed,
+    const Parameters& params
+) {
+    if (k == 0) {
+        throw std::invalid_argument("LT decode requires at least one source symbol");
+    }
+    
+    std::vector<double> cdf = soliton_cdf(k, params);
+    
+    DecodeResult result;
+    result.symbols.assign(k, std::vector<uint8_t>(symbol_size, 0));
+    std::vector<uint8_t> known(k, 0);
+    size_t known_count = 0;
+    
+    // Working copy of each packet: remaining unknown neighbours and reduced payload
+    std::vector<std::vector<size_t>> edges;
+    std::vector<std::vector<uint8_t>> payloads;
+    std::vector<std::vector<size_t>> symbol_packets(k);
+    std::vector<size_t> ripple;
+    
+    for (const Packet& packet : packets) {
+        if (packet.payload.size() != symbol_size) {
+            throw std::invalid_argument("LT decode requires all payloads to have symbol_size bytes");
+        }
+        size_t index = edges.size();
+        edges.push_back(neighbours_from_cdf(packet.id, k, seed, cdf));
+        payloads.push_back(packet.payload);
+        for (size_t s : edges[index]) {
+            symbol_packets[s].push_back(index);
+        }
+        if (edges[index].size() == 1) {
+            ripple.push_back(index);
+        }
+    }
+    
+    // Peeling decoder: resolve degree-1 packets and substitute the result
+    // into every other packet that references the recovered symbol.
+    while (!ripple.empty() && known_count < k) {
+        size_t index = ripple.back();
+        ripple.pop_back();
+        if (edges[index].size() != 1) {
+            continue;
+        }
+        size_t s = edges[index][0];
+        if (known[s]) {
+            continue;
+        }
+        
+        result.symbols[s] = payloads[index];
+        known[s] = 1;
+        known_count++;
+        result.peeled++;
+        
+        for (size_t other : symbol_packets[s]) {
+            auto& e = edges[other];
+            auto it = std::find(e.begin(), e.end(), s);
+            if (it == e.end()) {
+                continue;
+            }
+            e.erase(it);
+            xor_into(payloads[other].data(), result.symbols[s].data(), symbol_size);
+            if (e.size() == 1) {
+                ripple.push_back(other);
+            }
+        }
+    }
+    
+    if (known_count < k) {
+        // Peeling stalled: solve the residual system by Gaussian elimination over GF(2)
+        std::vector<size_t> column_of(k, 0);
+        std::vector<size_t> unknown;
+        for (size_t s = 0; s < k; ++s) {
+            if (!known[s]) {
+                column_of[s] = unknown.size();
+                unknown.push_back(s);
+            }
+        }
+        
+        size_t words = (unknown.size() + 63) / 64;
+        std::vector<std::vector<uint64_t>> rows;
+        std::vector<size_t> row_packet;
+        for (size_t index = 0; index < edges.size(); ++index) {
+            if (edges[index].empty()) {
+                continue;
+            }
+            std::vector<uint64_t> row(words, 0);
+            for (size_t s : edges[index]) {
+                size_t col = column_of[s];
+                row[col / 64] |= uint64_t{1} << (col % 64);
+            }
+            rows.push_back(std::move(row));
+            row_packet.push_back(index);
+        }
+        
+        std::vector<size_t> pivot_row(unknown.size(), 0);
+        size_t rank = 0;
+        for (size_t col = 0; col < unknown.size() && rank < rows.size(); ++col) {
+            uint64_t bit = uint64_t{1} << (col % 64);
+            size_t w = col / 64;
+            
+            size_t pivot = rank;
+            while (pivot < rows.size() && !(rows[pivot][w] & bit)) {
+                pivot++;
+            }
+            if (pivot == rows.size()) {
+                return result;  // Column not covered: packets do not determine all symbols
+            }
+            std::swap(rows[pivot], rows[rank]);
+            std::swap(row_packet[pivot], row_packet[rank]);
+            
+            for (size_t r = 0; r < rows.size(); ++r) {
+                if (r != rank && (rows[r][w] & bit)) {
+                    for (size_t j = w; j < words; ++j) {
+                        rows[r][j] ^= rows[rank][j];
+                    }
+                    xor_into(payloads[row_packet[r]].data(), payloads[row_packet[rank]].data(), symbol_size);
+                }
+            }
+            pivot_row[col] = rank;
+            rank++;
+        }
+        
+        if (rank < unknown.size()) {
+            return result;
+        }
+        
+        for (size_t col = 0; col < unknown.size(); ++col) {
+            result.symbols[unknown[col]] = payloads[row_packet[pivot_row[col]]];
+            known_count++;
+            result.eliminated++;
+        }
+    }
+    
+    result.success = true;
+    return result;
+}
+
+} // namespace bitshield::codec::lt
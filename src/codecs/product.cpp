@@ -0,0 +1,111 @@
+#include <bitshield/codecs/product.hpp>
+#include <bitshield/codecs/hamming74.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace bitshield::codec::product {
+
+namespace {
+
+constexpr size_t kSide = 7;
+constexpr size_t kCodeBits = kSide * kSide;
+constexpr size_t kDataBits = 16;
+
+// Data bit positions inside a Hamming(7,4) codeword: [p1, p2, d1, p3, d2, d3, d4]
+constexpr size_t kDataPos[4] = {2, 4, 5, 6};
+
+// Encode a 7-bit Hamming codeword in place from its data positions
+void fill_parity(uint8_t* bits, size_t stride) {
+    uint8_t d1 = bits[2 * stride];
+    uint8_t d2 = bits[4 * stride];
+    uint8_t d3 = bits[5 * stride];
+    uint8_t d4 = bits[6 * stride];
+    bits[0] = d1 ^ d2 ^ d4;
+    bits[stride] = d1 ^ d3 ^ d4;
+    bits[3 * stride] = d2 ^ d3 ^ d4;
+}
+
+} // anonymous namespace
+
+void encode_bits(util::ConstBitSpan bits, util::BitSpan encoded) {
+    size_t blocks = (bits.size() + kDataBits - 1) / kDataBits;
+    if (encoded.size() < blocks * kCodeBits) {
+        throw std::invalid_argument("Product code encode output span is too small");
+    }
+    
+    for (size_t b = 0; b < blocks; ++b) {
+        uint8_t* block = encoded.data() + b * kCodeBits;
+        std::fill_n(block, kCodeBits, 0);
+        
+        // Place data bits at their final positions, then fill parity in place
+        for (size_t r = 0; r < 4; ++r) {
+            for (size_t c = 0; c < 4; ++c) {
+                size_t i = b * kDataBits + r * 4 + c;
+                block[kDataPos[r] * kSide + kDataPos[c]] = i < bits.size() ? bits[i] : 0;
+            }
+        }
+        for (size_t r : kDataPos) {
+            fill_parity(block + r * kSide, 1);
+        }
+        for (size_t c = 0; c < kSide; ++c) {
+            fill_parity(block + c, kSide);
+        }
+    }
+}
+
+std::vector<uint8_t> encode_bits(util::ConstBitSpan bits) {
+    std::vector<uint8_t> encoded((bits.size() + kDataBits - 1) / kDataBits * kCodeBits);
+    encode_bits(bits, encoded);
+    return encoded;
+}
+
+void decode_bits(util::ConstBitSpan encoded, util::BitSpan decoded, int max_iterations) {
+    if (encoded.size() % kCodeBits != 0) {
+        throw std::invalid_argument("Product code decode requires input size to be a multiple of 49");
+    }
+    if (max_iterations <= 0) {
+        throw std::invalid_argument("Product code decode requires max_iterations > 0");
+    }
+    if (decoded.size() < encoded.size() / kCodeBits * kDataBits) {
+        throw std::invalid_argument("Product code decode output span is too small");
+    }
+    
+    for (size_t b = 0; b < encoded.size() / kCodeBits; ++b) {
+        // Rows and columns are strided views over one working copy of the block
+        uint8_t block[kCodeBits];
+        std::copy(encoded.begin() + b * kCodeBits, encoded.begin() + (b + 1) * kCodeBits, block);
+        
+        for (int iter = 0; iter < max_iterations; ++iter) {
+            bool changed = false;
+            for (size_t r = 0; r < kSide; ++r) {
+                changed |= hamming74::correct(block + r * kSide, 1);
+            }
+            for (size_t c = 0; c < kSide; ++c) {
+                changed |= hamming74::correct(block + c, kSide);
+            }
+            if (!changed) {
+                break;
+            }
+        }
+        
+        for (size_t r = 0; r < 4; ++r) {
+            for (size_t c = 0; c < 4; ++c) {
+                decoded[b * kDataBits + r * 4 + c] = block[kDataPos[r] * kSide + kDataPos[c]];
+            }
+        }
+    }
+}
+
+std::vector<uint8_t> decode_bits(util::ConstBitSpan encoded, int max_iterations) {
+    if (encoded.size() % kCodeBits != 0) {
+        throw std::invalid_argument("Product code decode requires input size to be a multiple of 49");
+    }
+    std::vector<uint8_t> decoded(encoded.size() / kCodeBits * kDataBits);
+    decode_bits(encoded, decoded, max_iterations);
+    return decoded;
+}
+
+} // namespace bitshield::codec::product
@@ -1,53 +1,154 @@
 #include <bitshield/codecs/repetition.hpp>
+#include <algorithm>
 #include <stdexcept>
 #include <vector>
 #include <cstdint>
 
 namespace bitshield::codec::repetition {
 
-std::vector<uint8_t> encode(const std::vector<uint8_t>& bits, int n) {
+void encode(util::ConstBitSpan bits, util::BitSpan encoded, int n) {
     if (n <= 0) {
         throw std::invalid_argument("Repetition factor n must be > 0");
     }
-    
-    std::vector<uint8_t> encoded;
-    encoded.reserve(bits.size() * n);
-    
-    for (uint8_t bit : bits) {
-        for (int i = 0; i < n; ++i) {
-            encoded.push_back(bit);
-        }
+    size_t group = static_cast<size_t>(n);
+    if (encoded.size() / group < bits.size()) {
+        throw std::invalid_argument("Repetition encode output span is too small");
     }
     
+    for (size_t i = 0; i < bits.size(); ++i) {
+        std::fill_n(encoded.data() + i * group, group, bits[i]);
+    }
+}
+
+std::vector<uint8_t> encode(util::ConstBitSpan bits, int n) {
+    if (n <= 0) {
+        throw std::invalid_argument("Repetition factor n must be > 0");
+    }
+    std::vector<uint8_t> encoded(bits.size() * static_cast<size_t>(n));
+    encode(bits, encoded, n);
     return encoded;
 }
 
-std::vector<uint8_t> decode(const std::vector<uint8_t>& encoded, int n) {
+void decode(util::ConstBitSpan encoded, util::BitSpan decoded, int n) {
     if (n <= 0) {
         throw std::invalid_argument("Repetition factor n must be > 0");
     }
+    size_t group = static_cast<size_t>(n);
+    size_t groups = (encoded.size() + group - 1) / group;
+    if (decoded.size() < groups) {
+        throw std::invalid_argument("Repetition decode output span is too small");
+    }
     
-    std::vector<uint8_t> decoded;
-    decoded.reserve((encoded.size() + n - 1) / n);
-    
-    for (size_t i = 0; i < encoded.size(); i += n) {
-        int count0 = 0, count1 = 0;
-        
-        // Count bits in this group
-        for (int j = 0; j < n && (i + j) < encoded.size(); ++j) {
-            if (encoded[i + j] == 1) {
-                count1++;
-            } else {
-                count0++;
-            }
-        }
+    for (size_t g = 0; g < groups; ++g) {
+        size_t begin = g * group;
+        size_t end = begin + group < encoded.size() ? begin + group : encoded.size();
         
         // Majority vote
-        decoded.push_back(count1 > count0 ? 1 : 0);
+        size_t ones = 0;
+        for (size_t i = begin; i < end; ++i) {
+            ones += encoded[i] == 1;
+        }
+        decoded[g] = 2 * ones > end - begin ? 1 : 0;
+    }
+}
+
+std::vector<uint8_t> decode(util::ConstBitSpan encoded, int n) {
+    if (n <= 0) {
+        throw std::invalid_argument("Repetition factor n must be > 0");
+    }
+    size_t group = static_cast<size_t>(n);
+    std::vector<uint8_t> decoded((encoded.size() + group - 1) / group);
+    decode(encoded, decoded, n);
+    return decoded;
+}
+
+void decode_erasures(util::ConstBitSpan encoded, util::PackedBitSpan erasures, util::BitSpan decoded, int n) {
+    if (n <= 0) {
+        throw std::invalid_argument("Repetition factor n must be > 0");
+    }
+    if (erasures.size() < encoded.size()) {
+        throw std::invalid_argument("Erasure mask is shorter than the encoded bit vector");
+    }
+    size_t group = static_cast<size_t>(n);
+    size_t groups = (encoded.size() + group - 1) / group;
+    if (decoded.size() < groups) {
+        throw std::invalid_argument("Repetition decode output span is too small");
+    }
+    
+    for (size_t g = 0; g < groups; ++g) {
+        size_t begin = g * group;
+        size_t end = begin + group < encoded.size() ? begin + group : encoded.size();
+        // Each non-erased copy votes +1 for a 1 and -1 for a 0; erased copies abstain
+        int vote = 0;
+        for (size_t i = begin; i < end; ++i) {
+            int present = erasures[i] ^ 1;
+            vote += present * (2 * (encoded[i] & 1) - 1);
+        }
+        decoded[g] = vote > 0 ? 1 : 0;
+    }
+}
+
+std::vector<uint8_t> decode_erasures(util::ConstBitSpan encoded, util::PackedBitSpan erasures, int n) {
+    if (n <= 0) {
+        throw std::invalid_argument("Repetition factor n must be > 0");
+    }
+    size_t group = static_cast<size_t>(n);
+    std::vector<uint8_t> decoded((encoded.size() + group - 1) / group);
+    decode_erasures(encoded, erasures, decoded, n);
+    return decoded;
+}
+
+namespace {
+
+template <typename Llr, typename Acc>
+void decode_soft_impl(util::ConstSpan<Llr> llrs, util::BitSpan decoded, int n) {
+    if (n <= 0) {
+        throw std::invalid_argument("Repetition factor n must be > 0");
+    }
+    size_t group = static_cast<size_t>(n);
+    size_t groups = (llrs.size() + group - 1) / group;
+    if (decoded.size() < groups) {
+        throw std::invalid_argument("Repetition decode output span is too small");
     }
     
+    for (size_t g = 0; g < groups; ++g) {
+        size_t begin = g * group;
+        size_t end = begin + group < llrs.size() ? begin + group : llrs.size();
+        Acc sum = 0;
+        for (size_t i = begin; i < end; ++i) {
+            sum += llrs[i];
+        }
+        decoded[g] = sum < 0 ? 1 : 0;
+    }
+}
+
+template <typename Llr, typename Acc>
+std::vector<uint8_t> decode_soft_impl(util::ConstSpan<Llr> llrs, int n) {
+    if (n <= 0) {
+        throw std::invalid_argument("Repetition factor n must be > 0");
+    }
+    size_t group = static_cast<size_t>(n);
+    std::vector<uint8_t> decoded((llrs.size() + group - 1) / group);
+    decode_soft_impl<Llr, Acc>(llrs, decoded, n);
     return decoded;
 }
 
-} // namespace bitshield::codec::repetition
+} // anonymous namespace
+
+std::vector<uint8_t> decode_soft(util::ConstSpan<float> llrs, int n) {
+    return decode_soft_impl<float, float>(llrs, n);
+}
 
+std::vector<uint8_t> decode_soft(util::ConstSpan<int8_t> llrs, int n) {
+    return decode_soft_impl<int8_t, int32_t>(llrs, n);
+}
+
+void decode_soft(util::ConstSpan<float> llrs, util::BitSpan decoded, int n) {
+    decode_soft_impl<float, float>(llrs, decoded, n);
+}
+
+void decode_soft(util::ConstSpan<int8_t> llrs, util::BitSpan decoded, int n) {
+    decode_soft_impl<int8_t, int32_t>(llrs, decoded, n);
+}
+
+} // namespace bitshield::codec::repetition
@@ -0,0 +1,481 @@
+#include <bitshield/container.hpp>
+#include <bitshield/bitstream.hpp>
+#include <bitshield/crc.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace bitshield::io {
+
+namespace {
+
+constexpr uint8_t kMagic[4] = {'B', 'S', 'H', '1'};
+constexpr uint8_t kFooterMagic[4] = {'B', 'S', 'H', 'X'};
+
+// Magic, version and header size; then the fixed fields up to the chunk size
+constexpr size_t kHeaderPrefix = 4 + 2 + 2;
+constexpr size_t kHeaderFixed = kHeaderPrefix + 8 + 4;
+constexpr size_t kFooterSize = 8 + 8 + 8 + 4 + 4;
+constexpr size_t kIndexEntrySize = 8 + 4 + 4;
+
+uint32_t crc32c(const uint8_t* data, size_t size) {
+    return static_cast<uint32_t>(crc::compute(crc::Algorithm::crc32c, data, size));
+}
+
+void put(std::vector<uint8_t>& out, uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void put_string(std::vector<uint8_t>& out, const std::string& s) {
+    if (s.size() > 0xFFFF) {
+        throw std::invalid_argument("Container strings are limited to 65535 bytes");
+    }
+    put(out, s.size(), 2);
+    out.insert(out.end(), s.begin(), s.end());
+}
+
+uint64_t get(const uint8_t* data, size_t bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(data[i]) << (8 * i);
+    }
+    return value;
+}
+
+[[noreturn]] void corrupt(const std::string& what) {
+    throw std::runtime_error("Invalid bsh container: " + what);
+}
+
+// Bounds-checked little-endian reader over the header
+class HeaderCursor {
+public:
+    HeaderCursor(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+    
+    uint64_t take(size_t bytes) {
+        need(bytes);
+        uint64_t value = get(data_ + pos_, bytes);
+        pos_ += bytes;
+        return value;
+    }
+    
+    std::string take_string() {
+        size_t length = static_cast<size_t>(take(2));
+        need(length);
+        std::string s(reinterpret_cast<const char*>(data_ + pos_), length);
+        pos_ += length;
+        return s;
+    }
+    
+private:
+    void need(size_t bytes) const {
+        if (size_ - pos_ < bytes) {
+            corrupt("truncated header");
+        }
+    }
+    
+    const uint8_t* data_;
+    size_t size_;
+    size_t pos_ = 0;
+};
+
+// Size of the whole header from its prefix; validates magic and version
+size_t header_size(const uint8_t* prefix, size_t available, const std::string& source) {
+    if (available < kHeaderPrefix || std::memcmp(prefix, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not a bsh container: " + source);
+    }
+    uint16_t version = static_cast<uint16_t>(get(prefix + 4, 2));
+    if (version != kContainerVersion) {
+        throw std::runtime_error("Unsupported bsh container version " + std::to_string(version));
+    }
+    size_t size = static_cast<size_t>(get(prefix + 6, 2));
+    if (size < kHeaderFixed + 4) {
+        corrupt("truncated header");
+    }
+    return size;
+}
+
+// Parse a whole header (size bytes, CRC included)
+ContainerHeader parse_header(const uint8_t* data, size_t size) {
+    if (crc32c(data, size - 4) != get(data + size - 4, 4)) {
+        corrupt("header CRC mismatch");
+    }
+    
+    // Fields are read within the CRC-checked header only
+    ContainerHeader header;
+    HeaderCursor fields(data, size - 4);
+    fields.take(4);
+    header.version = static_cast<uint16_t>(fields.take(2));
+    fields.take(2);
+    header.payload_bits = fields.take(8);
+    header.chunk_bytes = static_cast<uint32_t>(fields.take(4));
+    header.codec = fields.take_string();
+    size_t count = static_cast<size_t>(fields.take(2));
+    for (size_t i = 0; i < count; ++i) {
+        std::string key = fields.take_string();
+        header.parameters.emplace_back(std::move(key), fields.take_string());
+    }
+    if (header.chunk_bytes == 0) {
+        corrupt("chunk size is 0");
+    }
+    return header;
+}
+
+// Payload length from the footer, cross-checked against the header and the chunk sizes
+uint64_t check_length(const ContainerHeader& header, uint64_t footer_bits, uint64_t payload_bytes) {
+    // The writer always records the actual length in the footer
+    if (footer_bits == kContainerUnknownLength) {
+        corrupt("footer payload length is unknown");
+    }
+    if (header.payload_bits != kContainerUnknownLength && header.payload_bits != footer_bits) {
+        corrupt("header and footer payload lengths differ");
+    }
+    // Written so lengths near 2^64 cannot wrap
+    if (footer_bits / 8 + (footer_bits % 8 != 0) != payload_bytes) {
+        corrupt("payload length does not match the chunk sizes");
+    }
+    return footer_bits;
+}
+
+} // anonymous namespace
+
+ContainerWriter::ContainerWriter(
+    const std::string& path,
+    const std::string& codec,
+    const std::vector<std::pair<std::string, std::string>>& parameters,
+    uint32_t chunk_bytes,
+    uint64_t payload_bits
+) : file_(path), chunk_bytes_(chunk_bytes), expected_bits_(payload_bits) {
+    if (chunk_bytes == 0) {
+        throw std::invalid_argument("Container chunk size must be > 0");
+    }
+    
+    std::vector<uint8_t> header(kMagic, kMagic + 4);
+    put(header, kContainerVersion, 2);
+    put(header, 0, 2);  // Header size, patched below
+    put(header, payload_bits, 8);
+    put(header, chunk_bytes, 4);
+    put_string(header, codec);
+    if (parameters.size() > 0xFFFF) {
+        throw std::invalid_argument("Container headers are limited to 65535 codec parameters");
+    }
+    put(header, parameters.size(), 2);
+    for (const auto& [key, value] : parameters) {
+        put_string(header, key);
+        put_string(header, value);
+    }
+    size_t size = header.size() + 4;
+    if (size > 0xFFFF) {
+        throw std::invalid_argument("Container header exceeds 65535 bytes");
+    }
+    header[6] = static_cast<uint8_t>(size);
+    header[7] = static_cast<uint8_t>(size >> 8);
+    put(header, crc32c(header.data(), header.size()), 4);
+    
+    file_.write(header.data(), header.size());
+    offset_ = header.size();
+    chunk_.reserve(chunk_bytes);
+}
+
+void ContainerWriter::write(const std::vector<uint8_t>& bits) {
+    size_t i = 0;
+    // Complete the partial byte, then pack whole bytes
+    for (; i < bits.size() && bits_ % 8 != 0; ++i, ++bits_) {
+        partial_ |= static_cast<unsigned>(bits[i] & 1) << (7 - bits_ % 8);
+        if (bits_ % 8 == 7) {
+            chunk_.push_back(static_cast<uint8_t>(partial_));
+            partial_ = 0;
+            if (chunk_.size() == chunk_bytes_) {
+                flush_chunk();
+            }
+        }
+    }
+    while (i + 8 <= bits.size()) {
+        size_t used = chunk_.size();
+        size_t count = std::min<size_t>((bits.size() - i) / 8, chunk_bytes_ - used);
+        chunk_.resize(used + count);
+        util::bits_to_bytes(bits.data() + i, count * 8, chunk_.data() + used);
+        i += count * 8;
+        bits_ += count * 8;
+        if (chunk_.size() == chunk_bytes_) {
+            flush_chunk();
+        }
+    }
+    for (; i < bits.size(); ++i, ++bits_) {
+        partial_ |= static_cast<unsigned>(bits[i] & 1) << (7 - bits_ % 8);
+    }
+}
+
+void ContainerWriter::flush_chunk() {
+    uint32_t crc = crc32c(chunk_.data(), chunk_.size());
+    std::vector<uint8_t> field;
+    put(field, chunk_.size(), 4);
+    file_.write(field.data(), field.size());
+    file_.write(chunk_.data(), chunk_.size());
+    field.clear();
+    put(field, crc, 4);
+    file_.write(field.data(), field.size());
+    
+    put(index_, offset_ + 4, 8);
+    put(index_, chunk_.size(), 4);
+    put(index_, crc, 4);
+    offset_ += chunk_.size() + 8;
+    chunk_.clear();
+}
+
+void ContainerWriter::finish() {
+    if (expected_bits_ != kContainerUnknownLength && expected_bits_ != bits_) {
+        throw std::invalid_argument("Container payload length differs from the announced length");
+    }
+    if (bits_ % 8 != 0) {
+        chunk_.push_back(static_cast<uint8_t>(partial_));
+        partial_ = 0;
+    }
+    if (!chunk_.empty()) {
+        flush_chunk();
+    }
+    
+    std::vector<uint8_t> trailer;
+    put(trailer, 0, 4);  // Terminator record
+    uint64_t index_offset = offset_ + 4;
+    trailer.insert(trailer.end(), index_.begin(), index_.end());
+    put(trailer, index_offset, 8);
+    put(trailer, index_.size() / kIndexEntrySize, 8);
+    put(trailer, bits_, 8);
+    put(trailer, crc32c(index_.data(), index_.size()), 4);
+    trailer.insert(trailer.end(), kFooterMagic, kFooterMagic + 4);
+    file_.write(trailer.data(), trailer.size());
+    file_.flush();
+}
+
+void write_container(
+    const std::string& path,
+    const std::vector<uint8_t>& bits,
+    const std::string& codec,
+    const std::vector<std::pair<std::string, std::string>>& parameters,
+    uint32_t chunk_bytes
+) {
+    ContainerWriter writer(path, codec, parameters, chunk_bytes, bits.size());
+    writer.write(bits);
+    writer.finish();
+}
+
+bool is_container(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[4];
+    return file.read(magic, sizeof(magic)) && std::memcmp(magic, kMagic, sizeof(magic)) == 0;
+}
+
+bool is_container(InputFile& file) {
+    uint8_t magic[4];
+    return file.peek(magic, sizeof(magic)) == sizeof(magic) && std::memcmp(magic, kMagic, sizeof(magic)) == 0;
+}
+
+ContainerReader::ContainerReader(const std::string& path) : file_(path) {
+    const uint8_t* data = file_.data();
+    size_t size = file_.size();
+    size_t header_end = header_size(data, size, path);
+    if (header_end > size) {
+        corrupt("truncated header");
+    }
+    header_ = parse_header(data, header_end);
+    
+    if (size - header_end < kFooterSize + 4
+        || std::memcmp(data + size - 4, kFooterMagic, sizeof(kFooterMagic)) != 0) {
+        corrupt("missing footer");
+    }
+    const uint8_t* footer = data + size - kFooterSize;
+    uint64_t index_offset = get(footer, 8);
+    uint64_t chunks = get(footer + 8, 8);
+    uint64_t footer_bits = get(footer + 16, 8);
+    uint64_t index_end = size - kFooterSize;
+    if (index_offset < header_end + 4 || index_offset > index_end
+        || (index_end - index_offset) % kIndexEntrySize != 0
+        || chunks != (index_end - index_offset) / kIndexEntrySize) {
+        corrupt("corrupt footer");
+    }
+    if (crc32c(data + index_offset, chunks * kIndexEntrySize) != get(footer + 24, 4)) {
+        corrupt("index CRC mismatch");
+    }
+    
+    // Chunk records must tile the file from the header to the terminator
+    index_.resize(chunks);
+    uint64_t expected_offset = header_end + 4;
+    uint64_t payload_bytes = 0;
+    for (size_t i = 0; i < chunks; ++i) {
+        const uint8_t* entry = data + index_offset + i * kIndexEntrySize;
+        IndexEntry& e = index_[i];
+        e.offset = get(entry, 8);
+        e.size = static_cast<uint32_t>(get(entry + 8, 4));
+        e.crc = static_cast<uint32_t>(get(entry + 12, 4));
+        bool full = e.size == header_.chunk_bytes;
+        if (e.offset != expected_offset || e.size == 0 || (!full && i + 1 < chunks)
+            || e.size > header_.chunk_bytes || index_offset - 4 - e.offset < uint64_t{e.size} + 4
+            || get(data + e.offset - 4, 4) != e.size) {
+            corrupt("corrupt index entry " + std::to_string(i));
+        }
+        expected_offset += uint64_t{e.size} + 8;
+        payload_bytes += e.size;
+    }
+    if (expected_offset != index_offset || get(data + index_offset - 4, 4) != 0) {
+        corrupt("missing payload terminator");
+    }
+    header_.payload_bits = check_length(header_, footer_bits, payload_bytes);
+}
+
+const uint8_t* ContainerReader::chunk(size_t i) const {
+    const IndexEntry& e = index_[i];
+    const uint8_t* data = file_.data() + e.offset;
+    if (crc32c(data, e.size) != e.crc || get(data + e.size, 4) != e.crc) {
+        corrupt("CRC mismatch in chunk " + std::to_string(i));
+    }
+    count_bytes(file_.is_mapped() ? ByteMove::mapped_in : ByteMove::copied_in, e.size);
+    return data;
+}
+
+std::vector<uint8_t> ContainerReader::read_bits(uint64_t first, uint64_t count) const {
+    std::vector<uint8_t> bits;
+    read_bits(first, count, bits);
+    return bits;
+}
+
+void ContainerReader::read_bits(uint64_t first, uint64_t count, std::vector<uint8_t>& bits) const {
+    if (first > header_.payload_bits || count > header_.payload_bits - first) {
+        throw std::invalid_argument("Bit range passes the end of the container payload");
+    }
+    bits.resize(static_cast<size_t>(count));
+    read_bits(first, count, util::BitSpan(bits));
+}
+
+void ContainerReader::read_bits(uint64_t first, uint64_t count, util::BitSpan bits) const {
+    if (first > header_.payload_bits || count > header_.payload_bits - first) {
+        throw std::invalid_argument("Bit range passes the end of the container payload");
+    }
+    if (bits.size() < count) {
+        throw std::invalid_argument("Bit span is too small for the requested range");
+    }
+    
+    uint64_t chunk_bits = static_cast<uint64_t>(header_.chunk_bytes) * 8;
+    uint64_t pos = first;
+    uint64_t end = first + count;
+    while (pos < end) {
+        size_t i = static_cast<size_t>(pos / chunk_bits);
+        uint64_t base = i * chunk_bits;
+        uint64_t stop = end < base + chunk_bits ? end : base + chunk_bits;
+        util::PackedBitSpan(chunk(i), pos - base, static_cast<size_t>(stop - pos))
+            .unpack(bits.subspan(static_cast<size_t>(pos - first)));
+        pos = stop;
+    }
+}
+
+std::vector<uint8_t> ContainerReader::read_all() const {
+    return read_bits(0, header_.payload_bits);
+}
+
+ContainerStreamReader::ContainerStreamReader(InputFile& file) : file_(file) {
+    std::vector<uint8_t> header(kHeaderPrefix);
+    size_t got = file_.read(header.data(), header.size());
+    size_t size = header_size(header.data(), got, "input stream");
+    header.resize(size);
+    if (file_.read(header.data() + kHeaderPrefix, size - kHeaderPrefix) != size - kHeaderPrefix) {
+        corrupt("truncated header");
+    }
+    header_ = parse_header(header.data(), size);
+    offset_ = size;
+}
+
+bool ContainerStreamReader::read_record(std::vector<uint8_t>& bytes) {
+    uint8_t field[4];
+    if (file_.read(field, 4) != 4) {
+        corrupt("truncated payload");
+    }
+    uint32_t size = static_cast<uint32_t>(get(field, 4));
+    if (size == 0) {
+        offset_ += 4;
+        return false;
+    }
+    if (size > header_.chunk_bytes) {
+        corrupt("chunk larger than the chunk size");
+    }
+    bytes.resize(size + 4);
+    if (file_.read(bytes.data(), bytes.size()) != bytes.size()) {
+        corrupt("truncated payload");
+    }
+    uint32_t crc = crc32c(bytes.data(), size);
+    size_t chunk = index_.size() / kIndexEntrySize;
+    if (crc != get(bytes.data() + size, 4)) {
+        corrupt("CRC mismatch in chunk " + std::to_string(chunk));
+    }
+    put(index_, offset_ + 4, 8);
+    put(index_, size, 4);
+    put(index_, crc, 4);
+    offset_ += uint64_t{size} + 8;
+    bytes.resize(size);
+    return true;
+}
+
+void ContainerStreamReader::read_trailer() {
+    std::vector<uint8_t> trailer(index_.size() + kFooterSize);
+    if (file_.read(trailer.data(), trailer.size()) != trailer.size()) {
+        corrupt("truncated index");
+    }
+    const uint8_t* footer = trailer.data() + index_.size();
+    if (std::memcmp(footer + kFooterSize - 4, kFooterMagic, sizeof(kFooterMagic)) != 0
+        || get(footer, 8) != offset_ || get(footer + 8, 8) != index_.size() / kIndexEntrySize) {
+        corrupt("corrupt footer");
+    }
+    if (crc32c(trailer.data(), index_.size()) != get(footer + 24, 4)) {
+        corrupt("index CRC mismatch");
+    }
+    if (std::memcmp(trailer.data(), index_.data(), index_.size()) != 0) {
+        corrupt("index does not match the chunks");
+    }
+    uint64_t payload_bytes = 0;
+    for (size_t i = 0; i < index_.size(); i += kIndexEntrySize) {
+        payload_bytes += get(index_.data() + i + 8, 4);
+    }
+    header_.payload_bits = check_length(header_, get(footer + 16, 8), payload_bytes);
+}
+
+bool ContainerStreamReader::next(std::vector<uint8_t>& bits) {
+    if (done_) {
+        bits.clear();
+        return false;
+    }
+    
+    if (!have_held_) {
+        if (!read_record(held_)) {
+            read_trailer();
+            done_ = true;
+            bits.clear();
+            return false;
+        }
+        have_held_ = true;
+    }
+    
+    // A chunk is final when the record after it is the terminator; only then
+    // is the payload length (and so the padding of its last byte) known
+    bool more = read_record(following_);
+    if (more && held_.size() != header_.chunk_bytes) {
+        corrupt("short chunk before the end of the payload");
+    }
+    uint64_t count = uint64_t{held_.size()} * 8;
+    if (!more) {
+        read_trailer();
+        done_ = true;
+        count = header_.payload_bits - emitted_bits_;
+    }
+    bits.resize(static_cast<size_t>(count));
+    util::PackedBitSpan(held_.data(), 0, static_cast<size_t>(count)).unpack(bits);
+    emitted_bits_ += count;
+    held_.swap(following_);
+    have_held_ = more;
+    return true;
+}
+
+} // namespace bitshield::io
@@ -0,0 +1,312 @@
+#include <bitshield/crc.hpp>
+#include <bitshield/bitstream.hpp>
+#include <stdexcept>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define BITSHIELD_CRC_PCLMUL 1
+#include <immintrin.h>
+#endif
+
+namespace bitshield::crc {
+
+namespace {
+
+const Parameters kParameters[] = {
+    {8, 0x07, 0x00, false, 0x00, 0xF4},
+    {16, 0x1021, 0xFFFF, false, 0x0000, 0x29B1},
+    {32, 0x04C11DB7, 0xFFFFFFFF, true, 0xFFFFFFFF, 0xCBF43926},
+    {32, 0x1EDC6F41, 0xFFFFFFFF, true, 0xFFFFFFFF, 0xE3069283},
+    {64, 0x42F0E1EBA9EA3693ULL, ~0ULL, true, ~0ULL, 0x995DC9BBDF1939FAULL},
+};
+
+uint64_t reflect(uint64_t value, int width) {
+    uint64_t out = 0;
+    for (int i = 0; i < width; ++i) {
+        out = (out << 1) | ((value >> i) & 1);
+    }
+    return out;
+}
+
+// Internal register layout: reflected CRCs are kept right-aligned with the
+// reflected polynomial, normal CRCs left-aligned in 64 bits so that every
+// width shares the same shift-out-of-the-top logic.
+struct Engine {
+    const Parameters* params;
+    uint64_t poly;
+    uint64_t table[8][256];
+    
+    uint64_t step_bit(uint64_t reg) const {
+        if (params->reflected) {
+            return (reg >> 1) ^ ((reg & 1) ? poly : 0);
+        }
+        return (reg << 1) ^ ((reg >> 63) ? poly : 0);
+    }
+    
+    uint64_t init() const {
+        return params->reflected ? params->init : params->init << (64 - params->width);
+    }
+    
+    uint64_t finalize(uint64_t reg) const {
+        if (params->reflected) {
+            return reg ^ params->xorout;
+        }
+        return (reg >> (64 - params->width)) ^ params->xorout;
+    }
+};
+
+Engine build_engine(Algorithm algo) {
+    Engine e{};
+    e.params = &kParameters[static_cast<int>(algo)];
+    int width = e.params->width;
+    e.poly = e.params->reflected ? reflect(e.params->poly, width) : e.params->poly << (64 - width);
+    
+    for (uint64_t b = 0; b < 256; ++b) {
+        uint64_t reg = e.params->reflected ? b : b << 56;
+        for (int i = 0; i < 8; ++i) {
+            reg = e.step_bit(reg);
+        }
+        e.table[0][b] = reg;
+    }
+    for (int k = 1; k < 8; ++k) {
+        for (int b = 0; b < 256; ++b) {
+            uint64_t prev = e.table[k - 1][b];
+            if (e.params->reflected) {
+                e.table[k][b] = (prev >> 8) ^ e.table[0][prev & 0xFF];
+            } else {
+                e.table[k][b] = (prev << 8) ^ e.table[0][prev >> 56];
+            }
+        }
+    }
+    return e;
+}
+
+const Engine& engine(Algorithm algo) {
+    // Tables are built once on first use and never modified afterwards
+    static const Engine engines[] = {
+        build_engine(Algorithm::crc8),
+        build_engine(Algorithm::crc16),
+        build_engine(Algorithm::crc32),
+        build_engine(Algorithm::crc32c),
+        build_engine(Algorithm::crc64),
+    };
+    return engines[static_cast<int>(algo)];
+}
+
+uint64_t load_le64(const uint8_t* p) {
+    return static_cast<uint64_t>(p[0]) | static_cast<uint64_t>(p[1]) << 8 |
+           static_cast<uint64_t>(p[2]) << 16 | static_cast<uint64_t>(p[3]) << 24 |
+           static_cast<uint64_t>(p[4]) << 32 | static_cast<uint64_t>(p[5]) << 40 |
+           static_cast<uint64_t>(p[6]) << 48 | static_cast<uint64_t>(p[7]) << 56;
+}
+
+uint64_t load_be64(const uint8_t* p) {
+    return static_cast<uint64_t>(p[7]) | static_cast<uint64_t>(p[6]) << 8 |
+           static_cast<uint64_t>(p[5]) << 16 | static_cast<uint64_t>(p[4]) << 24 |
+           static_cast<uint64_t>(p[3]) << 32 | static_cast<uint64_t>(p[2]) << 40 |
+           static_cast<uint64_t>(p[1]) << 48 | static_cast<uint64_t>(p[0]) << 56;
+}
+
+uint64_t update_bitwise(const Engine& e, uint64_t reg, const uint8_t* p, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        reg ^= e.params->reflected ? p[i] : static_cast<uint64_t>(p[i]) << 56;
+        for (int j = 0; j < 8; ++j) {
+            reg = e.step_bit(reg);
+        }
+    }
+    return reg;
+}
+
+uint64_t update_slicing8(const Engine& e, uint64_t reg, const uint8_t* p, size_t n) {
+    const auto& t = e.table;
+    if (e.params->reflected) {
+        for (; n >= 8; p += 8, n -= 8) {
+            reg ^= load_le64(p);
+            reg = t[7][reg & 0xFF] ^ t[6][(reg >> 8) & 0xFF] ^
+                  t[5][(reg >> 16) & 0xFF] ^ t[4][(reg >> 24) & 0xFF] ^
+                  t[3][(reg >> 32) & 0xFF] ^ t[2][(reg >> 40) & 0xFF] ^
+                  t[1][(reg >> 48) & 0xFF] ^ t[0][reg >> 56];
+        }
+        for (; n > 0; ++p, --n) {
+            reg = (reg >> 8) ^ t[0][(reg ^ *p) & 0xFF];
+        }
+    } else {
+        for (; n >= 8; p += 8, n -= 8) {
+            reg ^= load_be64(p);
+            reg = t[7][reg >> 56] ^ t[6][(reg >> 48) & 0xFF] ^
+                  t[5][(reg >> 40) & 0xFF] ^ t[4][(reg >> 32) & 0xFF] ^
+                  t[3][(reg >> 24) & 0xFF] ^ t[2][(reg >> 16) & 0xFF] ^
+                  t[1][(reg >> 8) & 0xFF] ^ t[0][reg & 0xFF];
+        }
+        for (; n > 0; ++p, --n) {
+            reg = (reg << 8) ^ t[0][(reg >> 56) ^ *p];
+        }
+    }
+    return reg;
+}
+
+#ifdef BITSHIELD_CRC_PCLMUL
+
+// Folding constant for a reflected 32-bit CRC: reflect(x^n mod P) << 1
+uint64_t fold_constant(uint64_t poly, int n) {
+    uint64_t r = 1;
+    for (int i = 0; i < n; ++i) {
+        r <<= 1;
+        if (r & 0x100000000ULL) {
+            r ^= poly | 0x100000000ULL;
+        }
+    }
+    return reflect(r, 32) << 1;
+}
+
+struct FoldConstants {
+    uint64_t k1, k2, k3, k4;
+};
+
+FoldConstants make_fold_constants(uint64_t poly) {
+    return {fold_constant(poly, 4 * 128 + 32), fold_constant(poly, 4 * 128 - 32),
+            fold_constant(poly, 128 + 32), fold_constant(poly, 128 - 32)};
+}
+
+const FoldConstants& fold_constants(Algorithm algo) {
+    static const FoldConstants crc32 = make_fold_constants(kParameters[2].poly);
+    static const FoldConstants crc32c = make_fold_constants(kParameters[3].poly);
+    return algo == Algorithm::crc32 ? crc32 : crc32c;
+}
+
+__attribute__((target("pclmul,sse2")))
+inline __m128i fold(__m128i x, __m128i k) {
+    return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), _mm_clmulepi64_si128(x, k, 0x11));
+}
+
+// Fold 64 bytes per step across four 128-bit lanes, reduce to one lane, then
+// finish the remaining 16 bytes and tail with the table kernel.
+__attribute__((target("pclmul,sse2")))
+uint64_t update_pclmul(const Engine& e, const FoldConstants& c, uint64_t reg, const uint8_t* p, size_t n) {
+    if (n < 64) {
+        return update_slicing8(e, reg, p, n);
+    }
+    
+    auto load = [](const uint8_t* q) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(q)); };
+    
+    __m128i x0 = _mm_xor_si128(load(p), _mm_cvtsi32_si128(static_cast<int>(reg)));
+    __m128i x1 = load(p + 16);
+    __m128i x2 = load(p + 32);
+    __m128i x3 = load(p + 48);
+    p += 64;
+    n -= 64;
+    
+    const __m128i k12 = _mm_set_epi64x(static_cast<long long>(c.k2), static_cast<long long>(c.k1));
+    const __m128i k34 = _mm_set_epi64x(static_cast<long long>(c.k4), static_cast<long long>(c.k3));
+    
+    for (; n >= 64; p += 64, n -= 64) {
+        x0 = _mm_xor_si128(fold(x0, k12), load(p));
+        x1 = _mm_xor_si128(fold(x1, k12), load(p + 16));
+        x2 = _mm_xor_si128(fold(x2, k12), load(p + 32));
+        x3 = _mm_xor_si128(fold(x3, k12), load(p + 48));
+    }
+    
+    __m128i x = _mm_xor_si128(fold(x0, k34), x1);
+    x = _mm_xor_si128(fold(x, k34), x2);
+    x = _mm_xor_si128(fold(x, k34), x3);
+    for (; n >= 16; p += 16, n -= 16) {
+        x = _mm_xor_si128(fold(x, k34), load(p));
+    }
+    
+    // The folded lane is congruent to the message so far with a zero register
+    uint8_t lane[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lane), x);
+    reg = update_slicing8(e, 0, lane, sizeof(lane));
+    return update_slicing8(e, reg, p, n);
+}
+
+bool cpu_has_pclmul() {
+    static const bool has = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse2");
+    return has;
+}
+
+#endif
+
+uint64_t update(Algorithm algo, Implementation impl, uint64_t reg, const uint8_t* p, size_t n) {
+    const Engine& e = engine(algo);
+    switch (impl) {
+        case Implementation::bitwise:
+            return update_bitwise(e, reg, p, n);
+        case Implementation::slicing8:
+            return update_slicing8(e, reg, p, n);
+        case Implementation::pclmul:
+#ifdef BITSHIELD_CRC_PCLMUL
+            return update_pclmul(e, fold_constants(algo), reg, p, n);
+#else
+            break;
+#endif
+    }
+    throw std::invalid_argument("CRC implementation not available");
+}
+
+} // anonymous namespace
+
+const Parameters& parameters(Algorithm algo) {
+    return kParameters[static_cast<int>(algo)];
+}
+
+bool is_available(Algorithm algo, Implementation impl) {
+    if (impl != Implementation::pclmul) {
+        return true;
+    }
+#ifdef BITSHIELD_CRC_PCLMUL
+    return (algo == Algorithm::crc32 || algo == Algorithm::crc32c) && cpu_has_pclmul();
+#else
+    (void)algo;
+    return false;
+#endif
+}
+
+Implementation dispatched(Algorithm algo) {
+    return is_available(algo, Implementation::pclmul) ? Implementation::pclmul : Implementation::slicing8;
+}
+
+uint64_t compute_with(Algorithm algo, Implementation impl, const uint8_t* data, size_t size) {
+    if (!is_available(algo, impl)) {
+        throw std::invalid_argument("CRC implementation not available for this algorithm on this CPU");
+    }
+    const Engine& e = engine(algo);
+    return e.finalize(update(algo, impl, e.init(), data, size));
+}
+
+uint64_t compute(Algorithm algo, const uint8_t* data, size_t size) {
+    const Engine& e = engine(algo);
+    return e.finalize(update(algo, dispatched(algo), e.init(), data, size));
+}
+
+uint64_t compute(Algorithm algo, const std::vector<uint8_t>& bytes) {
+    return compute(algo, bytes.data(), bytes.size());
+}
+
+uint64_t compute_bits(Algorithm algo, const std::vector<uint8_t>& bits) {
+    const Engine& e = engine(algo);
+    Implementation impl = dispatched(algo);
+    uint64_t reg = e.init();
+    
+    // Pack whole bytes through a fixed buffer so the fast kernel sees long runs
+    uint8_t buffer[4096];
+    size_t whole = bits.size() / 8 * 8;
+    size_t i = 0;
+    while (i < whole) {
+        size_t count = (whole - i) / 8 < sizeof(buffer) ? (whole - i) / 8 : sizeof(buffer);
+        util::bits_to_bytes(bits.data() + i, count * 8, buffer);
+        i += count * 8;
+        reg = update(algo, impl, reg, buffer, count);
+    }
+    
+    for (; i < bits.size(); ++i) {
+        reg ^= e.params->reflected ? (bits[i] & 1) : static_cast<uint64_t>(bits[i] & 1) << 63;
+        reg = e.step_bit(reg);
+    }
+    
+    return e.finalize(reg);
+}
+
+} // namespace bitshield::crc
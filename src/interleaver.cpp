@@ -0,0 +1,264 @@
+#include <bitshield/interleaver.hpp>
+#include "rng.hpp"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <cstdint>
+
+namespace bitshield::interleaver {
+
+namespace {
+
+// Tile edge for the unpacked transpose: a 32x32 tile of source and
+// destination bytes stays resident in L1 while it is copied
+constexpr size_t kTile = 32;
+
+// The kernels below move elements of any type, so bits and per-bit soft
+// values (LLRs) go through the same permutations. Each copies a trailing
+// partial block unchanged.
+
+// Transpose every complete rows x cols block from in to out
+template <typename T>
+void transpose_blocks(const T* in, size_t size, T* out, size_t rows, size_t cols) {
+    size_t block = rows * cols;
+    size_t full = size / block * block;
+    std::copy(in + full, in + size, out + full);
+    for (size_t base = 0; base < full; base += block) {
+        const T* src = in + base;
+        T* dst = out + base;
+        for (size_t r0 = 0; r0 < rows; r0 += kTile) {
+            size_t r1 = std::min(r0 + kTile, rows);
+            for (size_t c0 = 0; c0 < cols; c0 += kTile) {
+                size_t c1 = std::min(c0 + kTile, cols);
+                for (size_t r = r0; r < r1; ++r) {
+                    for (size_t c = c0; c < c1; ++c) {
+                        dst[c * rows + r] = src[r * cols + c];
+                    }
+                }
+            }
+        }
+    }
+}
+
+void check_dimensions(size_t rows, size_t cols) {
+    if (rows == 0 || cols == 0) {
+        throw std::invalid_argument("Interleaver dimensions must be > 0");
+    }
+}
+
+void check_output(util::ConstBitSpan bits, util::BitSpan out) {
+    if (out.size() < bits.size()) {
+        throw std::invalid_argument("Interleaver output span is too small");
+    }
+}
+
+// Invert helical_interleave
+template <typename T>
+void helical_unwind(const T* in, size_t size, T* out, size_t rows, size_t cols) {
+    size_t block = rows * cols;
+    size_t full = size / block * block;
+    std::copy(in + full, in + size, out + full);
+    for (size_t base = 0; base < full; base += block) {
+        const T* src = in + base;
+        T* dst = out + base;
+        for (size_t c = 0; c < cols; ++c) {
+            size_t start = c % rows;
+            for (size_t r = 0; r < rows; ++r) {
+                size_t sr = start + r < rows ? start + r : start + r - rows;
+                dst[sr * cols + c] = src[c * rows + r];
+            }
+        }
+    }
+}
+
+// Invert random_interleave
+template <typename T>
+void random_unpermute(const T* in, size_t size, T* out, size_t block_size, uint32_t seed) {
+    size_t full = size / block_size * block_size;
+    std::copy(in + full, in + size, out + full);
+    if (full == 0) {
+        return;
+    }
+    std::vector<size_t> perm = random_permutation(block_size, seed);
+    for (size_t base = 0; base < full; base += block_size) {
+        for (size_t i = 0; i < block_size; ++i) {
+            out[base + perm[i]] = in[base + i];
+        }
+    }
+}
+
+// Invert convolutional_interleave; out receives size minus the flush length
+template <typename T>
+std::vector<T> convolutional_unwind(const T* in, size_t size, size_t branches, size_t delay) {
+    check_dimensions(branches, delay);
+    
+    size_t span = delay * branches;
+    size_t flush = (branches - 1) * span;
+    if (size < flush) {
+        throw std::invalid_argument("Convolutional deinterleave input is shorter than the interleaver delay");
+    }
+    
+    std::vector<T> out(size - flush);
+    for (size_t t = 0; t < out.size(); ++t) {
+        out[t] = in[t + (t % branches) * span];
+    }
+    return out;
+}
+
+template <typename T>
+std::vector<T> deinterleave_values(const T* in, size_t size, const Spec& spec) {
+    if (spec.kind == Kind::convolutional) {
+        return convolutional_unwind(in, size, spec.rows, spec.cols);
+    }
+    check_dimensions(spec.rows, spec.cols);
+    std::vector<T> out(size);
+    switch (spec.kind) {
+        case Kind::block:
+            // The inverse of a rows x cols transpose is a cols x rows transpose
+            transpose_blocks(in, size, out.data(), spec.cols, spec.rows);
+            return out;
+        case Kind::helical:
+            helical_unwind(in, size, out.data(), spec.rows, spec.cols);
+            return out;
+        case Kind::random:
+            random_unpermute(in, size, out.data(), spec.rows * spec.cols, spec.seed);
+            return out;
+        case Kind::convolutional:
+            break;
+    }
+    throw std::invalid_argument("Unknown interleaver kind");
+}
+
+} // anonymous namespace
+
+void block_interleave(util::ConstBitSpan bits, util::BitSpan out, size_t rows, size_t cols) {
+    check_dimensions(rows, cols);
+    check_output(bits, out);
+    transpose_blocks(bits.data(), bits.size(), out.data(), rows, cols);
+}
+
+std::vector<uint8_t> block_interleave(util::ConstBitSpan bits, size_t rows, size_t cols) {
+    std::vector<uint8_t> out(bits.size());
+    block_interleave(bits, out, rows, cols);
+    return out;
+}
+
+void block_deinterleave(util::ConstBitSpan bits, util::BitSpan out, size_t rows, size_t cols) {
+    check_dimensions(rows, cols);
+    check_output(bits, out);
+    transpose_blocks(bits.data(), bits.size(), out.data(), cols, rows);
+}
+
+std::vector<uint8_t> block_deinterleave(util::ConstBitSpan bits, size_t rows, size_t cols) {
+    std::vector<uint8_t> out(bits.size());
+    block_deinterleave(bits, out, rows, cols);
+    return out;
+}
+
+std::vector<uint8_t> helical_interleave(util::ConstBitSpan bits, size_t rows, size_t cols) {
+    check_dimensions(rows, cols);
+    
+    std::vector<uint8_t> out = bits.to_vector();
+    size_t block = rows * cols;
+    size_t full = bits.size() / block * block;
+    for (size_t base = 0; base < full; base += block) {
+        const uint8_t* src = bits.data() + base;
+        uint8_t* dst = out.data() + base;
+        for (size_t c = 0; c < cols; ++c) {
+            // Column c starts at row c mod rows and wraps around
+            size_t start = c % rows;
+            for (size_t r = 0; r < rows; ++r) {
+                size_t sr = start + r < rows ? start + r : start + r - rows;
+                dst[c * rows + r] = src[sr * cols + c];
+            }
+        }
+    }
+    return out;
+}
+
+std::vector<uint8_t> helical_deinterleave(util::ConstBitSpan bits, size_t rows, size_t cols) {
+    check_dimensions(rows, cols);
+    
+    std::vector<uint8_t> out(bits.size());
+    helical_unwind(bits.data(), bits.size(), out.data(), rows, cols);
+    return out;
+}
+
+std::vector<size_t> random_permutation(size_t size, uint32_t seed) {
+    std::vector<size_t> perm(size);
+    std::iota(perm.begin(), perm.end(), 0);
+    
+    // Fisher-Yates
+    std::mt19937 rng(seed);
+    for (size_t i = size; i > 1; --i) {
+        std::swap(perm[i - 1], perm[rng::uniform_below(rng, i)]);
+    }
+    return perm;
+}
+
+std::vector<uint8_t> random_interleave(util::ConstBitSpan bits, size_t block_size, uint32_t seed) {
+    check_dimensions(block_size, 1);
+    
+    std::vector<uint8_t> out = bits.to_vector();
+    size_t full = bits.size() / block_size * block_size;
+    if (full == 0) {
+        return out;
+    }
+    std::vector<size_t> perm = random_permutation(block_size, seed);
+    for (size_t base = 0; base < full; base += block_size) {
+        for (size_t i = 0; i < block_size; ++i) {
+            out[base + i] = bits[base + perm[i]];
+        }
+    }
+    return out;
+}
+
+std::vector<uint8_t> random_deinterleave(util::ConstBitSpan bits, size_t block_size, uint32_t seed) {
+    check_dimensions(block_size, 1);
+    
+    std::vector<uint8_t> out(bits.size());
+    random_unpermute(bits.data(), bits.size(), out.data(), block_size, seed);
+    return out;
+}
+
+std::vector<uint8_t> convolutional_interleave(util::ConstBitSpan bits, size_t branches, size_t delay) {
+    check_dimensions(branches, delay);
+    
+    size_t span = delay * branches;
+    std::vector<uint8_t> out(bits.size() + (branches - 1) * span, 0);
+    for (size_t t = 0; t < bits.size(); ++t) {
+        out[t + (t % branches) * span] = bits[t];
+    }
+    return out;
+}
+
+std::vector<uint8_t> convolutional_deinterleave(util::ConstBitSpan bits, size_t branches, size_t delay) {
+    return convolutional_unwind(bits.data(), bits.size(), branches, delay);
+}
+
+std::vector<uint8_t> interleave(util::ConstBitSpan bits, const Spec& spec) {
+    switch (spec.kind) {
+        case Kind::block:
+            return block_interleave(bits, spec.rows, spec.cols);
+        case Kind::helical:
+            return helical_interleave(bits, spec.rows, spec.cols);
+        case Kind::random:
+            check_dimensions(spec.rows, spec.cols);
+            return random_interleave(bits, spec.rows * spec.cols, spec.seed);
+        case Kind::convolutional:
+            return convolutional_interleave(bits, spec.rows, spec.cols);
+    }
+    throw std::invalid_argument("Unknown interleaver kind");
+}
+
+std::vector<uint8_t> deinterleave(util::ConstBitSpan bits, const Spec& spec) {
+    return deinterleave_values(bits.data(), bits.size(), spec);
+}
+
+std::vector<float> deinterleave(util::ConstSpan<float> values, const Spec& spec) {
+    return deinterleave_values(values.data(), values.size(), spec);
+}
+
+} // namespace bitshield::interleaver
@@ -1,5 +1,8 @@
 #include <bitshield/io.hpp>
 #include <bitshield/bitstream.hpp>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
@@ -7,86 +10,654 @@
 #include <cstdint>
 #include <string>
 
+#if defined(__unix__) || defined(__APPLE__)
+#define BITSHIELD_IO_MMAP 1
+#define BITSHIELD_IO_POSIX 1
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__)
+#define BITSHIELD_IO_SSE2 1
+#include <emmintrin.h>
+#endif
+
 namespace bitshield::io {
 
-std::pair<int, std::vector<uint8_t>> read_legacy_format(const std::string& path) {
-    std::ifstream file(path);
-    if (!file.is_open()) {
-        throw std::runtime_error("Cannot open file: " + path);
+namespace {
+
+inline bool is_space(uint8_t c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// Byte-at-a-time scanner for the tail of the buffer and for locating errors.
+// Returns the offset of the first invalid byte (a non-0/1, non-space byte or
+// a digit directly after another digit), or end if [begin, end) is valid.
+size_t scan_bits_scalar(const uint8_t* data, size_t begin, size_t end, bool& prev_digit, uint8_t*& out) {
+    for (size_t i = begin; i < end; ++i) {
+        uint8_t c = data[i];
+        if (c == '0' || c == '1') {
+            if (prev_digit) {
+                return i;
+            }
+            *out++ = c & 1;
+            prev_digit = true;
+        } else if (is_space(c)) {
+            prev_digit = false;
+        } else {
+            return i;
+        }
     }
-    
-    int n;
-    std::vector<uint8_t> bits;
-    
-    // Read first token as N
-    if (!(file >> n)) {
-        throw std::runtime_error("Invalid legacy format: cannot read repetition factor N");
+    return end;
+}
+
+#ifdef BITSHIELD_IO_SSE2
+// Classify 16 bytes: bit i of digits/spaces is set when byte i is '0'/'1' or whitespace
+inline void classify16(__m128i c, uint32_t& digits, uint32_t& spaces) {
+    __m128i digit = _mm_cmpeq_epi8(_mm_and_si128(c, _mm_set1_epi8(~1)), _mm_set1_epi8('0'));
+    // '\t'..'\r' is c - 9 <= 4 unsigned
+    __m128i control = _mm_sub_epi8(c, _mm_set1_epi8('\t'));
+    __m128i space = _mm_or_si128(
+        _mm_cmpeq_epi8(c, _mm_set1_epi8(' ')),
+        _mm_cmpeq_epi8(_mm_min_epu8(control, _mm_set1_epi8(4)), control)
+    );
+    digits = static_cast<uint32_t>(_mm_movemask_epi8(digit));
+    spaces = static_cast<uint32_t>(_mm_movemask_epi8(space));
+}
+
+// Write the 0/1 values of the even (shift 0) or odd (shift 8) bytes of c
+inline void store_alternate16(__m128i c, int shift, uint8_t* out) {
+    __m128i v = shift == 0 ? c : _mm_srli_epi16(c, 8);
+    v = _mm_and_si128(v, _mm_set1_epi16(1));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(v, v));
+}
+#endif
+
+// Parse whitespace-separated 0/1 tokens in data[begin, size) into out, which
+// must have room for (size - begin + 1) / 2 values. 32 bytes are classified per
+// step; the usual "0 1 1 0" layout is compacted with shifts and packs, other
+// layouts by walking the digit mask. prev_digit carries the token state across
+// consecutive buffers of one stream. Returns the offset of the first invalid
+// byte, or size; *end receives the end of the written values.
+size_t scan_bits(const uint8_t* data, size_t begin, size_t size, bool& prev_digit, uint8_t* out, uint8_t** end) {
+    size_t i = begin;
+#ifdef BITSHIELD_IO_SSE2
+    for (; i + 32 <= size; i += 32) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 16));
+        uint32_t digits_lo, spaces_lo, digits_hi, spaces_hi;
+        classify16(lo, digits_lo, spaces_lo);
+        classify16(hi, digits_hi, spaces_hi);
+        uint32_t digits = digits_lo | (digits_hi << 16);
+        uint32_t spaces = spaces_lo | (spaces_hi << 16);
+        
+        // Any other byte, or a token of two or more digits, is an error; the
+        // scalar scanner finds its exact offset
+        if ((digits | spaces) != 0xFFFFFFFFu || (digits & ((digits << 1) | prev_digit)) != 0) {
+            break;
+        }
+        
+        if (digits == 0x55555555u || digits == 0xAAAAAAAAu) {
+            int shift = digits == 0x55555555u ? 0 : 8;
+            store_alternate16(lo, shift, out);
+            store_alternate16(hi, shift, out + 8);
+            out += 16;
+        } else {
+            for (uint32_t m = digits; m != 0; m &= m - 1) {
+                *out++ = data[i + static_cast<size_t>(__builtin_ctz(m))] & 1;
+            }
+        }
+        prev_digit = (digits >> 31) != 0;
     }
+#endif
+    size_t bad = scan_bits_scalar(data, i, size, prev_digit, out);
+    *end = out;
+    return bad;
+}
+
+// Bytes handed to each write(2) call (a multiple of the page size)
+constexpr size_t kWriteChunk = size_t{1} << 16;
+
+// "b b b b b b b b " for every byte value, most significant bit first
+struct DigitTable {
+    char text[256][16];
     
-    // Read remaining tokens as bits
-    int bit;
-    while (file >> bit) {
-        if (bit != 0 && bit != 1) {
-            throw std::runtime_error("Invalid legacy format: bits must be 0 or 1");
+    constexpr DigitTable() : text() {
+        for (int value = 0; value < 256; ++value) {
+            for (int j = 0; j < 8; ++j) {
+                text[value][2 * j] = static_cast<char>('0' + ((value >> (7 - j)) & 1));
+                text[value][2 * j + 1] = ' ';
+            }
         }
-        bits.push_back(static_cast<uint8_t>(bit));
     }
+};
+
+constexpr DigitTable kDigits{};
+
+[[noreturn]] void throw_invalid_bit(const char* format, uint64_t offset) {
+    throw std::runtime_error(
+        std::string("Invalid ") + format + " format: bits must be 0 or 1 (at byte offset " + std::to_string(offset) + ")"
+    );
+}
+
+std::vector<uint8_t> parse_bits(const uint8_t* data, size_t begin, size_t size, const char* format) {
+    std::vector<uint8_t> bits((size - begin + 1) / 2);
+    bool prev_digit = false;
+    uint8_t* end = nullptr;
+    size_t bad = scan_bits(data, begin, size, prev_digit, bits.data(), &end);
+    if (bad != size) {
+        throw_invalid_bit(format, bad);
+    }
+    bits.resize(static_cast<size_t>(end - bits.data()));
+    return bits;
+}
+
+// Parse the leading repetition factor N of the legacy format; i is left after the token
+int parse_count(const uint8_t* data, size_t size, size_t& i) {
+    i = 0;
+    while (i < size && is_space(data[i])) {
+        i++;
+    }
+    size_t token = i;
+    while (i < size && !is_space(data[i])) {
+        i++;
+    }
+    int n = 0;
+    const char* first = reinterpret_cast<const char*>(data + token);
+    const char* last = reinterpret_cast<const char*>(data + i);
+    if (first != last && *first == '+') {
+        first++;
+    }
+    auto [ptr, ec] = std::from_chars(first, last, n);
+    if (token == i || ec != std::errc() || ptr != last) {
+        throw std::runtime_error("Invalid legacy format: cannot read repetition factor N");
+    }
+    return n;
+}
+
+#ifdef BITSHIELD_IO_POSIX
+// Asynchronous I/O needs positioned reads and writes, so only regular files qualify
+bool is_async_target(int fd) {
+    struct stat st;
+    return io_options().backend != IoBackend::blocking && ::fstat(fd, &st) == 0 && S_ISREG(st.st_mode);
+}
+#endif
+
+} // anonymous namespace
+
+std::pair<int, std::vector<uint8_t>> read_legacy_format(const std::string& path) {
+    MappedFile file(path);
+    count_bytes(file.is_mapped() ? ByteMove::mapped_in : ByteMove::copied_in, file.size());
     
-    return {n, bits};
+    // First token is N, remaining tokens are bits
+    size_t i = 0;
+    int n = parse_count(file.data(), file.size(), i);
+    return {n, parse_bits(file.data(), i, file.size(), "legacy")};
 }
 
 std::vector<uint8_t> read_bit_format(const std::string& path) {
-    std::ifstream file(path);
-    if (!file.is_open()) {
-        throw std::runtime_error("Cannot open file: " + path);
+    MappedFile file(path);
+    count_bytes(file.is_mapped() ? ByteMove::mapped_in : ByteMove::copied_in, file.size());
+    return parse_bits(file.data(), 0, file.size(), "bit");
+}
+
+std::vector<uint8_t> read_text_format(const std::string& path) {
+    InputFile file(path);
+    std::vector<uint8_t> bytes;
+    size_t got = 0;
+    do {
+        bytes.resize(bytes.size() + kWriteChunk);
+        got = file.read(bytes.data() + bytes.size() - kWriteChunk, kWriteChunk);
+        bytes.resize(bytes.size() - kWriteChunk + got);
+    } while (got == kWriteChunk);
+    
+    return bitshield::util::bytes_to_bits(bytes);
+}
+
+void write_bit_format(const std::string& path, const std::vector<uint8_t>& bits) {
+    BitFormatWriter writer(path);
+    writer.write(bits);
+    writer.finish();
+}
+
+void write_text_format(const std::string& path, const std::vector<uint8_t>& bits) {
+    OutputFile file(path);
+    std::string text = bitshield::util::bits_to_text(bits);
+    file.write(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+    file.flush();
+}
+
+std::pair<size_t, std::vector<std::vector<uint8_t>>> read_symbols(const std::string& path, size_t symbol_size) {
+    if (symbol_size == 0) {
+        throw std::invalid_argument("Symbol size must be > 0");
     }
     
-    std::vector<uint8_t> bits;
-    int bit;
-    while (file >> bit) {
-        if (bit != 0 && bit != 1) {
-            throw std::runtime_error("Invalid bit format: bits must be 0 or 1");
+    InputFile file(path);
+    size_t size = 0;
+    std::vector<std::vector<uint8_t>> symbols;
+    while (true) {
+        std::vector<uint8_t> symbol(symbol_size, 0);
+        size_t got = file.read(symbol.data(), symbol_size);
+        if (got == 0) {
+            break;
+        }
+        size += got;
+        symbols.push_back(std::move(symbol));
+        if (got < symbol_size) {
+            break;
         }
-        bits.push_back(static_cast<uint8_t>(bit));
     }
     
-    return bits;
+    return {size, symbols};
 }
 
-std::vector<uint8_t> read_text_format(const std::string& path) {
-    std::ifstream file(path, std::ios::binary);
-    if (!file.is_open()) {
+void write_symbols(const std::string& path, const std::vector<std::vector<uint8_t>>& symbols, size_t size) {
+    OutputFile file(path);
+    for (const auto& symbol : symbols) {
+        if (size == 0) {
+            break;
+        }
+        size_t n = symbol.size() < size ? symbol.size() : size;
+        file.write(symbol.data(), n);
+        size -= n;
+    }
+    file.flush();
+}
+
+OutputFile::OutputFile(const std::string& path) : path_(path) {
+#ifdef BITSHIELD_IO_POSIX
+    fd_ = path == "-" ? STDOUT_FILENO : ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (fd_ < 0) {
+        throw std::runtime_error("Cannot write file: " + path);
+    }
+    if (path != "-" && is_async_target(fd_)) {
+        async_ = std::make_unique<AsyncWriter>(fd_, io_options());
+    }
+#else
+    file_ = path == "-" ? stdout : std::fopen(path.c_str(), "wb");
+    if (file_ == nullptr) {
+        throw std::runtime_error("Cannot write file: " + path);
+    }
+#endif
+}
+
+OutputFile::~OutputFile() {
+#ifdef BITSHIELD_IO_POSIX
+    if (async_) {
+        try {
+            async_->flush();
+        } catch (const std::exception&) {
+            // Call flush() to see write errors
+        }
+        async_.reset();
+    }
+    if (fd_ != STDOUT_FILENO) {
+        ::close(fd_);
+    }
+#else
+    std::FILE* file = static_cast<std::FILE*>(file_);
+    if (file != stdout) {
+        std::fclose(file);
+    } else {
+        std::fflush(file);
+    }
+#endif
+}
+
+void OutputFile::write(const uint8_t* data, size_t size) {
+#ifdef BITSHIELD_IO_POSIX
+    if (async_) {
+        try {
+            async_->write(data, size);
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error("Cannot write file: " + path_ + " (" + e.what() + ")");
+        }
+        return;
+    }
+    count_bytes(ByteMove::copied_out, size);
+    while (size > 0) {
+        ssize_t n = ::write(fd_, data, size);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            throw std::runtime_error("Cannot write file: " + path_);
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+#else
+    count_bytes(ByteMove::copied_out, size);
+    if (std::fwrite(data, 1, size, static_cast<std::FILE*>(file_)) != size) {
+        throw std::runtime_error("Cannot write file: " + path_);
+    }
+#endif
+}
+
+uint8_t* OutputFile::reserve(size_t& size) {
+#ifdef BITSHIELD_IO_POSIX
+    if (async_) {
+        try {
+            return async_->reserve(size);
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error("Cannot write file: " + path_ + " (" + e.what() + ")");
+        }
+    }
+#endif
+    if (staging_.empty()) {
+        staging_.resize(kWriteChunk);
+    }
+    if (size > staging_.size()) {
+        size = staging_.size();
+    }
+    return staging_.data();
+}
+
+void OutputFile::commit(size_t size) {
+#ifdef BITSHIELD_IO_POSIX
+    if (async_) {
+        async_->commit(size);
+        return;
+    }
+#endif
+    write(staging_.data(), size);
+}
+
+void OutputFile::flush() {
+#ifdef BITSHIELD_IO_POSIX
+    if (async_) {
+        try {
+            async_->flush();
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error("Cannot write file: " + path_ + " (" + e.what() + ")");
+        }
+    }
+#else
+    if (std::fflush(static_cast<std::FILE*>(file_)) != 0) {
+        throw std::runtime_error("Cannot write file: " + path_);
+    }
+#endif
+}
+
+InputFile::InputFile(const std::string& path) : path_(path) {
+#ifdef BITSHIELD_IO_POSIX
+    fd_ = path == "-" ? STDIN_FILENO : ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    if (path != "-" && is_async_target(fd_)) {
+        async_ = std::make_unique<AsyncReader>(fd_, io_options());
+    }
+#else
+    file_ = path == "-" ? stdin : std::fopen(path.c_str(), "rb");
+    if (file_ == nullptr) {
         throw std::runtime_error("Cannot open file: " + path);
     }
+#endif
+}
+
+InputFile::~InputFile() {
+#ifdef BITSHIELD_IO_POSIX
+    async_.reset();
+    if (fd_ != STDIN_FILENO) {
+        ::close(fd_);
+    }
+#else
+    if (static_cast<std::FILE*>(file_) != stdin) {
+        std::fclose(static_cast<std::FILE*>(file_));
+    }
+#endif
+}
+
+size_t InputFile::read_some(uint8_t* data, size_t size) {
+#ifdef BITSHIELD_IO_POSIX
+    if (async_) {
+        try {
+            return async_->read(data, size);
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error("Cannot read file: " + path_ + " (" + e.what() + ")");
+        }
+    }
+    while (true) {
+        ssize_t n = ::read(fd_, data, size);
+        if (n >= 0) {
+            count_bytes(ByteMove::copied_in, static_cast<uint64_t>(n));
+            return static_cast<size_t>(n);
+        }
+        if (errno != EINTR) {
+            throw std::runtime_error("Cannot read file: " + path_);
+        }
+    }
+#else
+    size_t n = std::fread(data, 1, size, static_cast<std::FILE*>(file_));
+    if (n < size && std::ferror(static_cast<std::FILE*>(file_))) {
+        throw std::runtime_error("Cannot read file: " + path_);
+    }
+    count_bytes(ByteMove::copied_in, n);
+    return n;
+#endif
+}
+
+size_t InputFile::read(uint8_t* data, size_t size) {
+    size_t done = 0;
+    // Bytes returned by peek come first
+    if (!lookahead_.empty()) {
+        done = lookahead_.size() < size ? lookahead_.size() : size;
+        std::memcpy(data, lookahead_.data(), done);
+        count_bytes(ByteMove::staged, done);
+        lookahead_.erase(lookahead_.begin(), lookahead_.begin() + done);
+    }
+    while (done < size) {
+        size_t n = read_some(data + done, size - done);
+        if (n == 0) {
+            break;
+        }
+        done += n;
+    }
+    return done;
+}
+
+size_t InputFile::peek(uint8_t* data, size_t size) {
+    while (lookahead_.size() < size) {
+        uint8_t buffer[256];
+        size_t want = size - lookahead_.size() < sizeof(buffer) ? size - lookahead_.size() : sizeof(buffer);
+        size_t n = read_some(buffer, want);
+        if (n == 0) {
+            break;
+        }
+        lookahead_.insert(lookahead_.end(), buffer, buffer + n);
+    }
+    size_t n = lookahead_.size() < size ? lookahead_.size() : size;
+    std::memcpy(data, lookahead_.data(), n);
+    return n;
+}
+
+BitFormatReader::BitFormatReader(InputFile& file, bool leading_count)
+    : file_(file), leading_count_(leading_count), buffer_(kWriteChunk) {}
+
+bool BitFormatReader::next(std::vector<uint8_t>& bits) {
+    const char* format = leading_count_ ? "legacy" : "bit";
+    size_t size = file_.read(buffer_.data(), buffer_.size());
+    if (size == 0) {
+        if (leading_count_ && offset_ == 0) {
+            throw std::runtime_error("Invalid legacy format: cannot read repetition factor N");
+        }
+        bits.clear();
+        return false;
+    }
     
-    std::string text((std::istreambuf_iterator<char>(file)),
-                     std::istreambuf_iterator<char>());
+    size_t begin = 0;
+    if (leading_count_ && offset_ == 0) {
+        // N must end within the first buffer
+        count_ = parse_count(buffer_.data(), size, begin);
+        if (begin == size && size == buffer_.size()) {
+            throw std::runtime_error("Invalid legacy format: cannot read repetition factor N");
+        }
+    }
     
-    return bitshield::util::text_to_bits(text);
+    bits.resize((size - begin + 1) / 2);
+    uint8_t* end = nullptr;
+    size_t bad = scan_bits(buffer_.data(), begin, size, prev_digit_, bits.data(), &end);
+    if (bad != size) {
+        throw_invalid_bit(format, offset_ + bad);
+    }
+    bits.resize(static_cast<size_t>(end - bits.data()));
+    offset_ += size;
+    return true;
 }
 
-void write_bit_format(const std::string& path, const std::vector<uint8_t>& bits) {
-    std::ofstream file(path);
-    if (!file.is_open()) {
-        throw std::runtime_error("Cannot write file: " + path);
+BitFormatWriter::BitFormatWriter(const std::string& path) : file_(path), buffer_(kWriteChunk) {}
+
+BitFormatWriter::~BitFormatWriter() {
+    try {
+        finish();
+    } catch (...) {
+        // Errors are reported by an explicit finish()
     }
-    
-    for (size_t i = 0; i < bits.size(); ++i) {
-        if (i > 0) {
-            file << " ";
+}
+
+void BitFormatWriter::write(const std::vector<uint8_t>& bits) {
+    // Every bit expands to "b "; groups of eight are one 16-byte table entry.
+    // The buffer is only flushed when more bits follow, so the separator
+    // after the last bit stays in the buffer until finish() drops it.
+    for (size_t i = 0; i < bits.size(); i += 8) {
+        if (used_ + 16 > buffer_.size()) {
+            file_.write(buffer_.data(), used_);
+            used_ = 0;
+        }
+        size_t count = bits.size() - i < 8 ? bits.size() - i : 8;
+        unsigned value = 0;
+        for (size_t j = 0; j < count; ++j) {
+            value |= static_cast<unsigned>(bits[i + j] & 1) << (7 - j);
         }
-        file << static_cast<int>(bits[i]);
+        std::memcpy(buffer_.data() + used_, kDigits.text[value], 16);
+        used_ += 2 * count;
     }
 }
 
-void write_text_format(const std::string& path, const std::vector<uint8_t>& bits) {
-    std::ofstream file(path, std::ios::binary);
+void BitFormatWriter::finish() {
+    if (used_ > 0) {
+        size_t used = used_;
+        used_ = 0;
+        file_.write(buffer_.data(), used - 1);
+    }
+    file_.flush();
+}
+
+TextWriter::TextWriter(const std::string& path) : file_(path) {}
+
+TextWriter::~TextWriter() {
+    try {
+        finish();
+    } catch (...) {
+        // Errors are reported by an explicit finish()
+    }
+}
+
+void TextWriter::write(const std::vector<uint8_t>& bits) {
+    size_t i = 0;
+    while (true) {
+        size_t size = (partial_bits_ + bits.size() - i) / 8;
+        if (size == 0) {
+            break;
+        }
+        uint8_t* out = file_.reserve(size);
+        size_t k = 0;
+        if (partial_bits_ > 0) {
+            // Complete the bits left over from the last call
+            unsigned value = partial_;
+            for (; partial_bits_ < 8; ++partial_bits_) {
+                value = (value << 1) | (bits[i++] & 1);
+            }
+            out[k++] = static_cast<uint8_t>(value);
+            partial_ = 0;
+            partial_bits_ = 0;
+        }
+        bitshield::util::bits_to_bytes(bits.data() + i, 8 * (size - k), out + k);
+        i += 8 * (size - k);
+        file_.commit(size);
+    }
+    for (; i < bits.size(); ++i) {
+        partial_ = (partial_ << 1) | (bits[i] & 1);
+        partial_bits_++;
+    }
+}
+
+void TextWriter::finish() {
+    partial_ = 0;
+    partial_bits_ = 0;
+    file_.flush();
+}
+
+MappedFile::MappedFile(const std::string& path) {
+#ifdef BITSHIELD_IO_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat file: " + path);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ > 0) {
+        void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Cannot map file: " + path);
+        }
+        data_ = static_cast<const uint8_t*>(addr);
+        mapped_ = true;
+    }
+    // The mapping keeps its own reference to the file
+    ::close(fd);
+#else
+    std::ifstream file(path, std::ios::binary);
     if (!file.is_open()) {
-        throw std::runtime_error("Cannot write file: " + path);
+        throw std::runtime_error("Cannot open file: " + path);
     }
-    
-    std::string text = bitshield::util::bits_to_text(bits);
-    file << text;
+    buffer_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+#endif
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        buffer_ = std::move(other.buffer_);
+        mapped_ = other.mapped_;
+        size_ = other.size_;
+        data_ = mapped_ ? other.data_ : buffer_.data();
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.mapped_ = false;
+    }
+    return *this;
+}
+
+void MappedFile::release() {
+#ifdef BITSHIELD_IO_MMAP
+    if (mapped_) {
+        ::munmap(const_cast<uint8_t*>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    buffer_.clear();
 }
 
 } // namespace bitshield::io
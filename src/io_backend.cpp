@@ -0,0 +1,599 @@
+#include <bitshield/io_backend.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BITSHIELD_IO_POSIX 1
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && (defined(__GNUC__) || defined(__clang__)) && __has_include(<linux/io_uring.h>)
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+#define BITSHIELD_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#endif
+#endif
+
+namespace bitshield::io {
+
+namespace {
+
+constexpr size_t kBufferAlignment = 4096;
+
+std::mutex options_mutex;
+IoOptions current_options;
+
+// Indexed by ByteMove
+std::atomic<uint64_t> byte_counters[4];
+
+[[noreturn]] void io_error(long error) {
+    throw std::runtime_error(std::string("I/O error: ") + std::strerror(static_cast<int>(error)));
+}
+
+} // anonymous namespace
+
+// Completion queue over depth block-sized buffers ("slots"). A slot has at
+// most one request in flight; completions may arrive in any order.
+class IoQueue {
+public:
+    IoQueue(IoBackend backend, const IoOptions& options)
+        : backend_(backend), block_bytes_(options.block_bytes), depth_(options.depth),
+          storage_(options.block_bytes * options.depth + kBufferAlignment),
+          pending_(options.depth, 0), result_(options.depth, 0),
+          offset_(options.depth, 0), size_(options.depth, 0) {
+        size_t misalignment = reinterpret_cast<uintptr_t>(storage_.data()) % kBufferAlignment;
+        base_ = storage_.data() + (misalignment ? kBufferAlignment - misalignment : 0);
+    }
+    
+    virtual ~IoQueue() = default;
+    
+    IoQueue(const IoQueue&) = delete;
+    IoQueue& operator=(const IoQueue&) = delete;
+    
+    IoBackend backend() const { return backend_; }
+    size_t block_bytes() const { return block_bytes_; }
+    size_t depth() const { return depth_; }
+    uint8_t* buffer(size_t slot) { return base_ + slot * block_bytes_; }
+    
+    // Start reading or writing size bytes of a slot's buffer at a file offset
+    void submit(size_t slot, bool write, int fd, uint64_t offset, size_t size) {
+        pending_[slot] = 1;
+        offset_[slot] = offset;
+        size_[slot] = size;
+        start(slot, write, fd, offset, size);
+    }
+    
+    // Mark a slot as completed without a request (e.g. reads past the end)
+    void complete(size_t slot, long result) {
+        pending_[slot] = 0;
+        result_[slot] = result;
+        size_[slot] = 0;
+    }
+    
+    // Wait until a slot's request completes; returns bytes moved or -errno
+    long wait(size_t slot) {
+        while (pending_[slot]) {
+            auto [done, result] = reap();
+            pending_[done] = 0;
+            result_[done] = result;
+        }
+        return result_[slot];
+    }
+    
+    uint64_t offset(size_t slot) const { return offset_[slot]; }
+    size_t size(size_t slot) const { return size_[slot]; }
+    
+protected:
+    // Wait for every request, so no transfer outlives the buffers
+    void drain() {
+        for (size_t slot = 0; slot < depth_; ++slot) {
+            wait(slot);
+        }
+    }
+    
+private:
+    virtual void start(size_t slot, bool write, int fd, uint64_t offset, size_t size) = 0;
+    virtual std::pair<size_t, long> reap() = 0;
+    
+    IoBackend backend_;
+    size_t block_bytes_;
+    size_t depth_;
+    std::vector<uint8_t> storage_;
+    uint8_t* base_ = nullptr;
+    std::vector<uint8_t> pending_;
+    std::vector<long> result_;
+    std::vector<uint64_t> offset_;
+    std::vector<size_t> size_;
+};
+
+namespace {
+
+#ifdef BITSHIELD_IO_POSIX
+
+// Whole transfer with pread/pwrite, retrying short counts; bytes or -errno
+long transfer(bool write, int fd, uint8_t* data, size_t size, uint64_t offset) {
+    size_t done = 0;
+    while (done < size) {
+        ssize_t n = write
+            ? ::pwrite(fd, data + done, size - done, static_cast<off_t>(offset + done))
+            : ::pread(fd, data + done, size - done, static_cast<off_t>(offset + done));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0) {
+            return -errno;
+        }
+        if (n == 0) {
+            if (write) {
+                return -EIO;
+            }
+            break;
+        }
+        done += static_cast<size_t>(n);
+    }
+    return static_cast<long>(done);
+}
+
+// Portable backend: one pread/pwrite worker per slot
+class ThreadQueue : public IoQueue {
+public:
+    explicit ThreadQueue(const IoOptions& options) : IoQueue(IoBackend::threads, options) {
+        for (size_t i = 0; i < options.depth; ++i) {
+            workers_.emplace_back([this] { work(); });
+        }
+    }
+    
+    ~ThreadQueue() override {
+        drain();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        jobs_ready_.notify_all();
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+    }
+    
+private:
+    struct Job {
+        size_t slot;
+        bool write;
+        int fd;
+        uint64_t offset;
+        size_t size;
+    };
+    
+    void start(size_t slot, bool write, int fd, uint64_t offset, size_t size) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            jobs_.push_back({slot, write, fd, offset, size});
+        }
+        jobs_ready_.notify_one();
+    }
+    
+    std::pair<size_t, long> reap() override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_ready_.wait(lock, [this] { return !done_.empty(); });
+        auto completion = done_.front();
+        done_.pop_front();
+        return completion;
+    }
+    
+    void work() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            jobs_ready_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+            if (jobs_.empty()) {
+                return;
+            }
+            Job job = jobs_.front();
+            jobs_.pop_front();
+            lock.unlock();
+            long result = transfer(job.write, job.fd, buffer(job.slot), job.size, job.offset);
+            lock.lock();
+            done_.emplace_back(job.slot, result);
+            done_ready_.notify_one();
+        }
+    }
+    
+    std::mutex mutex_;
+    std::condition_variable jobs_ready_;
+    std::condition_variable done_ready_;
+    std::deque<Job> jobs_;
+    std::deque<std::pair<size_t, long>> done_;
+    std::vector<std::thread> workers_;
+    bool stop_ = false;
+};
+
+#endif
+
+#ifdef BITSHIELD_IO_URING
+
+// io_uring through the raw system calls (no liburing dependency). The slot
+// buffers are registered once, so requests use the fixed-buffer opcodes and
+// the kernel skips pinning pages per request.
+class UringQueue : public IoQueue {
+public:
+    explicit UringQueue(const IoOptions& options) : IoQueue(IoBackend::uring, options) {
+        io_uring_params params{};
+        ring_fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, static_cast<unsigned>(options.depth), &params));
+        if (ring_fd_ < 0) {
+            throw std::runtime_error("io_uring is not available");
+        }
+        
+        sq_bytes_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_bytes_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single) {
+            sq_bytes_ = cq_bytes_ = sq_bytes_ > cq_bytes_ ? sq_bytes_ : cq_bytes_;
+        }
+        sq_ring_ = ::mmap(nullptr, sq_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+        cq_ring_ = single ? sq_ring_
+            : ::mmap(nullptr, cq_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+        sqes_bytes_ = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = ::mmap(nullptr, sqes_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+        sqes_ = sqes == MAP_FAILED ? nullptr : static_cast<io_uring_sqe*>(sqes);
+        if (sq_ring_ == MAP_FAILED || cq_ring_ == MAP_FAILED || sqes_ == nullptr) {
+            release();
+            throw std::runtime_error("io_uring rings cannot be mapped");
+        }
+        
+        auto* sq = static_cast<uint8_t*>(sq_ring_);
+        auto* cq = static_cast<uint8_t*>(cq_ring_);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        
+        // Registration can fail under a low RLIMIT_MEMLOCK; plain reads and writes still work
+        std::vector<iovec> buffers(depth());
+        for (size_t slot = 0; slot < depth(); ++slot) {
+            buffers[slot] = {buffer(slot), block_bytes()};
+        }
+        registered_ = ::syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_BUFFERS,
+                                buffers.data(), static_cast<unsigned>(buffers.size())) == 0;
+    }
+    
+    ~UringQueue() override {
+        drain();
+        release();
+    }
+    
+private:
+    void start(size_t slot, bool write, int fd, uint64_t offset, size_t size) override {
+        unsigned tail = *sq_tail_;
+        unsigned index = tail & sq_mask_;
+        io_uring_sqe& sqe = sqes_[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        if (registered_) {
+            sqe.opcode = write ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+            sqe.buf_index = static_cast<uint16_t>(slot);
+        } else {
+            sqe.opcode = write ? IORING_OP_WRITE : IORING_OP_READ;
+        }
+        sqe.fd = fd;
+        sqe.off = offset;
+        sqe.addr = reinterpret_cast<uint64_t>(buffer(slot));
+        sqe.len = static_cast<uint32_t>(size);
+        sqe.user_data = slot;
+        sq_array_[index] = index;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+        
+        while (::syscall(__NR_io_uring_enter, ring_fd_, 1u, 0u, 0u, nullptr, 0) < 0) {
+            if (errno != EINTR && errno != EAGAIN) {
+                io_error(errno);
+            }
+        }
+    }
+    
+    std::pair<size_t, long> reap() override {
+        while (true) {
+            unsigned head = *cq_head_;
+            if (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+                const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+                std::pair<size_t, long> completion(static_cast<size_t>(cqe.user_data), cqe.res);
+                __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+                return completion;
+            }
+            if (::syscall(__NR_io_uring_enter, ring_fd_, 0u, 1u, IORING_ENTER_GETEVENTS, nullptr, 0) < 0
+                && errno != EINTR) {
+                io_error(errno);
+            }
+        }
+    }
+    
+    void release() {
+        if (sqes_ != nullptr) {
+            ::munmap(sqes_, sqes_bytes_);
+        }
+        if (cq_ring_ != nullptr && cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_) {
+            ::munmap(cq_ring_, cq_bytes_);
+        }
+        if (sq_ring_ != nullptr && sq_ring_ != MAP_FAILED) {
+            ::munmap(sq_ring_, sq_bytes_);
+        }
+        ::close(ring_fd_);
+    }
+    
+    int ring_fd_ = -1;
+    bool registered_ = false;
+    void* sq_ring_ = nullptr;
+    void* cq_ring_ = nullptr;
+    size_t sq_bytes_ = 0;
+    size_t cq_bytes_ = 0;
+    size_t sqes_bytes_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned* sq_array_ = nullptr;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+};
+
+#endif
+
+// Queue for the requested backend, falling back from io_uring to threads
+std::unique_ptr<IoQueue> make_queue(const IoOptions& options) {
+#ifdef BITSHIELD_IO_URING
+    if (options.backend == IoBackend::uring) {
+        try {
+            return std::make_unique<UringQueue>(options);
+        } catch (const std::runtime_error&) {
+            // Kernel without io_uring or a seccomp filter; use the thread pool
+        }
+    }
+#endif
+#ifdef BITSHIELD_IO_POSIX
+    if (options.backend != IoBackend::blocking) {
+        return std::make_unique<ThreadQueue>(options);
+    }
+#endif
+    (void)options;
+    throw std::runtime_error("Asynchronous file I/O is not available on this platform");
+}
+
+} // anonymous namespace
+
+void set_io_options(const IoOptions& options) {
+    if (options.block_bytes == 0 || options.depth == 0) {
+        throw std::invalid_argument("I/O block size and depth must be > 0");
+    }
+    std::lock_guard<std::mutex> lock(options_mutex);
+    current_options = options;
+}
+
+IoOptions io_options() {
+    std::lock_guard<std::mutex> lock(options_mutex);
+    return current_options;
+}
+
+bool is_available(IoBackend backend) {
+    switch (backend) {
+        case IoBackend::blocking:
+            return true;
+        case IoBackend::threads:
+#ifdef BITSHIELD_IO_POSIX
+            return true;
+#else
+            return false;
+#endif
+        case IoBackend::uring:
+#ifdef BITSHIELD_IO_URING
+            {
+                io_uring_params params{};
+                int fd = static_cast<int>(::syscall(__NR_io_uring_setup, 1u, &params));
+                if (fd < 0) {
+                    return false;
+                }
+                ::close(fd);
+                return true;
+            }
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+const char* backend_name(IoBackend backend) {
+    switch (backend) {
+        case IoBackend::blocking: return "blocking";
+        case IoBackend::uring: return "uring";
+        case IoBackend::threads: return "threads";
+    }
+    return "unknown";
+}
+
+IoBackend parse_backend(const std::string& name) {
+    for (IoBackend backend : {IoBackend::blocking, IoBackend::uring, IoBackend::threads}) {
+        if (name == backend_name(backend)) {
+            return backend;
+        }
+    }
+    throw std::invalid_argument("Unknown I/O backend: " + name);
+}
+
+void count_bytes(ByteMove kind, uint64_t bytes) {
+    byte_counters[static_cast<size_t>(kind)].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+CopyStats copy_stats() {
+    auto load = [](ByteMove kind) {
+        return byte_counters[static_cast<size_t>(kind)].load(std::memory_order_relaxed);
+    };
+    CopyStats stats;
+    stats.copied_in = load(ByteMove::copied_in);
+    stats.copied_out = load(ByteMove::copied_out);
+    stats.staged = load(ByteMove::staged);
+    stats.mapped_in = load(ByteMove::mapped_in);
+    return stats;
+}
+
+void reset_copy_stats() {
+    for (std::atomic<uint64_t>& counter : byte_counters) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+}
+
+AsyncReader::AsyncReader(int fd, const IoOptions& options) : queue_(make_queue(options)), fd_(fd) {
+    for (size_t slot = 0; slot < queue_->depth(); ++slot) {
+        submit(slot);
+    }
+}
+
+AsyncReader::~AsyncReader() = default;
+
+IoBackend AsyncReader::backend() const {
+    return queue_->backend();
+}
+
+void AsyncReader::submit(size_t slot) {
+    if (eof_submitted_) {
+        queue_->complete(slot, 0);
+        return;
+    }
+    queue_->submit(slot, false, fd_, next_offset_, queue_->block_bytes());
+    next_offset_ += queue_->block_bytes();
+}
+
+void AsyncReader::wait_slot(size_t slot) {
+    long result = queue_->wait(slot);
+    if (result < 0) {
+        io_error(-result);
+    }
+    size_t requested = queue_->size(slot);
+    if (static_cast<size_t>(result) < requested && !eof_submitted_) {
+        // io_uring may return a short read before the end of the file;
+        // finish the block synchronously, and stop reading ahead at the end
+#ifdef BITSHIELD_IO_POSIX
+        long rest = transfer(false, fd_, queue_->buffer(slot) + result, requested - static_cast<size_t>(result),
+                             queue_->offset(slot) + static_cast<uint64_t>(result));
+        if (rest < 0) {
+            io_error(-rest);
+        }
+        result += rest;
+#endif
+        queue_->complete(slot, result);
+        if (static_cast<size_t>(result) < requested) {
+            eof_submitted_ = true;
+        }
+    }
+}
+
+size_t AsyncReader::read(uint8_t* data, size_t size) {
+    size_t done = 0;
+    while (done < size) {
+        wait_slot(current_);
+        size_t available = static_cast<size_t>(queue_->wait(current_));
+        if (consumed_ == available) {
+            if (available < queue_->block_bytes()) {
+                break;  // End of file
+            }
+            // Block used up: refill it behind the others and move on
+            submit(current_);
+            current_ = (current_ + 1) % queue_->depth();
+            consumed_ = 0;
+            continue;
+        }
+        size_t n = available - consumed_ < size - done ? available - consumed_ : size - done;
+        std::memcpy(data + done, queue_->buffer(current_) + consumed_, n);
+        consumed_ += n;
+        done += n;
+    }
+    count_bytes(ByteMove::copied_in, done);
+    count_bytes(ByteMove::staged, done);
+    return done;
+}
+
+AsyncWriter::AsyncWriter(int fd, const IoOptions& options) : queue_(make_queue(options)), fd_(fd) {}
+
+AsyncWriter::~AsyncWriter() = default;
+
+IoBackend AsyncWriter::backend() const {
+    return queue_->backend();
+}
+
+void AsyncWriter::write(const uint8_t* data, size_t size) {
+    count_bytes(ByteMove::staged, size);
+    while (size > 0) {
+        size_t n = size;
+        uint8_t* out = reserve(n);
+        std::memcpy(out, data, n);
+        commit(n);
+        data += n;
+        size -= n;
+    }
+}
+
+uint8_t* AsyncWriter::reserve(size_t& size) {
+    if (filled_ == queue_->block_bytes()) {
+        submit_current();
+    }
+    size_t room = queue_->block_bytes() - filled_;
+    if (size > room) {
+        size = room;
+    }
+    return queue_->buffer(current_) + filled_;
+}
+
+void AsyncWriter::commit(size_t size) {
+    filled_ += size;
+    count_bytes(ByteMove::copied_out, size);
+}
+
+void AsyncWriter::submit_current() {
+    if (filled_ > 0) {
+        queue_->submit(current_, true, fd_, next_offset_, filled_);
+        next_offset_ += filled_;
+        current_ = (current_ + 1) % queue_->depth();
+        filled_ = 0;
+    }
+    // The next slot is reused once its previous write has landed
+    finish_slot(current_);
+}
+
+void AsyncWriter::finish_slot(size_t slot) {
+    size_t requested = queue_->size(slot);
+    long result = queue_->wait(slot);
+    if (result < 0) {
+        io_error(-result);
+    }
+#ifdef BITSHIELD_IO_POSIX
+    if (static_cast<size_t>(result) < requested) {
+        long rest = transfer(true, fd_, queue_->buffer(slot) + result, requested - static_cast<size_t>(result),
+                             queue_->offset(slot) + static_cast<uint64_t>(result));
+        if (rest < 0) {
+            io_error(-rest);
+        }
+    }
+#endif
+    queue_->complete(slot, 0);
+}
+
+void AsyncWriter::flush() {
+    submit_current();
+    for (size_t slot = 0; slot < queue_->depth(); ++slot) {
+        finish_slot(slot);
+    }
+}
+
+} // namespace bitshield::io
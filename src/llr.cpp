@@ -0,0 +1,68 @@
+#include <bitshield/llr.hpp>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include <cstdint>
+
+namespace bitshield::llr {
+
+namespace {
+
+template <typename Llr>
+void hard_decision_impl(util::ConstSpan<Llr> llrs, util::BitSpan bits) {
+    if (bits.size() < llrs.size()) {
+        throw std::invalid_argument("Hard decision output span is too small");
+    }
+    for (size_t i = 0; i < llrs.size(); ++i) {
+        bits[i] = llrs[i] < 0 ? 1 : 0;
+    }
+}
+
+} // anonymous namespace
+
+std::vector<uint8_t> hard_decision(util::ConstSpan<float> llrs) {
+    std::vector<uint8_t> bits(llrs.size());
+    hard_decision_impl(llrs, bits);
+    return bits;
+}
+
+std::vector<uint8_t> hard_decision(util::ConstSpan<int8_t> llrs) {
+    std::vector<uint8_t> bits(llrs.size());
+    hard_decision_impl(llrs, bits);
+    return bits;
+}
+
+void hard_decision(util::ConstSpan<float> llrs, util::BitSpan bits) {
+    hard_decision_impl(llrs, bits);
+}
+
+void hard_decision(util::ConstSpan<int8_t> llrs, util::BitSpan bits) {
+    hard_decision_impl(llrs, bits);
+}
+
+std::vector<int8_t> quantize(util::ConstSpan<float> llrs, float scale) {
+    if (!(scale > 0.0f)) {
+        throw std::invalid_argument("LLR quantisation scale must be > 0");
+    }
+    
+    std::vector<int8_t> out(llrs.size());
+    for (size_t i = 0; i < llrs.size(); ++i) {
+        float v = std::nearbyint(llrs[i] * scale);
+        if (std::isnan(v)) {
+            v = 0.0f;  // No information: an erasure
+        }
+        v = v > 127.0f ? 127.0f : (v < -127.0f ? -127.0f : v);
+        out[i] = static_cast<int8_t>(v);
+    }
+    return out;
+}
+
+std::vector<float> from_bits(util::ConstBitSpan bits, float magnitude) {
+    std::vector<float> llrs(bits.size());
+    for (size_t i = 0; i < bits.size(); ++i) {
+        llrs[i] = bits[i] ? -magnitude : magnitude;
+    }
+    return llrs;
+}
+
+} // namespace bitshield::llr
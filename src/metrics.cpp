@@ -3,10 +3,17 @@
 #include <vector>
 #include <cstdint>
 #include <chrono>
+#include <fstream>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BITSHIELD_METRICS_RUSAGE 1
+#include <sys/resource.h>
+#endif
 
 namespace bitshield::metrics {
 
-double calculate_ber(const std::vector<uint8_t>& original, const std::vector<uint8_t>& received) {
+double calculate_ber(util::ConstBitSpan original, util::ConstBitSpan received) {
     if (original.size() != received.size()) {
         throw std::invalid_argument("Bit vectors must have the same size for BER calculation");
     }
@@ -25,7 +32,7 @@ double calculate_ber(const std::vector<uint8_t>& original, const std::vector<uin
     return static_cast<double>(errors) / original.size();
 }
 
-double calculate_success_rate(const std::vector<uint8_t>& original, const std::vector<uint8_t>& received) {
+double calculate_success_rate(util::ConstBitSpan original, util::ConstBitSpan received) {
     if (original.size() != received.size()) {
         throw std::invalid_argument("Bit vectors must have the same size for success rate calculation");
     }
@@ -45,6 +52,69 @@ double calculate_success_rate(const std::vector<uint8_t>& original, const std::v
     return match ? 1.0 : 0.0;
 }
 
+double ChannelStats::error_rate() const {
+    return bits == 0 ? 0.0 : static_cast<double>(errors) / bits;
+}
+
+double ChannelStats::erasure_rate() const {
+    return bits == 0 ? 0.0 : static_cast<double>(erasures) / bits;
+}
+
+ChannelStats channel_stats(
+    util::ConstBitSpan sent,
+    util::ConstBitSpan received,
+    util::PackedBitSpan erasures
+) {
+    if (sent.size() != received.size()) {
+        throw std::invalid_argument("Bit vectors must have the same size for channel statistics");
+    }
+    if (!erasures.empty() && erasures.size() < sent.size()) {
+        throw std::invalid_argument("Erasure mask is shorter than the bit vector");
+    }
+    
+    ChannelStats stats;
+    stats.bits = sent.size();
+    for (size_t i = 0; i < sent.size(); ++i) {
+        bool erased = !erasures.empty() && erasures[i];
+        if (erased) {
+            stats.erasures++;
+        } else if (sent[i] != received[i]) {
+            stats.errors++;
+        }
+    }
+    
+    return stats;
+}
+
+size_t peak_rss_bytes() {
+    // VmHWM follows reset_peak_rss(); ru_maxrss never decreases
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            return static_cast<size_t>(std::stoull(line.substr(6))) * 1024;
+        }
+    }
+#ifdef BITSHIELD_METRICS_RUSAGE
+    struct rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+        return static_cast<size_t>(usage.ru_maxrss);
+#else
+        return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+    }
+#endif
+    return 0;
+}
+
+bool reset_peak_rss() {
+    std::ofstream clear("/proc/self/clear_refs");
+    clear << "5";
+    clear.flush();
+    return static_cast<bool>(clear);
+}
+
 void Timer::start() {
     start_time_ = std::chrono::high_resolution_clock::now();
     running_ = true;
@@ -0,0 +1,18 @@
+#pragma once
+
+// Internal single-bit access to buffers packed MSB-first (as by
+// bits_to_bytes and the channel error masks).
+
+#include <cstdint>
+
+namespace bitshield::packed_bits {
+
+inline uint8_t test_bit(const uint8_t* bytes, uint64_t pos) {
+    return (bytes[pos >> 3] >> (7 - (pos & 7))) & 1;
+}
+
+inline void set_bit(uint8_t* bytes, uint64_t pos) {
+    bytes[pos >> 3] |= static_cast<uint8_t>(0x80u >> (pos & 7));
+}
+
+} // namespace bitshield::packed_bits
@@ -0,0 +1,239 @@
+#include <bitshield/pipeline.hpp>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+namespace bitshield::pipeline {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Pooled buffer travelling reader -> worker -> writer -> reader
+struct Chunk {
+    std::vector<uint8_t> input;
+    std::vector<uint8_t> output;
+};
+
+// Rings of one worker; a null chunk marks the end of the stream
+struct Lane {
+    explicit Lane(size_t depth) : free(depth), in(depth + 1), out(depth + 1) {}
+    
+    SpscRing<Chunk*> free;
+    SpscRing<Chunk*> in;
+    SpscRing<Chunk*> out;
+};
+
+// Thrown out of a wait once another stage has failed
+struct Aborted {};
+
+// Shared failure state: the first exception wins, later stages unwind quietly
+class ErrorState {
+public:
+    void fail(std::exception_ptr error) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error_) {
+            error_ = error;
+        }
+        aborted_.store(true, std::memory_order_release);
+    }
+    
+    bool aborted() const { return aborted_.load(std::memory_order_acquire); }
+    
+    void rethrow() const {
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+    
+private:
+    std::mutex mutex_;
+    std::exception_ptr error_;
+    std::atomic<bool> aborted_{false};
+};
+
+// Retry op until it succeeds. Stages wait on each other for whole chunk
+// times, so after a short spin the waiter yields and then sleeps rather
+// than burning a core.
+template <typename Op>
+void wait_for(Op op, const ErrorState& errors, double& wait_seconds) {
+    if (op()) {
+        return;
+    }
+    Clock::time_point start = Clock::now();
+    for (unsigned spins = 0; !op(); ++spins) {
+        if (errors.aborted()) {
+            wait_seconds += seconds_since(start);
+            throw Aborted{};
+        }
+        if (spins < 64) {
+            continue;
+        } else if (spins < 128) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(20));
+        }
+    }
+    wait_seconds += seconds_since(start);
+}
+
+// Run body on a stage thread, recording its time and routing failures
+template <typename Body>
+void run_stage(Body body, StageStats& stats, ErrorState& errors) {
+    Clock::time_point start = Clock::now();
+    try {
+        body();
+    } catch (const Aborted&) {
+        // Another stage failed first
+    } catch (...) {
+        errors.fail(std::current_exception());
+    }
+    stats.busy_seconds += seconds_since(start) - stats.wait_seconds;
+}
+
+} // anonymous namespace
+
+Stats run(
+    const codec::Codec& codec,
+    codec::ChunkedCoder::Mode mode,
+    const Source& source,
+    const Sink& sink,
+    const Options& options
+) {
+    if (options.workers == 0 || options.depth == 0) {
+        throw std::invalid_argument("Pipeline requires at least one worker and a queue depth > 0");
+    }
+    
+    // Chunks hold whole coding units, so they code independently
+    size_t chunk_bits = codec::ChunkedCoder(codec, mode, options.chunk_bits).chunk_bits();
+    size_t workers = options.workers;
+    
+    std::vector<std::unique_ptr<Lane>> lanes;
+    std::vector<std::unique_ptr<Chunk>> pool;
+    for (size_t w = 0; w < workers; ++w) {
+        lanes.push_back(std::make_unique<Lane>(options.depth));
+        for (size_t i = 0; i < options.depth; ++i) {
+            pool.push_back(std::make_unique<Chunk>());
+            lanes[w]->free.try_push(pool.back().get());
+        }
+    }
+    
+    Stats stats;
+    StageStats reader_stats{"read", 1};
+    std::vector<StageStats> worker_stats(workers, StageStats{"code", 1});
+    StageStats writer_stats{"write", 1};
+    ErrorState errors;
+    Clock::time_point start = Clock::now();
+    
+    std::thread reader([&] {
+        run_stage([&] {
+            std::vector<uint8_t> data;
+            size_t pos = 0;
+            bool exhausted = false;
+            auto fetch = [&] {
+                while (pos == data.size() && !exhausted) {
+                    exhausted = !source(data);
+                    pos = exhausted ? data.size() : 0;
+                }
+                return pos < data.size();
+            };
+            
+            uint64_t sequence = 0;
+            while (fetch()) {
+                Lane& lane = *lanes[sequence % workers];
+                Chunk* chunk = nullptr;
+                wait_for([&] { return lane.free.try_pop(chunk); }, errors, reader_stats.wait_seconds);
+                chunk->input.clear();
+                while ((chunk_bits == 0 || chunk->input.size() < chunk_bits) && fetch()) {
+                    size_t take = data.size() - pos;
+                    if (chunk_bits != 0 && take > chunk_bits - chunk->input.size()) {
+                        take = chunk_bits - chunk->input.size();
+                    }
+                    chunk->input.insert(chunk->input.end(), data.begin() + pos, data.begin() + pos + take);
+                    pos += take;
+                }
+                stats.input_bits += chunk->input.size();
+                wait_for([&] { return lane.in.try_push(chunk); }, errors, reader_stats.wait_seconds);
+                sequence++;
+            }
+            
+            // End markers, starting with the lane the writer reads next
+            for (size_t w = 0; w < workers; ++w) {
+                Lane& lane = *lanes[(sequence + w) % workers];
+                wait_for([&] { return lane.in.try_push(nullptr); }, errors, reader_stats.wait_seconds);
+            }
+        }, reader_stats, errors);
+    });
+    
+    std::vector<std::thread> threads;
+    for (size_t w = 0; w < workers; ++w) {
+        threads.emplace_back([&, w] {
+            run_stage([&] {
+                Lane& lane = *lanes[w];
+                while (true) {
+                    Chunk* chunk = nullptr;
+                    wait_for([&] { return lane.in.try_pop(chunk); }, errors, worker_stats[w].wait_seconds);
+                    if (chunk) {
+                        bool encode = mode == codec::ChunkedCoder::Mode::encode;
+                        const codec::BitTransformInto& into = encode ? codec.encode_into : codec.decode_into;
+                        if (into) {
+                            // The pooled chunk keeps its output capacity between uses
+                            chunk->output.resize(codec::coded_size(codec, chunk->input.size(), encode));
+                            into(chunk->input, chunk->output);
+                        } else {
+                            chunk->output = encode ? codec.encode(chunk->input) : codec.decode(chunk->input);
+                        }
+                    }
+                    wait_for([&] { return lane.out.try_push(chunk); }, errors, worker_stats[w].wait_seconds);
+                    if (!chunk) {
+                        return;
+                    }
+                }
+            }, worker_stats[w], errors);
+        });
+    }
+    
+    // Writer on the calling thread: lanes in turn restore the stream order
+    run_stage([&] {
+        for (uint64_t sequence = 0;; ++sequence) {
+            Lane& lane = *lanes[sequence % workers];
+            Chunk* chunk = nullptr;
+            wait_for([&] { return lane.out.try_pop(chunk); }, errors, writer_stats.wait_seconds);
+            if (!chunk) {
+                return;
+            }
+            if (!chunk->output.empty()) {
+                sink(chunk->output);
+            }
+            stats.chunks++;
+            stats.output_bits += chunk->output.size();
+            wait_for([&] { return lane.free.try_push(chunk); }, errors, writer_stats.wait_seconds);
+        }
+    }, writer_stats, errors);
+    
+    reader.join();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    errors.rethrow();
+    
+    stats.wall_seconds = seconds_since(start);
+    StageStats code_stats{"code", workers};
+    for (const StageStats& w : worker_stats) {
+        code_stats.busy_seconds += w.busy_seconds;
+        code_stats.wait_seconds += w.wait_seconds;
+    }
+    stats.stages = {reader_stats, code_stats, writer_stats};
+    return stats;
+}
+
+} // namespace bitshield::pipeline
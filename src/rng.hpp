@@ -0,0 +1,91 @@
+#pragma once
+
+// Internal random-number primitives shared by the channels, codecs and
+// interleavers. Not installed: the public headers only take seeds.
+//
+// Random patterns must be identical on every platform, so all draws are
+// derived from raw generator output or from the counter hashes below; the
+// std distributions are implementation-defined and are never used.
+
+#include <random>
+#include <cstdint>
+
+namespace bitshield::rng {
+
+/**
+ * splitmix64 finaliser: a bijection on 64-bit words with full avalanche,
+ * used to turn small or correlated seeds into independent keys.
+ */
+inline uint64_t mix64(uint64_t z) {
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * 32-bit integer finaliser (lowbias32): a bijection with full avalanche.
+ */
+inline uint32_t mix32(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+/**
+ * Key of one counter-based stream. Draw n of the stream is
+ * counter_hash(n, k0, k1 ^ mix32(n >> 32)), so any draw can be computed
+ * directly from its index, in any order and on any thread.
+ */
+struct StreamKey {
+    uint32_t k0;
+    uint32_t k1;
+};
+
+inline StreamKey make_key(uint64_t seed) {
+    uint64_t z = mix64(seed);
+    return {static_cast<uint32_t>(z), static_cast<uint32_t>(z >> 32)};
+}
+
+/**
+ * Hash of the low counter word; k1 already folds in the high word. Kept to
+ * 32-bit integer operations so loops over consecutive counters vectorise.
+ */
+inline uint32_t counter_hash(uint32_t counter, uint32_t k0, uint32_t k1) {
+    return mix32(mix32(counter ^ k0) + k1);
+}
+
+/**
+ * Uniform integer in [0, bound) from one 32-bit draw (multiply-shift).
+ */
+inline uint32_t uniform_below(uint32_t draw, uint32_t bound) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(draw) * bound) >> 32);
+}
+
+/**
+ * Uniform integer in [0, bound), bound > 0. 32-bit bounds take one draw and
+ * a multiply-shift; larger bounds (whole multi-gigabit buffers) take a
+ * 64-bit draw with negligible bias.
+ */
+inline uint64_t uniform_below(std::mt19937& rng, uint64_t bound) {
+    if (bound <= 0xFFFFFFFFULL) {
+        return (static_cast<uint64_t>(rng()) * bound) >> 32;
+    }
+    uint64_t hi = rng();
+    uint64_t lo = rng();
+    return ((hi << 32) | lo) % bound;
+}
+
+/**
+ * Uniform draw in (0, 1) with 53 bits of resolution.
+ */
+inline double uniform_open01(std::mt19937& rng) {
+    uint64_t hi = rng() >> 5;
+    uint64_t lo = rng() >> 6;
+    return (static_cast<double>((hi << 26) | lo) + 0.5) / 9007199254740992.0;
+}
+
+} // namespace bitshield::rng
@@ -0,0 +1,885 @@
+#include <bitshield/sim.hpp>
+#include <bitshield/crc.hpp>
+#include "rng.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <cctype>
+
+#if defined(__linux__)
+#define BITSHIELD_SIM_AFFINITY 1
+#include <sched.h>
+#endif
+
+namespace bitshield::sim {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// CPUs in the process affinity mask (all online CPUs where there is none)
+std::vector<int> allowed_cpus() {
+    std::vector<int> cpus;
+#ifdef BITSHIELD_SIM_AFFINITY
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+    if (cpus.empty()) {
+        unsigned count = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned cpu = 0; cpu < count; ++cpu) {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+    }
+    return cpus;
+}
+
+// Parse "nodeN" directory names; -1 for anything else
+int node_number(const std::string& name) {
+    if (name.size() <= 4 || name.compare(0, 4, "node") != 0) {
+        return -1;
+    }
+    for (size_t i = 4; i < name.size(); ++i) {
+        if (!std::isdigit(static_cast<unsigned char>(name[i]))) {
+            return -1;
+        }
+    }
+    return std::stoi(name.substr(4));
+}
+
+// Trials [first, first + count) of one job
+struct Task {
+    size_t job = 0;
+    uint64_t first = 0;
+    uint64_t count = 0;
+};
+
+// Worker results, written once by each worker as it exits
+struct WorkerReport {
+    std::vector<Tally> tallies;     // One per job
+    double busy_seconds = 0.0;
+    double finish_seconds = 0.0;    // Since the start of the run
+    bool pinned = false;
+    uint64_t tasks = 0;
+    uint64_t steals = 0;
+};
+
+constexpr const char* kResultHeader = "bitshield-result";
+constexpr uint64_t kResultVersion = 1;
+
+constexpr uint8_t kCheckpointMagic[4] = {'B', 'S', 'C', 'K'};
+constexpr uint16_t kCheckpointVersion = 2;
+
+uint32_t crc32c(const uint8_t* data, size_t size) {
+    return static_cast<uint32_t>(crc::compute(crc::Algorithm::crc32c, data, size));
+}
+
+void put(std::vector<uint8_t>& out, uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void put_histogram(std::vector<uint8_t>& out, const std::vector<uint64_t>& histogram) {
+    put(out, histogram.size(), 8);
+    for (uint64_t count : histogram) {
+        put(out, count, 8);
+    }
+}
+
+uint64_t get(const uint8_t* data, size_t bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(data[i]) << (8 * i);
+    }
+    return value;
+}
+
+void add_to_histogram(std::vector<uint64_t>& histogram, uint64_t value) {
+    size_t bin = static_cast<size_t>(std::min<uint64_t>(value, Tally::kHistogramBins - 1));
+    if (histogram.size() <= bin) {
+        histogram.resize(bin + 1, 0);
+    }
+    histogram[bin]++;
+}
+
+void merge_histogram(std::vector<uint64_t>& histogram, const std::vector<uint64_t>& other) {
+    if (histogram.size() < other.size()) {
+        histogram.resize(other.size(), 0);
+    }
+    for (size_t i = 0; i < other.size(); ++i) {
+        histogram[i] += other[i];
+    }
+}
+
+// xorshift64 step, used to pick steal victims
+uint64_t next_random(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+} // anonymous namespace
+
+size_t Topology::cpu_count() const {
+    size_t count = 0;
+    for (const Node& node : nodes) {
+        count += node.cpus.size();
+    }
+    return count;
+}
+
+std::vector<int> parse_cpu_list(const std::string& list) {
+    std::vector<int> cpus;
+    std::istringstream iss(list);
+    std::string token;
+    while (std::getline(iss, token, ',')) {
+        token.erase(std::remove_if(token.begin(), token.end(), [](unsigned char c) { return std::isspace(c); }), token.end());
+        if (token.empty()) {
+            continue;
+        }
+        size_t dash = token.find('-');
+        std::string first_str = token.substr(0, dash);
+        std::string last_str = dash == std::string::npos ? first_str : token.substr(dash + 1);
+        auto all_digits = [](const std::string& s) {
+            return !s.empty() && std::all_of(s.begin(), s.end(), [](unsigned char c) { return std::isdigit(c); });
+        };
+        if (!all_digits(first_str) || !all_digits(last_str)) {
+            throw std::invalid_argument("Malformed CPU list: " + list);
+        }
+        int first = std::stoi(first_str);
+        int last = std::stoi(last_str);
+        if (last < first) {
+            throw std::invalid_argument("Malformed CPU list: " + list);
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+Topology detect_topology() {
+    std::vector<int> allowed = allowed_cpus();
+    Topology topology;
+    
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/node", ec)) {
+        int id = node_number(entry.path().filename().string());
+        if (id < 0) {
+            continue;
+        }
+        std::ifstream file(entry.path() / "cpulist");
+        std::string list;
+        if (!file || !std::getline(file, list)) {
+            continue;
+        }
+        Topology::Node node;
+        node.id = id;
+        for (int cpu : parse_cpu_list(list)) {
+            if (std::binary_search(allowed.begin(), allowed.end(), cpu)) {
+                node.cpus.push_back(cpu);
+            }
+        }
+        if (!node.cpus.empty()) {
+            std::sort(node.cpus.begin(), node.cpus.end());
+            topology.nodes.push_back(std::move(node));
+        }
+    }
+    
+    if (topology.nodes.empty()) {
+        topology.nodes.push_back(Topology::Node{0, allowed});
+    }
+    std::sort(topology.nodes.begin(), topology.nodes.end(), [](const Topology::Node& a, const Topology::Node& b) {
+        return a.id < b.id;
+    });
+    return topology;
+}
+
+std::vector<WorkerSlot> place_workers(const Topology& topology, size_t workers, Placement placement) {
+    std::vector<WorkerSlot> slots(workers);
+    if (placement == Placement::none || topology.cpu_count() == 0) {
+        return slots;
+    }
+    
+    if (placement == Placement::pin) {
+        // Compact: worker w takes the w-th CPU counting through node 0 first
+        std::vector<WorkerSlot> cpus;
+        for (size_t n = 0; n < topology.nodes.size(); ++n) {
+            for (int cpu : topology.nodes[n].cpus) {
+                cpus.push_back(WorkerSlot{static_cast<int>(n), cpu});
+            }
+        }
+        for (size_t w = 0; w < workers; ++w) {
+            slots[w] = cpus[w % cpus.size()];
+        }
+        return slots;
+    }
+    
+    // Scatter: consecutive workers go to consecutive nodes, so every node's
+    // memory bandwidth is in use before any node gets a second worker
+    std::vector<size_t> used(topology.nodes.size(), 0);
+    for (size_t w = 0; w < workers; ++w) {
+        size_t n = w % topology.nodes.size();
+        const std::vector<int>& cpus = topology.nodes[n].cpus;
+        slots[w] = WorkerSlot{static_cast<int>(n), cpus[used[n]++ % cpus.size()]};
+    }
+    return slots;
+}
+
+bool pin_current_thread(int cpu) {
+#ifdef BITSHIELD_SIM_AFFINITY
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+uint32_t trial_seed(uint32_t seed, uint64_t trial) {
+    rng::StreamKey key = rng::make_key(seed);
+    uint32_t high = rng::mix32(static_cast<uint32_t>(trial >> 32));
+    return rng::counter_hash(static_cast<uint32_t>(trial), key.k0, key.k1 ^ high);
+}
+
+void Tally::record(uint64_t message_errors, const metrics::ChannelStats& stats) {
+    bit_errors += message_errors;
+    failed_messages += message_errors > 0 ? 1 : 0;
+    channel.bits += stats.bits;
+    channel.errors += stats.errors;
+    channel.erasures += stats.erasures;
+    add_to_histogram(error_histogram, message_errors);
+    add_to_histogram(channel_histogram, stats.errors);
+}
+
+void Tally::merge(const Tally& other) {
+    trials += other.trials;
+    bit_errors += other.bit_errors;
+    failed_messages += other.failed_messages;
+    channel.bits += other.channel.bits;
+    channel.errors += other.channel.errors;
+    channel.erasures += other.channel.erasures;
+    merge_histogram(error_histogram, other.error_histogram);
+    merge_histogram(channel_histogram, other.channel_histogram);
+}
+
+uint64_t Checkpoint::completed_trials() const {
+    uint64_t total = 0;
+    for (const Tally& tally : jobs) {
+        total += tally.trials;
+    }
+    return total;
+}
+
+void save_checkpoint(const Checkpoint& checkpoint, const std::string& path) {
+    std::vector<uint8_t> bytes(kCheckpointMagic, kCheckpointMagic + 4);
+    put(bytes, kCheckpointVersion, 2);
+    put(bytes, 0, 2);
+    put(bytes, checkpoint.fingerprint, 8);
+    put(bytes, checkpoint.batch, 8);
+    put(bytes, checkpoint.jobs.size(), 8);
+    for (size_t j = 0; j < checkpoint.jobs.size(); ++j) {
+        const Tally& tally = checkpoint.jobs[j];
+        put(bytes, j < checkpoint.trials.size() ? checkpoint.trials[j] : 0, 8);
+        put(bytes, tally.trials, 8);
+        put(bytes, tally.bit_errors, 8);
+        put(bytes, tally.failed_messages, 8);
+        put(bytes, tally.channel.bits, 8);
+        put(bytes, tally.channel.errors, 8);
+        put(bytes, tally.channel.erasures, 8);
+        put_histogram(bytes, tally.error_histogram);
+        put_histogram(bytes, tally.channel_histogram);
+    }
+    put(bytes, checkpoint.done.size(), 8);
+    size_t flags = bytes.size();
+    bytes.resize(flags + (checkpoint.done.size() + 7) / 8, 0);
+    for (size_t t = 0; t < checkpoint.done.size(); ++t) {
+        if (checkpoint.done[t]) {
+            bytes[flags + t / 8] |= static_cast<uint8_t>(1u << (t % 8));
+        }
+    }
+    put(bytes, crc32c(bytes.data(), bytes.size()), 4);
+    
+    std::string temp = path + ".tmp";
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        file.flush();
+        if (!file) {
+            throw std::runtime_error("Cannot write checkpoint: " + temp);
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp, path, ec);
+    if (ec) {
+        throw std::runtime_error("Cannot replace checkpoint " + path + ": " + ec.message());
+    }
+}
+
+Checkpoint load_checkpoint(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Cannot open checkpoint: " + path);
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    
+    auto corrupt = [&path](const std::string& what) {
+        return std::runtime_error("Invalid checkpoint " + path + ": " + what);
+    };
+    if (bytes.size() < 8 + 4 || std::memcmp(bytes.data(), kCheckpointMagic, 4) != 0) {
+        throw corrupt("not a checkpoint file");
+    }
+    if (get(bytes.data() + 4, 2) != kCheckpointVersion) {
+        throw corrupt("unsupported version");
+    }
+    size_t size = bytes.size() - 4;
+    if (crc32c(bytes.data(), size) != get(bytes.data() + size, 4)) {
+        throw corrupt("CRC mismatch");
+    }
+    
+    size_t pos = 8;
+    auto take = [&](size_t count) {
+        if (size - pos < count) {
+            throw corrupt("truncated");
+        }
+        uint64_t value = get(bytes.data() + pos, count);
+        pos += count;
+        return value;
+    };
+    
+    Checkpoint checkpoint;
+    checkpoint.fingerprint = take(8);
+    checkpoint.batch = take(8);
+    uint64_t job_count = take(8);
+    if (job_count > (size - pos) / (9 * 8)) {
+        throw corrupt("truncated");
+    }
+    for (uint64_t j = 0; j < job_count; ++j) {
+        checkpoint.trials.push_back(take(8));
+        Tally tally;
+        tally.trials = take(8);
+        tally.bit_errors = take(8);
+        tally.failed_messages = take(8);
+        tally.channel.bits = static_cast<size_t>(take(8));
+        tally.channel.errors = static_cast<size_t>(take(8));
+        tally.channel.erasures = static_cast<size_t>(take(8));
+        for (std::vector<uint64_t>* histogram : {&tally.error_histogram, &tally.channel_histogram}) {
+            uint64_t bins = take(8);
+            if (bins > Tally::kHistogramBins) {
+                throw corrupt("histogram too long");
+            }
+            for (uint64_t b = 0; b < bins; ++b) {
+                histogram->push_back(take(8));
+            }
+        }
+        checkpoint.jobs.push_back(tally);
+    }
+    uint64_t task_count = take(8);
+    if ((task_count + 7) / 8 != size - pos) {
+        throw corrupt("task flags do not match the task count");
+    }
+    checkpoint.done.resize(static_cast<size_t>(task_count));
+    for (size_t t = 0; t < checkpoint.done.size(); ++t) {
+        checkpoint.done[t] = (bytes[pos + t / 8] >> (t % 8)) & 1;
+    }
+    return checkpoint;
+}
+
+Result run_jobs(const std::vector<Job>& jobs, const Options& options) {
+    if (options.workers == 0 || options.batch == 0) {
+        throw std::invalid_argument("Simulation requires at least one worker and a batch size > 0");
+    }
+    
+    // Cut the jobs into tasks
+    std::vector<Task> tasks;
+    for (size_t j = 0; j < jobs.size(); ++j) {
+        for (uint64_t offset = 0; offset < jobs[j].trials; offset += options.batch) {
+            tasks.push_back(Task{j, jobs[j].first + offset, std::min(options.batch, jobs[j].trials - offset)});
+        }
+    }
+    
+    // Progress so far: fresh, or the resumed checkpoint's
+    Checkpoint progress;
+    if (options.resume) {
+        progress = *options.resume;
+        bool same = progress.fingerprint == options.fingerprint && progress.batch == options.batch &&
+                    progress.trials.size() == jobs.size() && progress.jobs.size() == jobs.size() &&
+                    progress.done.size() == tasks.size();
+        for (size_t j = 0; same && j < jobs.size(); ++j) {
+            same = progress.trials[j] == jobs[j].trials;
+        }
+        if (!same) {
+            throw std::invalid_argument("Checkpoint was saved for a different simulation");
+        }
+    } else {
+        progress.fingerprint = options.fingerprint;
+        progress.batch = options.batch;
+        for (const Job& job : jobs) {
+            progress.trials.push_back(job.trials);
+        }
+        progress.jobs.resize(jobs.size());
+        progress.done.assign(tasks.size(), 0);
+    }
+    std::vector<uint64_t> pending;
+    for (uint64_t t = 0; t < tasks.size(); ++t) {
+        if (!progress.done[t]) {
+            pending.push_back(t);
+        }
+    }
+    
+    Topology topology = options.placement == Placement::none ? Topology{} : detect_topology();
+    std::vector<WorkerSlot> slots = place_workers(topology, options.workers, options.placement);
+    size_t workers = options.workers;
+    
+    // Deal the pending tasks in contiguous runs, so a worker mostly runs
+    // consecutive batches of the same job
+    size_t per_worker = (pending.size() + workers - 1) / workers;
+    std::vector<std::unique_ptr<WorkDeque<uint64_t>>> deques;
+    for (size_t w = 0; w < workers; ++w) {
+        deques.push_back(std::make_unique<WorkDeque<uint64_t>>(per_worker));
+        size_t end = std::min(pending.size(), (w + 1) * per_worker);
+        for (size_t i = w * per_worker; i < end; ++i) {
+            deques[w]->push(pending[i]);
+        }
+    }
+    
+    // Per-node copies of each job's reference, made by the first worker to need one
+    size_t copy_count = topology.nodes.size() * jobs.size();
+    std::vector<std::unique_ptr<Reference>> copies(copy_count);
+    std::unique_ptr<std::once_flag[]> copied(new std::once_flag[copy_count]);
+    
+    // Checkpoints copy progress under its mutex; workers only record into it when saving
+    bool recording = !options.checkpoint.empty();
+    std::mutex progress_mutex;
+    
+    std::vector<WorkerReport> reports(workers);
+    std::atomic<bool> halt{false};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    auto fail = [&](std::exception_ptr e) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) {
+            error = e;
+        }
+        halt.store(true, std::memory_order_relaxed);
+    };
+    
+    // Workers still running, so the calling thread can wait with a timeout
+    std::mutex finished_mutex;
+    std::condition_variable finished_cv;
+    size_t running = workers;
+    
+    Clock::time_point start = Clock::now();
+    
+    // Take a task from another worker, trying every victim from a random
+    // one on; give up once all deques are empty
+    auto steal = [&](size_t w, uint64_t& rng, uint64_t& index) {
+        while (!halt.load(std::memory_order_relaxed)) {
+            bool remaining = false;
+            size_t offset = static_cast<size_t>(next_random(rng) % workers);
+            for (size_t k = 0; k < workers; ++k) {
+                size_t victim = (offset + k) % workers;
+                if (victim == w) {
+                    continue;
+                }
+                if (deques[victim]->steal(index)) {
+                    return true;
+                }
+                remaining = remaining || !deques[victim]->empty();
+            }
+            if (!remaining) {
+                break;
+            }
+        }
+        return false;
+    };
+    
+    auto work = [&](size_t w) {
+        Clock::time_point begin = Clock::now();
+        const WorkerSlot& slot = slots[w];
+        // Pin before allocating, so the tallies and arena are placed on this node
+        WorkerReport report;
+        report.pinned = slot.cpu >= 0 && pin_current_thread(slot.cpu);
+        report.tallies.resize(jobs.size());
+        uint64_t rng = 0x9E3779B97F4A7C15ull * (w + 1);
+        try {
+            util::BitArena arena;
+            uint64_t index = 0;
+            while (!halt.load(std::memory_order_relaxed)) {
+                bool own = deques[w]->pop(index);
+                if (!own && !(options.steal && steal(w, rng, index))) {
+                    break;
+                }
+                report.steals += own ? 0 : 1;
+                
+                const Task& task = tasks[index];
+                const Job& job = jobs[task.job];
+                const Reference* local = &job.reference;
+                if (options.placement == Placement::numa && slot.node >= 0) {
+                    size_t c = static_cast<size_t>(slot.node) * jobs.size() + task.job;
+                    std::call_once(copied[c], [&] {
+                        copies[c] = std::make_unique<Reference>(job.reference);
+                    });
+                    local = copies[c].get();
+                }
+                
+                arena.reset();
+                Tally step;
+                for (uint64_t t = task.first; t < task.first + task.count; ++t) {
+                    job.trial(*local, t, arena, step);
+                }
+                step.trials = task.count;
+                report.tallies[task.job].merge(step);
+                report.tasks++;
+                if (recording) {
+                    std::lock_guard<std::mutex> lock(progress_mutex);
+                    progress.done[index] = 1;
+                    progress.jobs[task.job].merge(step);
+                }
+                if (options.stop && options.stop->load(std::memory_order_relaxed)) {
+                    halt.store(true, std::memory_order_relaxed);
+                }
+            }
+        } catch (...) {
+            fail(std::current_exception());
+        }
+        report.busy_seconds = seconds_since(begin);
+        report.finish_seconds = seconds_since(start);
+        reports[w] = std::move(report);
+        
+        std::lock_guard<std::mutex> lock(finished_mutex);
+        running--;
+        finished_cv.notify_one();
+    };
+    
+    auto save = [&] {
+        Checkpoint snapshot;
+        {
+            std::lock_guard<std::mutex> lock(progress_mutex);
+            snapshot = progress;
+        }
+        save_checkpoint(snapshot, options.checkpoint);
+    };
+    
+    std::vector<std::thread> threads;
+    threads.reserve(workers);
+    for (size_t w = 0; w < workers; ++w) {
+        threads.emplace_back(work, w);
+    }
+    
+    // Save checkpoints and watch for a stop request until the workers finish
+    if (recording || options.stop) {
+        Clock::time_point last_save = Clock::now();
+        std::unique_lock<std::mutex> lock(finished_mutex);
+        while (running > 0) {
+            finished_cv.wait_for(lock, std::chrono::milliseconds(50));
+            if (options.stop && options.stop->load(std::memory_order_relaxed)) {
+                halt.store(true, std::memory_order_relaxed);
+            }
+            if (recording && running > 0 && seconds_since(last_save) >= options.checkpoint_seconds) {
+                lock.unlock();
+                try {
+                    save();
+                } catch (...) {
+                    fail(std::current_exception());
+                }
+                last_save = Clock::now();
+                lock.lock();
+            }
+        }
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    
+    if (recording) {
+        try {
+            save();
+        } catch (...) {
+            fail(std::current_exception());
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    
+    Result result;
+    result.wall_seconds = seconds_since(start);
+    result.jobs.resize(jobs.size());
+    if (options.resume) {
+        result.jobs = options.resume->jobs;
+        result.resumed_trials = options.resume->completed_trials();
+        for (const Tally& tally : result.jobs) {
+            result.tally.merge(tally);
+        }
+    }
+    double first_idle = result.wall_seconds;
+    std::map<int, NodeStats> nodes;
+    for (size_t w = 0; w < workers; ++w) {
+        const WorkerReport& report = reports[w];
+        int node = slots[w].node >= 0 ? topology.nodes[slots[w].node].id : -1;
+        NodeStats& stats = nodes[node];
+        stats.node = node;
+        stats.workers++;
+        stats.busy_seconds += report.busy_seconds;
+        for (size_t j = 0; j < jobs.size(); ++j) {
+            result.jobs[j].merge(report.tallies[j]);
+            result.tally.merge(report.tallies[j]);
+            stats.trials += report.tallies[j].trials;
+        }
+        result.pinned_workers += report.pinned ? 1 : 0;
+        result.tasks += report.tasks;
+        result.steals += report.steals;
+        first_idle = std::min(first_idle, report.finish_seconds);
+    }
+    result.complete = result.tasks == pending.size();
+    result.tail_seconds = result.wall_seconds - first_idle;
+    for (const auto& entry : nodes) {
+        result.nodes.push_back(entry.second);
+    }
+    return result;
+}
+
+Result run(const Reference& reference, uint64_t trials, const Trial& trial, const Options& options) {
+    return run_jobs({Job{reference, trials, trial}}, options);
+}
+
+std::pair<uint64_t, uint64_t> shard_range(uint64_t trials, uint32_t index, uint32_t count) {
+    if (count == 0 || index >= count) {
+        throw std::invalid_argument("Shard index must be below the shard count");
+    }
+    // The first trials % count shards take one extra trial
+    uint64_t base = trials / count;
+    uint64_t extra = trials % count;
+    uint64_t first = base * index + std::min<uint64_t>(index, extra);
+    return {first, first + base + (index < extra ? 1 : 0)};
+}
+
+void save_result(const ShardResult& result, const std::string& path) {
+    if (result.labels.size() != result.jobs.size() || result.trials.size() != result.jobs.size()) {
+        throw std::invalid_argument("Shard result needs one label and trial count per job");
+    }
+    auto single_line = [](const std::string& text) {
+        if (text.find_first_of("\r\n") != std::string::npos) {
+            throw std::invalid_argument("Shard result labels and metadata must fit on one line");
+        }
+    };
+    
+    std::ostringstream out;
+    out << kResultHeader << " " << kResultVersion << "\n";
+    out << "fingerprint " << std::hex << result.fingerprint << std::dec << "\n";
+    out << "shards " << result.shard_count;
+    for (uint32_t shard : result.shards) {
+        out << " " << shard;
+    }
+    out << "\n";
+    out << "seconds " << std::setprecision(17) << result.seconds << "\n";
+    for (const auto& [key, value] : result.metadata) {
+        single_line(value);
+        if (key.empty() || key.find_first_of(" \t\r\n") != std::string::npos) {
+            throw std::invalid_argument("Shard result metadata keys must be single words");
+        }
+        out << "meta " << key << " " << value << "\n";
+    }
+    auto histogram = [&out](const char* name, const std::vector<uint64_t>& bins) {
+        out << name << " " << bins.size();
+        for (uint64_t count : bins) {
+            out << " " << count;
+        }
+        out << "\n";
+    };
+    for (size_t j = 0; j < result.jobs.size(); ++j) {
+        const Tally& tally = result.jobs[j];
+        single_line(result.labels[j]);
+        out << "job " << result.trials[j] << " " << result.labels[j] << "\n";
+        out << "tally " << tally.trials << " " << tally.bit_errors << " " << tally.failed_messages << " "
+            << tally.channel.bits << " " << tally.channel.errors << " " << tally.channel.erasures << "\n";
+        histogram("error-histogram", tally.error_histogram);
+        histogram("channel-histogram", tally.channel_histogram);
+    }
+    
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << out.str();
+    file.flush();
+    if (!file) {
+        throw std::runtime_error("Cannot write result file: " + path);
+    }
+}
+
+ShardResult load_result(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Cannot open result file: " + path);
+    }
+    
+    size_t line_number = 0;
+    auto malformed = [&](const std::string& what) {
+        return std::runtime_error("Invalid result file " + path + " (line " + std::to_string(line_number) + "): " + what);
+    };
+    
+    ShardResult result;
+    std::string line;
+    bool header = false;
+    bool have_tally = false;
+    while (std::getline(file, line)) {
+        ++line_number;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        std::istringstream fields(line);
+        std::string key;
+        if (!(fields >> key)) {
+            continue;
+        }
+        // Rest of the line after one separating space
+        auto rest = [&]() {
+            std::string text;
+            std::getline(fields, text);
+            return text.empty() ? text : text.substr(1);
+        };
+        auto number = [&]() {
+            uint64_t value = 0;
+            if (!(fields >> value)) {
+                throw malformed("expected a number after " + key);
+            }
+            return value;
+        };
+        
+        if (!header) {
+            uint64_t version = 0;
+            if (key != kResultHeader || !(fields >> version)) {
+                throw malformed("not a result file");
+            }
+            if (version != kResultVersion) {
+                throw malformed("unsupported version");
+            }
+            header = true;
+        } else if (key == "fingerprint") {
+            if (!(fields >> std::hex >> result.fingerprint >> std::dec)) {
+                throw malformed("bad fingerprint");
+            }
+        } else if (key == "shards") {
+            result.shard_count = static_cast<uint32_t>(number());
+            uint32_t shard = 0;
+            while (fields >> shard) {
+                if (shard >= result.shard_count) {
+                    throw malformed("shard outside the shard count");
+                }
+                result.shards.push_back(shard);
+            }
+        } else if (key == "seconds") {
+            if (!(fields >> result.seconds)) {
+                throw malformed("bad time");
+            }
+        } else if (key == "meta") {
+            std::string name;
+            fields >> name;
+            result.metadata.emplace_back(name, rest());
+        } else if (key == "job") {
+            if (!result.jobs.empty() && !have_tally) {
+                throw malformed("job without a tally");
+            }
+            result.trials.push_back(number());
+            result.labels.push_back(rest());
+            result.jobs.emplace_back();
+            have_tally = false;
+        } else if (key == "tally" || key == "error-histogram" || key == "channel-histogram") {
+            if (result.jobs.empty()) {
+                throw malformed(key + " before the first job");
+            }
+            Tally& tally = result.jobs.back();
+            if (key == "tally") {
+                tally.trials = number();
+                tally.bit_errors = number();
+                tally.failed_messages = number();
+                tally.channel.bits = static_cast<size_t>(number());
+                tally.channel.errors = static_cast<size_t>(number());
+                tally.channel.erasures = static_cast<size_t>(number());
+                have_tally = true;
+            } else {
+                std::vector<uint64_t>& bins = key == "error-histogram" ? tally.error_histogram : tally.channel_histogram;
+                uint64_t count = number();
+                if (count > Tally::kHistogramBins) {
+                    throw malformed("histogram too long");
+                }
+                bins.clear();
+                for (uint64_t b = 0; b < count; ++b) {
+                    bins.push_back(number());
+                }
+            }
+        } else {
+            throw malformed("unknown entry " + key);
+        }
+    }
+    
+    if (!header) {
+        throw malformed("not a result file");
+    }
+    if (!result.jobs.empty() && !have_tally) {
+        throw malformed("job without a tally");
+    }
+    std::sort(result.shards.begin(), result.shards.end());
+    if (std::adjacent_find(result.shards.begin(), result.shards.end()) != result.shards.end()) {
+        throw malformed("shard listed twice");
+    }
+    return result;
+}
+
+ShardResult merge_results(const std::vector<ShardResult>& results) {
+    if (results.empty()) {
+        throw std::invalid_argument("Nothing to merge");
+    }
+    ShardResult merged = results.front();
+    for (size_t r = 1; r < results.size(); ++r) {
+        const ShardResult& other = results[r];
+        if (other.fingerprint != merged.fingerprint || other.shard_count != merged.shard_count ||
+            other.metadata != merged.metadata || other.labels != merged.labels || other.trials != merged.trials ||
+            other.jobs.size() != merged.jobs.size()) {
+            throw std::invalid_argument("Shard results come from different simulations");
+        }
+        for (uint32_t shard : other.shards) {
+            if (std::binary_search(merged.shards.begin(), merged.shards.end(), shard)) {
+                throw std::invalid_argument("Shard " + std::to_string(shard) + " appears in more than one result");
+            }
+        }
+        merged.shards.insert(merged.shards.end(), other.shards.begin(), other.shards.end());
+        std::sort(merged.shards.begin(), merged.shards.end());
+        merged.seconds += other.seconds;
+        for (size_t j = 0; j < merged.jobs.size(); ++j) {
+            merged.jobs[j].merge(other.jobs[j]);
+        }
+    }
+    return merged;
+}
+
+} // namespace bitshield::sim
@@ -0,0 +1,144 @@
+#include "doctest.h"
+#include "test_helpers.hpp"
+#include <bitshield/arena.hpp>
+#include <bitshield/codecs/codec.hpp>
+#include <bitshield/bitstream.hpp>
+#include <bitshield/llr.hpp>
+#include <bitshield/metrics.hpp>
+#include <memory_resource>
+#include <vector>
+#include <cstdint>
+
+using bitshield::test::bit_pattern;
+
+TEST_CASE("Arena - counting resource tracks calls and live bytes") {
+    bitshield::util::CountingResource counting;
+    void* a = counting.allocate(100, 8);
+    void* b = counting.allocate(50, 8);
+    counting.deallocate(a, 100, 8);
+    CHECK(counting.allocations() == 2);
+    CHECK(counting.bytes() == 150);
+    CHECK(counting.live_bytes() == 50);
+    CHECK(counting.peak_bytes() == 150);
+    
+    counting.reset_counts();
+    CHECK(counting.allocations() == 0);
+    CHECK(counting.peak_bytes() == 50);
+    counting.deallocate(b, 50, 8);
+    CHECK(counting.live_bytes() == 0);
+}
+
+TEST_CASE("Arena - reset reuses the buffer and grows it after overflow") {
+    bitshield::util::CountingResource upstream;
+    bitshield::util::BitArena arena(1024, &upstream);
+    CHECK(upstream.allocations() == 1);
+    
+    bitshield::util::BitSpan first = arena.bits(300);
+    bitshield::util::BitSpan second = arena.bits(300);
+    CHECK(first.size() == 300);
+    CHECK(second.data() >= first.data() + 300);
+    CHECK(arena.used() == 600);
+    arena.reset();
+    CHECK(arena.used() == 0);
+    CHECK(upstream.allocations() == 1);
+    
+    // A batch larger than the buffer overflows once, then fits after reset
+    for (int batch = 0; batch < 3; ++batch) {
+        upstream.reset_counts();
+        for (int i = 0; i < 10; ++i) {
+            arena.bits(500);
+        }
+        size_t overflow_calls = upstream.allocations();
+        arena.reset();
+        if (batch == 0) {
+            CHECK(overflow_calls > 0);
+            CHECK(arena.capacity() >= 5000);
+        } else {
+            CHECK(upstream.allocations() == 0);
+        }
+    }
+}
+
+TEST_CASE("Arena - pmr containers allocate from the arena") {
+    bitshield::util::CountingResource upstream;
+    bitshield::util::BitArena arena(4096, &upstream);
+    upstream.reset_counts();
+    
+    std::pmr::vector<uint8_t> bits(arena.resource());
+    bits.assign(1000, 1);
+    CHECK(upstream.allocations() == 0);
+}
+
+TEST_CASE("Arena - codec results in arena storage match the vector API") {
+    bitshield::interleaver::Spec block{bitshield::interleaver::Kind::block, 4, 7, 0};
+    std::vector<bitshield::codec::Codec> codecs = {
+        bitshield::codec::make_repetition(3),
+        bitshield::codec::make_hamming74(),
+        bitshield::codec::make_product(),
+        bitshield::codec::make_interleaved(bitshield::codec::make_hamming74(), block),
+        bitshield::codec::make_concatenated(bitshield::codec::make_repetition(3), bitshield::codec::make_hamming74(), 8)
+    };
+    
+    std::vector<uint8_t> data = bit_pattern(301);
+    bitshield::util::BitArena arena;
+    for (const auto& codec : codecs) {
+        CAPTURE(codec.name);
+        std::vector<uint8_t> encoded = codec.encode(data);
+        bitshield::util::BitSpan arena_encoded = bitshield::codec::encode(codec, data, arena);
+        CHECK(bitshield::util::ConstBitSpan(arena_encoded).to_vector() == encoded);
+        
+        bitshield::util::BitSpan arena_decoded = bitshield::codec::decode(codec, arena_encoded, arena);
+        CHECK(bitshield::util::ConstBitSpan(arena_decoded).to_vector() == codec.decode(encoded));
+        arena.reset();
+    }
+    
+    // The interleaved wrapper has no into-form; the others do
+    CHECK(codecs[1].decode_into);
+    CHECK(codecs[4].decode_into);
+    CHECK_FALSE(codecs[3].decode_into);
+}
+
+TEST_CASE("Arena - soft and erasure decodes in arena storage match the vector API") {
+    bitshield::interleaver::Spec block{bitshield::interleaver::Kind::block, 4, 7, 0};
+    std::vector<bitshield::codec::Codec> codecs = {
+        bitshield::codec::make_repetition(3),
+        bitshield::codec::make_hamming74(),
+        bitshield::codec::make_product(),
+        bitshield::codec::make_interleaved(bitshield::codec::make_hamming74(), block)
+    };
+    
+    std::vector<uint8_t> data = bit_pattern(304);
+    bitshield::util::BitArena arena;
+    for (const auto& codec : codecs) {
+        CAPTURE(codec.name);
+        std::vector<uint8_t> encoded = codec.encode(data);
+        std::vector<float> llrs = bitshield::llr::from_bits(encoded, 2.0f);
+        for (size_t i = 0; i < llrs.size(); i += 11) {
+            llrs[i] = -0.5f * llrs[i];
+        }
+        bitshield::util::BitSpan soft = bitshield::codec::decode_llr(codec, llrs, arena);
+        CHECK(bitshield::util::ConstBitSpan(soft).to_vector() == bitshield::codec::decode_llr(codec, llrs));
+        
+        std::vector<uint8_t> erasures = bitshield::util::bits_to_bytes(bit_pattern(encoded.size()));
+        std::vector<uint8_t> received = bitshield::llr::hard_decision(llrs);
+        bitshield::util::BitSpan erased = bitshield::codec::decode_with_erasures(codec, received, erasures, arena);
+        CHECK(bitshield::util::ConstBitSpan(erased).to_vector()
+              == bitshield::codec::decode_with_erasures(codec, received, erasures));
+        CHECK_THROWS_AS(bitshield::codec::decode_with_erasures(codec, received, std::vector<uint8_t>{0}, arena),
+                        std::invalid_argument);
+        arena.reset();
+    }
+    
+    // Only the unwrapped repetition and Hamming codecs decode soft input in place
+    CHECK(codecs[0].decode_soft_into);
+    CHECK(codecs[1].decode_erasures_into);
+    CHECK_FALSE(codecs[2].decode_soft);
+    CHECK_FALSE(codecs[3].decode_soft_into);
+}
+
+TEST_CASE("Arena - peak RSS is reported") {
+#ifdef __linux__
+    CHECK(bitshield::metrics::peak_rss_bytes() > 0);
+#endif
+    bitshield::metrics::reset_peak_rss();
+}
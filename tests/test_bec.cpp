@@ -0,0 +1,134 @@
+#include "doctest.h"
+#include <bitshield/channels/bec.hpp>
+#include <bitshield/codecs/repetition.hpp>
+#include <bitshield/codecs/hamming74.hpp>
+#include <bitshield/codecs/codec.hpp>
+#include <bitshield/interleaver.hpp>
+#include <bitshield/bitstream.hpp>
+#include <bitshield/metrics.hpp>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+TEST_CASE("BEC - erasure mask density and determinism") {
+    const size_t nbits = 500000;
+    std::vector<uint8_t> mask = bitshield::channel::erasure_mask(nbits, 0.1, 42);
+    
+    CHECK(mask.size() == (nbits + 7) / 8);
+    CHECK(mask == bitshield::channel::erasure_mask(nbits, 0.1, 42));
+    
+    std::vector<uint8_t> zeros(nbits, 0);
+    auto stats = bitshield::metrics::channel_stats(zeros, zeros, mask);
+    CHECK(stats.errors == 0);
+    CHECK(stats.erasure_rate() == doctest::Approx(0.1).epsilon(0.05));
+    
+    CHECK_THROWS_AS(bitshield::channel::erasure_mask(8, 1.5, 1), std::invalid_argument);
+}
+
+TEST_CASE("BEC - apply_erasures clears erased bits") {
+    std::vector<uint8_t> bits = {1, 1, 1, 1, 1, 1, 1, 1, 1, 0};
+    std::vector<uint8_t> erasures = {0b01000001, 0b10000000};
+    
+    CHECK(bitshield::channel::apply_erasures(bits, erasures) == std::vector<uint8_t>{1, 0, 1, 1, 1, 1, 1, 0, 0, 0});
+    CHECK_THROWS_AS(bitshield::channel::apply_erasures(bits, std::vector<uint8_t>{0}), std::invalid_argument);
+}
+
+TEST_CASE("Metrics - channel stats separate errors and erasures") {
+    std::vector<uint8_t> sent = {0, 1, 0, 1, 0, 1, 0, 1};
+    std::vector<uint8_t> received = {1, 1, 0, 0, 0, 1, 0, 0};
+    std::vector<uint8_t> erasures = {0b00010001};  // Positions 3 and 7
+    
+    auto stats = bitshield::metrics::channel_stats(sent, received, erasures);
+    CHECK(stats.bits == 8);
+    CHECK(stats.errors == 1);
+    CHECK(stats.erasures == 2);
+    CHECK(stats.error_rate() == doctest::Approx(0.125));
+    CHECK(stats.erasure_rate() == doctest::Approx(0.25));
+    
+    CHECK(bitshield::metrics::channel_stats(sent, received).errors == 3);
+}
+
+TEST_CASE("Repetition erasure decode - votes over surviving copies") {
+    // Group 0: two copies erased, the surviving 1 decides
+    // Group 1: all copies erased decodes to 0
+    std::vector<uint8_t> received = {0, 0, 1, 0, 0, 0};
+    std::vector<uint8_t> erasures = {0b11011100};
+    
+    CHECK(bitshield::codec::repetition::decode(received, 3) == std::vector<uint8_t>{0, 0});
+    CHECK(bitshield::codec::repetition::decode_erasures(received, erasures, 3) == std::vector<uint8_t>{1, 0});
+    
+    CHECK_THROWS_AS(bitshield::codec::repetition::decode_erasures(received, {}, 3), std::invalid_argument);
+    CHECK_THROWS_AS(bitshield::codec::repetition::decode_erasures(received, erasures, 0), std::invalid_argument);
+}
+
+TEST_CASE("Hamming(7,4) erasure decode - any two erasures per codeword") {
+    for (uint8_t data = 0; data < 16; ++data) {
+        std::vector<uint8_t> bits = {
+            static_cast<uint8_t>((data >> 3) & 1),
+            static_cast<uint8_t>((data >> 2) & 1),
+            static_cast<uint8_t>((data >> 1) & 1),
+            static_cast<uint8_t>(data & 1),
+        };
+        std::vector<uint8_t> codeword = bitshield::codec::hamming74::encode_bits(bits);
+        
+        for (size_t a = 0; a < 7; ++a) {
+            for (size_t b = a; b < 7; ++b) {
+                std::vector<uint8_t> erased(7, 0);
+                erased[a] = 1;
+                erased[b] = 1;
+                std::vector<uint8_t> mask = bitshield::util::bits_to_bytes(erased);
+                std::vector<uint8_t> received = bitshield::channel::apply_erasures(codeword, mask);
+                CHECK(bitshield::codec::hamming74::decode_erasure_bits(received, mask) == bits);
+            }
+        }
+    }
+}
+
+TEST_CASE("Hamming(7,4) erasure decode - unerased codewords still correct one error") {
+    std::vector<uint8_t> bits = {1, 0, 1, 1, 0, 1, 1, 0};
+    std::vector<uint8_t> encoded = bitshield::codec::hamming74::encode_bits(bits);
+    encoded[9] ^= 1;  // Error in the second codeword
+    std::vector<uint8_t> erasures(2, 0);
+    erasures[0] = 0b01000000;  // Erasure in the first codeword
+    
+    CHECK(bitshield::codec::hamming74::decode_erasure_bits(encoded, erasures) == bits);
+    CHECK_THROWS_AS(bitshield::codec::hamming74::decode_erasure_bits(encoded, std::vector<uint8_t>{0}), std::invalid_argument);
+}
+
+TEST_CASE("Codec - decode_with_erasures beats hard decoding on a BEC") {
+    std::vector<uint8_t> data(4000);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>((i * 7 + i / 5) & 1);
+    }
+    
+    bitshield::interleaver::Spec spec;
+    spec.rows = 8;
+    spec.cols = 7;
+    for (const auto& codec : {
+        bitshield::codec::make_repetition(3),
+        bitshield::codec::make_hamming74(),
+        bitshield::codec::make_interleaved(bitshield::codec::make_hamming74(), spec),
+    }) {
+        std::vector<uint8_t> encoded = codec.encode(data);
+        std::vector<uint8_t> erasures = bitshield::channel::erasure_mask(encoded.size(), 0.1, 9);
+        std::vector<uint8_t> received = bitshield::channel::apply_erasures(encoded, erasures);
+        
+        std::vector<uint8_t> hard = codec.decode(received);
+        std::vector<uint8_t> aware = bitshield::codec::decode_with_erasures(codec, received, erasures);
+        hard.resize(data.size());
+        aware.resize(data.size());
+        CHECK(bitshield::metrics::calculate_ber(data, aware) < bitshield::metrics::calculate_ber(data, hard));
+    }
+}
+
+TEST_CASE("Codec - decode_with_erasures falls back to soft decoding") {
+    bitshield::codec::Codec codec = bitshield::codec::make_hamming74();
+    codec.decode_erasures = nullptr;
+    
+    std::vector<uint8_t> bits = {0, 1, 1, 0};
+    std::vector<uint8_t> encoded = codec.encode(bits);
+    std::vector<uint8_t> erasures = {0b00100100};  // Positions 2 and 5
+    std::vector<uint8_t> received = bitshield::channel::apply_erasures(encoded, erasures);
+    
+    CHECK(bitshield::codec::decode_with_erasures(codec, received, erasures) == bits);
+}
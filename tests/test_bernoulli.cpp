@@ -0,0 +1,74 @@
+#include "doctest.h"
+#include "test_helpers.hpp"
+#include <bitshield/channels/bernoulli.hpp>
+#include <bitshield/channel.hpp>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+using bitshield::test::count_set_bits;
+
+TEST_CASE("Bernoulli - flip rate matches p") {
+    const size_t nbits = 200000;
+    for (double p : {0.01, 0.1, 0.3, 0.5, 0.75}) {
+        std::vector<uint8_t> mask = bitshield::channel::bernoulli_mask(nbits, p, 42);
+        REQUIRE(mask.size() == (nbits + 7) / 8);
+        double rate = static_cast<double>(count_set_bits(mask, 0, nbits)) / nbits;
+        CHECK(rate == doctest::Approx(p).epsilon(0.05));
+    }
+}
+
+TEST_CASE("Bernoulli - neighbouring bits are independent") {
+    const size_t nbits = 400000;
+    const double p = 0.2;
+    std::vector<uint8_t> mask = bitshield::channel::bernoulli_mask(nbits, p, 7);
+    
+    size_t pairs = 0;
+    for (size_t i = 0; i + 1 < nbits; ++i) {
+        pairs += ((mask[i / 8] >> (7 - i % 8)) & 1) & ((mask[(i + 1) / 8] >> (7 - (i + 1) % 8)) & 1);
+    }
+    CHECK(static_cast<double>(pairs) / (nbits - 1) == doctest::Approx(p * p).epsilon(0.05));
+}
+
+TEST_CASE("Bernoulli - p = 0 and p = 1 are exact and the tail is untouched") {
+    std::vector<uint8_t> buffer = {0x0F, 0xF0, 0xAA};
+    bitshield::channel::xor_bernoulli_mask(buffer.data(), 13, 0.0, 1);
+    CHECK(buffer == std::vector<uint8_t>{0x0F, 0xF0, 0xAA});
+    
+    bitshield::channel::xor_bernoulli_mask(buffer.data(), 13, 1.0, 1);
+    CHECK(buffer == std::vector<uint8_t>{0xF0, 0x08, 0xAA});
+    
+    // Only the first 13 bits may change for any p
+    for (double p : {0.1, 0.5, 0.9}) {
+        std::vector<uint8_t> ones(40, 0xFF);
+        bitshield::channel::xor_bernoulli_mask(ones.data(), 13, p, 3);
+        CHECK((ones[1] & 0x07) == 0x07);
+        for (size_t i = 2; i < ones.size(); ++i) {
+            CHECK(ones[i] == 0xFF);
+        }
+    }
+}
+
+TEST_CASE("Bernoulli - masks are deterministic prefixes of one stream") {
+    for (double p : {0.05, 0.5}) {
+        std::vector<uint8_t> small = bitshield::channel::bernoulli_mask(1001, p, 9);
+        std::vector<uint8_t> large = bitshield::channel::bernoulli_mask(5000, p, 9);
+        CHECK(small == bitshield::channel::bernoulli_mask(1001, p, 9));
+        CHECK(small != bitshield::channel::bernoulli_mask(1001, p, 10));
+        CHECK(count_set_bits(small, 0, 1001) == count_set_bits(large, 0, 1001));
+        CHECK(std::vector<uint8_t>(large.begin(), large.begin() + 125)
+              == std::vector<uint8_t>(small.begin(), small.begin() + 125));
+    }
+}
+
+TEST_CASE("Bernoulli - apply matches the mask and validates p") {
+    std::vector<uint8_t> bits(999);
+    for (size_t i = 0; i < bits.size(); ++i) {
+        bits[i] = static_cast<uint8_t>((i * 3 + i / 5) & 1);
+    }
+    std::vector<uint8_t> mask = bitshield::channel::bernoulli_mask(bits.size(), 0.25, 11);
+    CHECK(bitshield::channel::apply_bernoulli(bits, 0.25, 11) == bitshield::channel::apply_mask(bits, mask));
+    
+    CHECK_THROWS_AS(bitshield::channel::bernoulli_mask(10, -0.1, 1), std::invalid_argument);
+    CHECK_THROWS_AS(bitshield::channel::bernoulli_mask(10, 1.5, 1), std::invalid_argument);
+}
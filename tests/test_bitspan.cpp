@@ -0,0 +1,102 @@
+#include "doctest.h"
+#include <bitshield/bitspan.hpp>
+#include <bitshield/metrics.hpp>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+namespace {
+
+std::vector<uint8_t> reference_unpack(const std::vector<uint8_t>& bytes, size_t first, size_t count) {
+    std::vector<uint8_t> bits(count);
+    for (size_t i = 0; i < count; ++i) {
+        size_t bit = first + i;
+        bits[i] = (bytes[bit / 8] >> (7 - bit % 8)) & 1;
+    }
+    return bits;
+}
+
+} // anonymous namespace
+
+TEST_CASE("BitSpan - views share the viewed bits") {
+    std::vector<uint8_t> bits = {1, 0, 1, 1, 0, 0, 1};
+    bitshield::util::ConstBitSpan view = bits;
+    CHECK(view.data() == bits.data());
+    CHECK(view.size() == 7);
+    CHECK(view.subspan(2, 3).to_vector() == std::vector<uint8_t>{1, 1, 0});
+    CHECK(view.subspan(7).empty());
+    CHECK_THROWS_AS(view.subspan(5, 3), std::invalid_argument);
+    CHECK_THROWS_AS(view.subspan(8), std::invalid_argument);
+    
+    bitshield::util::BitSpan slice = bitshield::util::BitSpan(bits).subspan(4, 2);
+    slice[0] = 1;
+    CHECK(bits[4] == 1);
+    bitshield::util::ConstBitSpan read_only = slice;
+    CHECK(read_only.data() == bits.data() + 4);
+}
+
+TEST_CASE("BitSpan - metrics compare views") {
+    std::vector<uint8_t> sent = {1, 1, 0, 0, 1, 0, 1, 0};
+    std::vector<uint8_t> received = {0, 1, 0, 1, 1, 0, 1, 0};
+    bitshield::util::ConstBitSpan tail = bitshield::util::ConstBitSpan(sent).subspan(4);
+    CHECK(bitshield::metrics::calculate_ber(tail, bitshield::util::ConstBitSpan(received).subspan(4)) == 0.0);
+    CHECK(bitshield::metrics::calculate_ber(sent, received) == doctest::Approx(0.25));
+    CHECK(bitshield::metrics::channel_stats(sent, received).errors == 2);
+}
+
+TEST_CASE("BitSpan - packed views unpack from any bit offset") {
+    std::vector<uint8_t> bytes(40);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<uint8_t>(i * 97 + 13);
+    }
+    
+    for (size_t first : {0, 1, 7, 8, 13, 64}) {
+        for (size_t count : {0, 1, 6, 8, 33, 200}) {
+            CAPTURE(first);
+            CAPTURE(count);
+            bitshield::util::PackedBitSpan packed(bytes.data(), first, count);
+            std::vector<uint8_t> expected = reference_unpack(bytes, first, count);
+            std::vector<uint8_t> bits(count, 9);
+            packed.unpack(bits);
+            CHECK(bits == expected);
+            if (count > 0) {
+                CHECK(packed[count - 1] == expected[count - 1]);
+            }
+        }
+    }
+    
+    bitshield::util::PackedBitSpan whole(bytes.data(), 3, 100);
+    std::vector<uint8_t> part(10);
+    whole.subspan(50, 10).unpack(part);
+    CHECK(part == reference_unpack(bytes, 53, 10));
+    
+    std::vector<uint8_t> small(9);
+    CHECK_THROWS_AS(whole.subspan(0, 10).unpack(small), std::invalid_argument);
+    CHECK_THROWS_AS(whole.subspan(95, 6), std::invalid_argument);
+}
+
+TEST_CASE("BitSpan - packed bytes and value views") {
+    std::vector<uint8_t> bytes = {0xA5, 0x0F, 0x3C};
+    for (size_t first : {0, 1, 5, 8}) {
+        CAPTURE(first);
+        bitshield::util::PackedBitSpan packed(bytes.data(), first, 24 - first);
+        std::vector<uint8_t> expected = reference_unpack(bytes, first, 24 - first);
+        for (size_t k = 0; 8 * k < packed.size(); ++k) {
+            uint8_t byte = packed.byte(k);
+            for (size_t j = 0; j < 8 && 8 * k + j < packed.size(); ++j) {
+                CHECK(((byte >> (7 - j)) & 1) == expected[8 * k + j]);
+            }
+        }
+    }
+    
+    // A byte vector views all of its bits, as an error or erasure mask
+    bitshield::util::PackedBitSpan mask = bytes;
+    CHECK(mask.size() == 24);
+    CHECK(mask.byte(1) == 0x0F);
+    
+    std::vector<float> llrs = {1.5f, -2.0f, 0.25f};
+    bitshield::util::ConstSpan<float> view = llrs;
+    CHECK(view.data() == llrs.data());
+    CHECK(view.subspan(1, 2)[0] == -2.0f);
+    CHECK_THROWS_AS(view.subspan(2, 2), std::invalid_argument);
+}
@@ -0,0 +1,82 @@
+#include "doctest.h"
+#include "test_helpers.hpp"
+#include <bitshield/bitstream.hpp>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using bitshield::test::byte_pattern;
+
+namespace {
+
+// Per-bit reference conversions, MSB first
+std::vector<uint8_t> reference_expand(const std::vector<uint8_t>& bytes) {
+    std::vector<uint8_t> bits;
+    for (uint8_t byte : bytes) {
+        for (int i = 7; i >= 0; --i) {
+            bits.push_back((byte >> i) & 1);
+        }
+    }
+    return bits;
+}
+
+std::vector<uint8_t> reference_pack(const std::vector<uint8_t>& bits) {
+    std::vector<uint8_t> bytes((bits.size() + 7) / 8, 0);
+    for (size_t i = 0; i < bits.size(); ++i) {
+        bytes[i / 8] |= static_cast<uint8_t>(bits[i] << (7 - i % 8));
+    }
+    return bytes;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Bitstream - known values") {
+    CHECK(bitshield::util::text_to_bits("A") == std::vector<uint8_t>{0, 1, 0, 0, 0, 0, 0, 1});
+    CHECK(bitshield::util::bits_to_text({0, 1, 0, 0, 0, 0, 0, 1, 1, 1}) == "A");
+    CHECK(bitshield::util::bits_to_bytes({1, 0, 1}) == std::vector<uint8_t>{0xA0});
+    CHECK(bitshield::util::bits_to_bytes({}).empty());
+    CHECK(bitshield::util::bits_to_text({1, 1, 1}).empty());
+}
+
+TEST_CASE("Bitstream - conversions match the per-bit reference at every length") {
+    // Lengths around the vector widths exercise the kernels and their tails
+    for (size_t size = 0; size <= 80; ++size) {
+        std::vector<uint8_t> bytes = byte_pattern(size);
+        std::vector<uint8_t> bits = reference_expand(bytes);
+        CHECK(bitshield::util::bytes_to_bits(bytes) == bits);
+        CHECK(bitshield::util::bits_to_bytes(bits) == bytes);
+        
+        std::string text(bytes.begin(), bytes.end());
+        CHECK(bitshield::util::text_to_bits(text) == bits);
+        CHECK(bitshield::util::bits_to_text(bits) == text);
+        
+        // Partial last bytes are zero-padded by bits_to_bytes and dropped by bits_to_text
+        for (size_t extra = 1; extra < 8; ++extra) {
+            std::vector<uint8_t> longer = bits;
+            longer.insert(longer.end(), extra, 1);
+            CHECK(bitshield::util::bits_to_bytes(longer) == reference_pack(longer));
+            CHECK(bitshield::util::bits_to_text(longer) == text);
+        }
+    }
+}
+
+TEST_CASE("Bitstream - into-buffer variants leave the rest of the buffer alone") {
+    std::vector<uint8_t> bytes = byte_pattern(1000);
+    std::vector<uint8_t> bits = reference_expand(bytes);
+    
+    for (size_t offset : {0, 1, 5}) {
+        std::vector<uint8_t> out(bits.size() + 16, 0xEE);
+        bitshield::util::bytes_to_bits(bytes.data() + offset, 100, out.data() + 3);
+        CHECK(std::vector<uint8_t>(out.begin() + 3, out.begin() + 803) ==
+              std::vector<uint8_t>(bits.begin() + 8 * offset, bits.begin() + 8 * offset + 800));
+        CHECK(out[2] == 0xEE);
+        CHECK(out[803] == 0xEE);
+        
+        std::vector<uint8_t> packed(200, 0xEE);
+        bitshield::util::bits_to_bytes(bits.data() + offset, 805, packed.data() + 1);
+        std::vector<uint8_t> expected = reference_pack(std::vector<uint8_t>(bits.begin() + offset, bits.begin() + offset + 805));
+        CHECK(std::vector<uint8_t>(packed.begin() + 1, packed.begin() + 102) == expected);
+        CHECK(packed[0] == 0xEE);
+        CHECK(packed[102] == 0xEE);
+    }
+}
@@ -63,3 +63,28 @@ TEST_CASE("Channel - different seeds produce different results") {
     CHECK(different);
 }
 
+
+TEST_CASE("Channel - apply_mask_in_place corrupts a slice of a buffer") {
+    std::vector<uint8_t> buffer(20, 0);
+    std::vector<uint8_t> mask = {0xA0, 0x40};  // Flip bits 0, 2 and 9 of the slice
+    
+    bitshield::channel::apply_mask_in_place(bitshield::util::BitSpan(buffer).subspan(5, 10), mask);
+    std::vector<uint8_t> expected(20, 0);
+    expected[5] = expected[7] = expected[14] = 1;
+    CHECK(buffer == expected);
+    
+    std::vector<uint8_t> copy = bitshield::channel::apply_mask(bitshield::util::ConstBitSpan(buffer).subspan(5, 10), mask);
+    CHECK(copy == std::vector<uint8_t>(10, 0));
+    
+    CHECK_THROWS_AS(bitshield::channel::apply_mask_in_place(buffer, mask), std::invalid_argument);
+}
+
+TEST_CASE("Channel - apply_mask_in_place accepts a raw mask buffer") {
+    std::vector<uint8_t> bits(12, 1);
+    uint8_t mask[2] = {0x80, 0x10};
+    bitshield::channel::apply_mask_in_place(bits, mask, 2);
+    CHECK(bits[0] == 0);
+    CHECK(bits[11] == 0);
+    CHECK(bits[1] == 1);
+    CHECK_THROWS_AS(bitshield::channel::apply_mask_in_place(bits, mask, 1), std::invalid_argument);
+}
@@ -0,0 +1,199 @@
+#include "doctest.h"
+#include "test_helpers.hpp"
+#include <bitshield/codecs/codec.hpp>
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+using bitshield::test::bit_pattern;
+
+TEST_CASE("Codec - factory builds named codecs") {
+    auto rep = bitshield::codec::make_codec("repetition", 3);
+    CHECK(rep.name == "repetition");
+    CHECK(rep.data_bits == 1);
+    CHECK(rep.code_bits == 3);
+    
+    auto ham = bitshield::codec::make_codec("hamming");
+    CHECK(ham.data_bits == 4);
+    CHECK(ham.code_bits == 7);
+    
+    auto prod = bitshield::codec::make_codec("product");
+    CHECK(prod.data_bits == 16);
+    CHECK(prod.code_bits == 49);
+    
+    std::vector<uint8_t> data = bit_pattern(32);
+    for (const auto& codec : {rep, ham, prod}) {
+        CHECK(codec.decode(codec.encode(data)) == data);
+    }
+    
+    CHECK_THROWS_AS(bitshield::codec::make_codec("unknown"), std::invalid_argument);
+    CHECK_THROWS_AS(bitshield::codec::make_codec("repetition", 0), std::invalid_argument);
+}
+
+TEST_CASE("Concatenated - repetition outer, Hamming inner round-trip") {
+    auto codec = bitshield::codec::make_concatenated(
+        bitshield::codec::make_repetition(3), bitshield::codec::make_hamming74(), 8);
+    
+    // 8 outer codewords of 3 bits = 24 bits = 6 Hamming blocks
+    CHECK(codec.data_bits == 8);
+    CHECK(codec.code_bits == 42);
+    
+    std::vector<uint8_t> data = bit_pattern(40);
+    std::vector<uint8_t> encoded = codec.encode(data);
+    CHECK(encoded.size() % codec.code_bits == 0);
+    CHECK(codec.decode(encoded) == data);
+}
+
+TEST_CASE("Concatenated - frame rounds up to whole inner blocks") {
+    auto codec = bitshield::codec::make_concatenated(
+        bitshield::codec::make_repetition(3), bitshield::codec::make_hamming74(), 2);
+    
+    // 2 codewords x 3 bits = 6 bits is not a multiple of 4, so the frame doubles
+    CHECK(codec.data_bits == 4);
+    CHECK(codec.code_bits == 21);
+    
+    std::vector<uint8_t> data = bit_pattern(5);
+    std::vector<uint8_t> decoded = codec.decode(codec.encode(data));
+    CHECK(decoded.size() == 8);
+    decoded.resize(data.size());
+    CHECK(decoded == data);
+}
+
+TEST_CASE("Concatenated - into-forms match the stage-by-stage encoding") {
+    auto outer = bitshield::codec::make_repetition(3);
+    auto inner = bitshield::codec::make_hamming74();
+    auto codec = bitshield::codec::make_concatenated(outer, inner, 8);
+    REQUIRE(codec.encode_into);
+    REQUIRE(codec.decode_into);
+    
+    // Unaligned input: the last frame is padded with zeros
+    std::vector<uint8_t> data = bit_pattern(37);
+    std::vector<uint8_t> padded = data;
+    padded.resize(40, 0);
+    std::vector<uint8_t> expected =
+        inner.encode(bitshield::interleaver::block_interleave(outer.encode(padded), 8, 3));
+    
+    std::vector<uint8_t> encoded(bitshield::codec::coded_size(codec, data.size(), true), 2);
+    codec.encode_into(data, encoded);
+    CHECK(encoded == expected);
+    CHECK(codec.encode(data) == expected);
+    
+    std::vector<uint8_t> decoded(bitshield::codec::coded_size(codec, encoded.size(), false), 2);
+    codec.decode_into(encoded, decoded);
+    CHECK(decoded == padded);
+    
+    std::vector<uint8_t> short_out(encoded.size() - 1);
+    CHECK_THROWS_AS(codec.encode_into(data, short_out), std::invalid_argument);
+}
+
+TEST_CASE("Concatenated - nested concatenations share scratch safely") {
+    auto inner = bitshield::codec::make_concatenated(
+        bitshield::codec::make_repetition(3), bitshield::codec::make_hamming74(), 2);
+    auto codec = bitshield::codec::make_concatenated(bitshield::codec::make_hamming74(), inner, 4);
+    
+    std::vector<uint8_t> data = bit_pattern(3 * codec.data_bits + 5);
+    std::vector<uint8_t> decoded = codec.decode(codec.encode(data));
+    decoded.resize(data.size());
+    CHECK(decoded == data);
+}
+
+TEST_CASE("Concatenated - interleaver spreads an inner burst across outer codewords") {
+    auto codec = bitshield::codec::make_concatenated(
+        bitshield::codec::make_repetition(3), bitshield::codec::make_hamming74(), 8);
+    
+    std::vector<uint8_t> data = bit_pattern(8);
+    std::vector<uint8_t> encoded = codec.encode(data);
+    
+    // Two errors in one Hamming codeword make it miscorrect all 4 of its
+    // data bits; interleaving leaves at most one bad copy per outer codeword
+    std::vector<uint8_t> corrupted = encoded;
+    corrupted[0] ^= 1;
+    corrupted[1] ^= 1;
+    CHECK(codec.decode(corrupted) == data);
+}
+
+TEST_CASE("Concatenated - invalid input throws") {
+    auto outer = bitshield::codec::make_repetition(3);
+    auto inner = bitshield::codec::make_hamming74();
+    
+    CHECK_THROWS_AS(bitshield::codec::make_concatenated(outer, inner, 0), std::invalid_argument);
+    
+    auto codec = bitshield::codec::make_concatenated(outer, inner, 8);
+    std::vector<uint8_t> wrong_size(41, 0);
+    CHECK_THROWS_AS(codec.decode(wrong_size), std::invalid_argument);
+}
+
+TEST_CASE("Codec - interleaved Hamming corrects a burst") {
+    bitshield::interleaver::Spec spec{bitshield::interleaver::Kind::block, 8, 7, 0};
+    auto codec = bitshield::codec::make_interleaved(bitshield::codec::make_hamming74(), spec);
+    
+    std::vector<uint8_t> data = bit_pattern(32);
+    std::vector<uint8_t> encoded = codec.encode(data);
+    CHECK(codec.decode(encoded) == data);
+    
+    // A burst of 8 channel bits hits 8 different codewords once each
+    std::vector<uint8_t> corrupted = encoded;
+    for (size_t i = 10; i < 18; ++i) {
+        corrupted[i] ^= 1;
+    }
+    CHECK(codec.decode(corrupted) == data);
+}
+
+TEST_CASE("Codec - chunked coding matches whole-buffer coding") {
+    using bitshield::codec::ChunkedCoder;
+    bitshield::interleaver::Spec block{bitshield::interleaver::Kind::block, 6, 7, 0};
+    bitshield::interleaver::Spec conv{bitshield::interleaver::Kind::convolutional, 4, 7, 0};
+    std::vector<bitshield::codec::Codec> codecs = {
+        bitshield::codec::make_repetition(3),
+        bitshield::codec::make_hamming74(),
+        bitshield::codec::make_product(),
+        bitshield::codec::make_interleaved(bitshield::codec::make_hamming74(), block),
+        bitshield::codec::make_interleaved(bitshield::codec::make_hamming74(), conv),
+        bitshield::codec::make_concatenated(bitshield::codec::make_repetition(3), bitshield::codec::make_hamming74(), 4)
+    };
+    
+    std::vector<uint8_t> data = bit_pattern(5003);
+    for (const auto& codec : codecs) {
+        CAPTURE(codec.name);
+        std::vector<uint8_t> whole = codec.encode(data);
+        
+        // Uneven pushes across chunk and codeword edges
+        for (size_t chunk : {1, 100, 1000}) {
+            ChunkedCoder encoder(codec, ChunkedCoder::Mode::encode, chunk);
+            ChunkedCoder decoder(codec, ChunkedCoder::Mode::decode, chunk);
+            std::vector<uint8_t> encoded;
+            std::vector<uint8_t> decoded;
+            for (size_t begin = 0; begin < data.size(); begin += 333) {
+                size_t end = std::min(data.size(), begin + 333);
+                std::vector<uint8_t> part = encoder.push(bitshield::util::ConstBitSpan(data).subspan(begin, end - begin));
+                encoded.insert(encoded.end(), part.begin(), part.end());
+            }
+            std::vector<uint8_t> tail = encoder.finish();
+            encoded.insert(encoded.end(), tail.begin(), tail.end());
+            CHECK(encoded == whole);
+            
+            for (size_t begin = 0; begin < encoded.size(); begin += 517) {
+                size_t end = std::min(encoded.size(), begin + 517);
+                std::vector<uint8_t> part = decoder.push(bitshield::util::ConstBitSpan(encoded).subspan(begin, end - begin));
+                decoded.insert(decoded.end(), part.begin(), part.end());
+            }
+            tail = decoder.finish();
+            decoded.insert(decoded.end(), tail.begin(), tail.end());
+            CHECK(decoded == codec.decode(whole));
+        }
+    }
+}
+
+TEST_CASE("Codec - stream block counts") {
+    bitshield::interleaver::Spec block{bitshield::interleaver::Kind::block, 8, 7, 0};
+    bitshield::interleaver::Spec wide{bitshield::interleaver::Kind::block, 3, 10, 0};
+    bitshield::interleaver::Spec conv{bitshield::interleaver::Kind::convolutional, 4, 7, 0};
+    auto hamming = bitshield::codec::make_hamming74();
+    
+    CHECK(hamming.stream_blocks == 1);
+    CHECK(bitshield::codec::make_interleaved(hamming, block).stream_blocks == 8);
+    CHECK(bitshield::codec::make_interleaved(hamming, wide).stream_blocks == 30);
+    CHECK(bitshield::codec::make_interleaved(hamming, conv).stream_blocks == 0);
+    CHECK(bitshield::codec::make_concatenated(bitshield::codec::make_repetition(3), hamming, 4).stream_blocks == 1);
+}
@@ -0,0 +1,196 @@
+#include "doctest.h"
+#include "test_helpers.hpp"
+#include <bitshield/container.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+using bitshield::test::bit_pattern;
+using bitshield::test::temp_path;
+
+namespace {
+
+void flip_byte(const std::string& path, size_t offset) {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekg(static_cast<std::streamoff>(offset));
+    char c;
+    file.get(c);
+    file.seekp(static_cast<std::streamoff>(offset));
+    file.put(static_cast<char>(c ^ 0x01));
+}
+
+} // anonymous namespace
+
+TEST_CASE("Container - round-trip with codec metadata") {
+    std::string path = temp_path("bitshield_container.bsh");
+    for (size_t count : {0, 1, 7, 8, 9, 1000, 8 * 100 + 5}) {
+        std::vector<uint8_t> bits = bit_pattern(count);
+        bitshield::io::write_container(path, bits, "repetition", {{"n", "5"}, {"interleaver", "block"}}, 16);
+        
+        CHECK(bitshield::io::is_container(path));
+        bitshield::io::ContainerReader reader(path);
+        CHECK(reader.header().version == bitshield::io::kContainerVersion);
+        CHECK(reader.header().codec == "repetition");
+        CHECK(reader.header().parameters == std::vector<std::pair<std::string, std::string>>{{"n", "5"}, {"interleaver", "block"}});
+        CHECK(reader.header().payload_bits == count);
+        CHECK(reader.header().chunk_bytes == 16);
+        CHECK(reader.chunk_count() == ((count + 7) / 8 + 15) / 16);
+        CHECK(reader.read_all() == bits);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Container - random access across chunks") {
+    std::string path = temp_path("bitshield_container_range.bsh");
+    std::vector<uint8_t> bits = bit_pattern(5000);
+    bitshield::io::write_container(path, bits, "hamming", {}, 32);
+    
+    bitshield::io::ContainerReader reader(path);
+    for (uint64_t first : {0, 1, 255, 256, 257, 4000}) {
+        for (uint64_t count : {0, 1, 300, 999}) {
+            std::vector<uint8_t> expected(bits.begin() + first, bits.begin() + first + count);
+            CHECK(reader.read_bits(first, count) == expected);
+        }
+    }
+    CHECK_THROWS_AS(reader.read_bits(4999, 2), std::invalid_argument);
+    
+    // The reusable-vector form unpacks in place from the mapping
+    std::vector<uint8_t> part(7, 1);
+    bitshield::io::reset_copy_stats();
+    reader.read_bits(250, 20, part);
+    CHECK(part == std::vector<uint8_t>(bits.begin() + 250, bits.begin() + 270));
+    CHECK(bitshield::io::copy_stats().copied_in == 0);
+    CHECK(bitshield::io::copy_stats().mapped_in == 64);
+    
+    // A range can also land in the middle of a caller-owned buffer
+    std::vector<uint8_t> buffer(40, 7);
+    reader.read_bits(1003, 20, bitshield::util::BitSpan(buffer).subspan(10, 20));
+    CHECK(std::vector<uint8_t>(buffer.begin() + 10, buffer.begin() + 30) == std::vector<uint8_t>(bits.begin() + 1003, bits.begin() + 1023));
+    CHECK(buffer[9] == 7);
+    CHECK(buffer[30] == 7);
+    CHECK_THROWS_AS(reader.read_bits(0, 21, bitshield::util::BitSpan(buffer).subspan(0, 20)), std::invalid_argument);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Container - corruption is detected") {
+    std::string path = temp_path("bitshield_container_corrupt.bsh");
+    std::vector<uint8_t> bits = bit_pattern(4096);
+    bitshield::io::write_container(path, bits, "hamming", {}, 64);
+    
+    // Header field
+    flip_byte(path, 10);
+    CHECK_THROWS_WITH_AS(bitshield::io::ContainerReader{path}, "Invalid bsh container: header CRC mismatch", std::runtime_error);
+    flip_byte(path, 10);
+    
+    // Payload of the third chunk: opening succeeds, reading that chunk fails
+    // Records are [size][payload][crc]; a terminator, index and footer follow them
+    size_t header_size = std::filesystem::file_size(path) - 32 - 8 * 16 - 4 - 8 * (4 + 64 + 4);
+    flip_byte(path, header_size + 2 * (4 + 64 + 4) + 4 + 5);
+    bitshield::io::ContainerReader reader(path);
+    CHECK(reader.read_bits(0, 2 * 64 * 8) == std::vector<uint8_t>(bits.begin(), bits.begin() + 2 * 64 * 8));
+    CHECK_THROWS_WITH_AS(reader.read_all(), "Invalid bsh container: CRC mismatch in chunk 2", std::runtime_error);
+    
+    // Truncated file
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    CHECK_THROWS_AS(bitshield::io::ContainerReader{path}, std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Container - non-containers are rejected") {
+    std::string path = temp_path("bitshield_container_text.txt");
+    std::ofstream(path) << "0 1 1 0";
+    CHECK(!bitshield::io::is_container(path));
+    CHECK_THROWS_WITH_AS(bitshield::io::ContainerReader{path}, ("Not a bsh container: " + path).c_str(), std::runtime_error);
+    std::filesystem::remove(path);
+    
+    CHECK(!bitshield::io::is_container("/nonexistent/bitshield.bsh"));
+    CHECK_THROWS_AS(bitshield::io::write_container(path, {1}, "hamming", {}, 0), std::invalid_argument);
+}
+
+TEST_CASE("Container - streaming writer and reader") {
+    std::string path = temp_path("bitshield_container_stream.bsh");
+    for (size_t count : {0, 5, 128, 1000, 8 * 48 + 3}) {
+        std::vector<uint8_t> bits = bit_pattern(count);
+        {
+            // Length unknown up front, bits pushed in uneven pieces
+            bitshield::io::ContainerWriter writer(path, "hamming", {{"interleaver", "block"}}, 16);
+            for (size_t begin = 0; begin < count; begin += 13) {
+                size_t end = std::min(count, begin + 13);
+                writer.write(std::vector<uint8_t>(bits.begin() + begin, bits.begin() + end));
+            }
+            writer.finish();
+        }
+        
+        bitshield::io::ContainerReader mapped(path);
+        CHECK(mapped.header().payload_bits == count);
+        CHECK(mapped.read_all() == bits);
+        
+        bitshield::io::InputFile file(path);
+        CHECK(bitshield::io::is_container(file));
+        bitshield::io::ContainerStreamReader reader(file);
+        CHECK(reader.header().codec == "hamming");
+        CHECK(reader.header().payload_bits == bitshield::io::kContainerUnknownLength);
+        std::vector<uint8_t> read;
+        std::vector<uint8_t> part;
+        while (reader.next(part)) {
+            CHECK(part.size() <= 16 * 8);
+            read.insert(read.end(), part.begin(), part.end());
+        }
+        CHECK(reader.header().payload_bits == count);
+        CHECK(read == bits);
+    }
+    
+    // An announced length must be honoured
+    bitshield::io::ContainerWriter writer(path, "hamming", {}, 16, 10);
+    writer.write(bit_pattern(9));
+    CHECK_THROWS_AS(writer.finish(), std::invalid_argument);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Container - streaming reader detects corruption") {
+    std::string path = temp_path("bitshield_container_stream_corrupt.bsh");
+    std::vector<uint8_t> bits = bit_pattern(4096);
+    bitshield::io::write_container(path, bits, "hamming", {}, 64);
+    size_t header_size = std::filesystem::file_size(path) - 32 - 8 * 16 - 4 - 8 * (4 + 64 + 4);
+    flip_byte(path, header_size + 2 * (4 + 64 + 4) + 4 + 9);
+    
+    bitshield::io::InputFile file(path);
+    bitshield::io::ContainerStreamReader reader(file);
+    std::vector<uint8_t> part;
+    // Chunks are held back one record, so chunk 0 is returned before chunk 2 is read
+    CHECK(reader.next(part));
+    CHECK(part == std::vector<uint8_t>(bits.begin(), bits.begin() + 64 * 8));
+    CHECK_THROWS_WITH_AS(reader.next(part), "Invalid bsh container: CRC mismatch in chunk 2", std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Container - footer lengths near 2^64 are rejected") {
+    std::string path = temp_path("bitshield_container_footer_length.bsh");
+    for (uint64_t footer_bits : {~uint64_t{0}, ~uint64_t{0} - 1}) {
+        CAPTURE(footer_bits);
+        // An empty payload of unknown length, so only the footer records it;
+        // the footer's length field is not covered by a CRC
+        {
+            bitshield::io::ContainerWriter writer(path, "hamming", {}, 64);
+            writer.finish();
+        }
+        {
+            std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(static_cast<std::streamoff>(std::filesystem::file_size(path) - 32 + 16));
+            for (int i = 0; i < 8; ++i) {
+                file.put(static_cast<char>(footer_bits >> (8 * i)));
+            }
+        }
+        CHECK_THROWS_AS(bitshield::io::ContainerReader{path}, std::runtime_error);
+        
+        bitshield::io::InputFile file(path);
+        bitshield::io::ContainerStreamReader reader(file);
+        std::vector<uint8_t> part;
+        CHECK_THROWS_AS(while (reader.next(part)) {}, std::runtime_error);
+    }
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,99 @@
+#include "doctest.h"
+#include <bitshield/crc.hpp>
+#include <bitshield/bitstream.hpp>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+namespace {
+
+const bitshield::crc::Algorithm kAlgorithms[] = {
+    bitshield::crc::Algorithm::crc8,
+    bitshield::crc::Algorithm::crc16,
+    bitshield::crc::Algorithm::crc32,
+    bitshield::crc::Algorithm::crc32c,
+    bitshield::crc::Algorithm::crc64,
+};
+
+const bitshield::crc::Implementation kImplementations[] = {
+    bitshield::crc::Implementation::bitwise,
+    bitshield::crc::Implementation::slicing8,
+    bitshield::crc::Implementation::pclmul,
+};
+
+std::vector<uint8_t> check_input() {
+    std::string text = "123456789";
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+} // anonymous namespace
+
+TEST_CASE("CRC - check values for \"123456789\"") {
+    for (auto algo : kAlgorithms) {
+        CHECK(bitshield::crc::compute(algo, check_input()) == bitshield::crc::parameters(algo).check);
+    }
+}
+
+TEST_CASE("CRC - all kernels agree across lengths and alignments") {
+    std::vector<uint8_t> data(1000);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i * 131 + (i >> 3));
+    }
+    
+    for (auto algo : kAlgorithms) {
+        for (size_t offset : {0, 1, 7}) {
+            for (size_t size : {0, 1, 7, 8, 15, 16, 63, 64, 65, 127, 128, 200, 513, 990}) {
+                const uint8_t* p = data.data() + offset;
+                uint64_t expected = bitshield::crc::compute_with(
+                    algo, bitshield::crc::Implementation::bitwise, p, size);
+                for (auto impl : kImplementations) {
+                    if (bitshield::crc::is_available(algo, impl)) {
+                        CHECK(bitshield::crc::compute_with(algo, impl, p, size) == expected);
+                    }
+                }
+                CHECK(bitshield::crc::compute(algo, p, size) == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("CRC - bit vectors match their packed bytes") {
+    std::vector<uint8_t> bits = bitshield::util::text_to_bits("123456789");
+    
+    for (auto algo : kAlgorithms) {
+        CHECK(bitshield::crc::compute_bits(algo, bits) == bitshield::crc::parameters(algo).check);
+    }
+}
+
+TEST_CASE("CRC - partial trailing byte affects the result") {
+    std::vector<uint8_t> bits = {1, 0, 1, 1, 0, 0, 1, 0, 1, 1, 0};
+    std::vector<uint8_t> flipped = bits;
+    flipped.back() ^= 1;
+    
+    for (auto algo : kAlgorithms) {
+        CHECK(bitshield::crc::compute_bits(algo, bits) != bitshield::crc::compute_bits(algo, flipped));
+    }
+}
+
+TEST_CASE("CRC - detects single-bit errors") {
+    std::vector<uint8_t> data(256, 0x5A);
+    
+    for (auto algo : kAlgorithms) {
+        uint64_t clean = bitshield::crc::compute(algo, data);
+        for (size_t bit = 0; bit < data.size() * 8; bit += 37) {
+            std::vector<uint8_t> corrupted = data;
+            corrupted[bit / 8] ^= static_cast<uint8_t>(1 << (bit % 8));
+            CHECK(bitshield::crc::compute(algo, corrupted) != clean);
+        }
+    }
+}
+
+TEST_CASE("CRC - PCLMUL is unavailable for non-32-bit algorithms") {
+    uint8_t byte = 0;
+    
+    CHECK_FALSE(bitshield::crc::is_available(bitshield::crc::Algorithm::crc16, bitshield::crc::Implementation::pclmul));
+    CHECK_THROWS_AS(
+        bitshield::crc::compute_with(bitshield::crc::Algorithm::crc64, bitshield::crc::Implementation::pclmul, &byte, 1),
+        std::invalid_argument);
+}
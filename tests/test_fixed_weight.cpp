@@ -0,0 +1,71 @@
+#include "doctest.h"
+#include "test_helpers.hpp"
+#include <bitshield/channels/fixed_weight.hpp>
+#include <bitshield/codecs/codec.hpp>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+using bitshield::test::count_set_bits;
+
+TEST_CASE("Fixed weight - exact error count per block") {
+    const size_t nbits = 7 * 1000 + 3;
+    for (size_t weight : {0, 1, 2, 3, 7}) {
+        std::vector<uint8_t> mask = bitshield::channel::fixed_weight_mask(nbits, 7, weight, 42);
+        REQUIRE(mask.size() == (nbits + 7) / 8);
+        for (size_t begin = 0; begin + 7 <= nbits; begin += 7) {
+            CHECK(count_set_bits(mask, begin, begin + 7) == weight);
+        }
+        // Trailing partial block of 3 bits
+        CHECK(count_set_bits(mask, 7000, nbits) == (weight < 3 ? weight : 3));
+        CHECK(count_set_bits(mask, nbits, mask.size() * 8) == 0);
+    }
+}
+
+TEST_CASE("Fixed weight - whole-buffer weight and uniform positions") {
+    const size_t nbits = 64;
+    std::vector<size_t> hits(nbits, 0);
+    for (uint32_t seed = 1; seed <= 4000; ++seed) {
+        std::vector<uint8_t> mask = bitshield::channel::fixed_weight_mask(nbits, nbits, 4, seed);
+        CHECK(count_set_bits(mask, 0, nbits) == 4);
+        for (size_t i = 0; i < nbits; ++i) {
+            hits[i] += (mask[i / 8] >> (7 - i % 8)) & 1;
+        }
+    }
+    // Each position is hit 4000 * 4 / 64 = 250 times on average
+    for (size_t h : hits) {
+        CHECK(h > 180);
+        CHECK(h < 320);
+    }
+}
+
+TEST_CASE("Fixed weight - deterministic and validated") {
+    std::vector<uint8_t> bits(700, 0);
+    CHECK(bitshield::channel::apply_fixed_weight(bits, 7, 1, 5) == bitshield::channel::apply_fixed_weight(bits, 7, 1, 5));
+    CHECK(bitshield::channel::apply_fixed_weight(bits, 7, 1, 5) != bitshield::channel::apply_fixed_weight(bits, 7, 1, 6));
+    
+    CHECK_THROWS_AS(bitshield::channel::fixed_weight_mask(10, 0, 0, 1), std::invalid_argument);
+    CHECK_THROWS_AS(bitshield::channel::fixed_weight_mask(10, 7, 8, 1), std::invalid_argument);
+}
+
+TEST_CASE("Fixed weight - Hamming(7,4) corrects every single error and no double error") {
+    bitshield::codec::Codec hamming = bitshield::codec::make_hamming74();
+    std::vector<uint8_t> data(4 * 500);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>((i * 5 + i / 3) & 1);
+    }
+    std::vector<uint8_t> encoded = hamming.encode(data);
+    
+    std::vector<uint8_t> one = hamming.decode(bitshield::channel::apply_fixed_weight(encoded, 7, 1, 3));
+    CHECK(one == data);
+    
+    // A perfect code maps every weight-2 pattern onto a wrong codeword
+    std::vector<uint8_t> two = hamming.decode(bitshield::channel::apply_fixed_weight(encoded, 7, 2, 3));
+    for (size_t block = 0; block < data.size() / 4; ++block) {
+        bool same = true;
+        for (size_t j = 0; j < 4; ++j) {
+            same = same && two[block * 4 + j] == data[block * 4 + j];
+        }
+        CHECK(!same);
+    }
+}
@@ -81,3 +81,44 @@ TEST_CASE("Hamming(7,4) - empty input") {
     CHECK(decoded.empty());
 }
 
+
+TEST_CASE("Hamming(7,4) - correct works in place on strided codewords") {
+    std::vector<uint8_t> codeword = bitshield::codec::hamming74::encode(std::vector<uint8_t>{0, 1, 1, 0});
+    
+    // Interleave the codeword with a filler bit between each codeword bit
+    std::vector<uint8_t> strided(14, 1);
+    for (size_t i = 0; i < 7; ++i) {
+        strided[2 * i] = codeword[i];
+    }
+    
+    CHECK_FALSE(bitshield::codec::hamming74::correct(strided.data(), 2));
+    
+    strided[2 * 4] ^= 1;
+    CHECK(bitshield::codec::hamming74::correct(strided.data(), 2));
+    for (size_t i = 0; i < 7; ++i) {
+        CHECK(strided[2 * i] == codeword[i]);
+        CHECK(strided[2 * i + 1] == 1);
+    }
+}
+
+TEST_CASE("Hamming(7,4) - span forms code slices into caller buffers") {
+    std::vector<uint8_t> data = {1, 0, 1, 1, 0, 0, 1, 0, 1, 1, 1, 0};
+    std::vector<uint8_t> expected = bitshield::codec::hamming74::encode_bits(data);
+    
+    // Encode the middle two nibbles into a reused buffer
+    std::vector<uint8_t> encoded(21, 9);
+    bitshield::codec::hamming74::encode_bits(bitshield::util::ConstBitSpan(data).subspan(4, 8), encoded);
+    CHECK(std::vector<uint8_t>(encoded.begin(), encoded.begin() + 14) == std::vector<uint8_t>(expected.begin() + 7, expected.end()));
+    CHECK(encoded[14] == 9);
+    
+    // Decoding leaves the received bits untouched
+    encoded[3] ^= 1;
+    std::vector<uint8_t> received = encoded;
+    std::vector<uint8_t> decoded(8);
+    bitshield::codec::hamming74::decode_bits(bitshield::util::ConstBitSpan(encoded).subspan(0, 14), decoded);
+    CHECK(decoded == std::vector<uint8_t>(data.begin() + 4, data.end()));
+    CHECK(encoded == received);
+    
+    CHECK_THROWS_AS(bitshield::codec::hamming74::encode_bits(data, bitshield::util::BitSpan(encoded).subspan(1)), std::invalid_argument);
+    CHECK_THROWS_AS(bitshield::codec::hamming74::decode_bits(bitshield::util::ConstBitSpan(encoded).subspan(0, 14), bitshield::util::BitSpan(decoded).subspan(1)), std::invalid_argument);
+}
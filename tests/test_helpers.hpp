@@ -0,0 +1,51 @@
+#pragma once
+
+// Helpers shared by the test files
+
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace bitshield::test {
+
+// Deterministic message bits with no short period, so codeword, block and
+// chunk boundaries all see varied data
+inline std::vector<uint8_t> bit_pattern(size_t count) {
+    std::vector<uint8_t> bits(count);
+    for (size_t i = 0; i < count; ++i) {
+        bits[i] = static_cast<uint8_t>((i * 7 + i / 5) % 3 == 0);
+    }
+    return bits;
+}
+
+// Deterministic bytes covering every byte value
+inline std::vector<uint8_t> byte_pattern(size_t count) {
+    std::vector<uint8_t> bytes(count);
+    for (size_t i = 0; i < count; ++i) {
+        bytes[i] = static_cast<uint8_t>(i * 131 + i / 251);
+    }
+    return bytes;
+}
+
+// Path of a scratch file in the system temporary directory
+inline std::string temp_path(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Bit i of a mask packed MSB-first
+inline bool packed_bit(const std::vector<uint8_t>& mask, size_t i) {
+    return (mask[i / 8] >> (7 - i % 8)) & 1;
+}
+
+// Set bits in [begin, end) of a mask packed MSB-first
+inline size_t count_set_bits(const std::vector<uint8_t>& mask, size_t begin, size_t end) {
+    size_t count = 0;
+    for (size_t i = begin; i < end; ++i) {
+        count += packed_bit(mask, i);
+    }
+    return count;
+}
+
+} // namespace bitshield::test
@@ -0,0 +1,132 @@
+#include "doctest.h"
+#include <bitshield/interleaver.hpp>
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+TEST_CASE("Interleaver - block interleave reads columns") {
+    // 2x3 block: rows [a b c] [d e f] -> columns a d b e c f
+    std::vector<uint8_t> bits = {1, 1, 0, 0, 0, 1};
+    
+    std::vector<uint8_t> out = bitshield::interleaver::block_interleave(bits, 2, 3);
+    CHECK(out == std::vector<uint8_t>{1, 0, 1, 0, 0, 1});
+}
+
+TEST_CASE("Interleaver - block deinterleave inverts interleave") {
+    std::vector<uint8_t> bits;
+    for (int i = 0; i < 100; ++i) {
+        bits.push_back(static_cast<uint8_t>((i * 7) % 3 == 0));
+    }
+    
+    std::vector<uint8_t> out = bitshield::interleaver::block_interleave(bits, 4, 6);
+    CHECK(out.size() == bits.size());
+    CHECK(bitshield::interleaver::block_deinterleave(out, 4, 6) == bits);
+}
+
+TEST_CASE("Interleaver - partial trailing block passes through") {
+    std::vector<uint8_t> bits = {1, 0, 0, 1, 1};
+    
+    std::vector<uint8_t> out = bitshield::interleaver::block_interleave(bits, 2, 2);
+    CHECK(out == std::vector<uint8_t>{1, 0, 0, 1, 1});
+}
+
+TEST_CASE("Interleaver - block interleave into caller storage") {
+    std::vector<uint8_t> bits;
+    for (int i = 0; i < 53; ++i) {
+        bits.push_back(static_cast<uint8_t>((i * 5) % 3 == 0));
+    }
+    
+    std::vector<uint8_t> out(bits.size() + 2, 7);
+    bitshield::interleaver::block_interleave(bits, out, 4, 6);
+    std::vector<uint8_t> expected = bitshield::interleaver::block_interleave(bits, 4, 6);
+    CHECK(std::equal(expected.begin(), expected.end(), out.begin()));
+    CHECK(out[bits.size()] == 7);  // Only bits.size() bits are written
+    
+    std::vector<uint8_t> back(bits.size());
+    bitshield::interleaver::block_deinterleave(expected, back, 4, 6);
+    CHECK(back == bits);
+    
+    std::vector<uint8_t> small(bits.size() - 1);
+    CHECK_THROWS_AS(bitshield::interleaver::block_interleave(bits, small, 4, 6), std::invalid_argument);
+    CHECK_THROWS_AS(bitshield::interleaver::block_deinterleave(bits, small, 4, 6), std::invalid_argument);
+}
+
+TEST_CASE("Interleaver - invalid dimensions throw") {
+    std::vector<uint8_t> bits = {1, 0};
+    
+    CHECK_THROWS_AS(bitshield::interleaver::block_interleave(bits, 0, 2), std::invalid_argument);
+    CHECK_THROWS_AS(bitshield::interleaver::block_deinterleave(bits, 2, 0), std::invalid_argument);
+}
+
+TEST_CASE("Interleaver - helical staggers columns and inverts") {
+    // 3x2 block: column 0 reads rows 0,1,2; column 1 starts at row 1
+    std::vector<uint8_t> bits = {1, 0, 0, 1, 1, 1};
+    
+    std::vector<uint8_t> out = bitshield::interleaver::helical_interleave(bits, 3, 2);
+    CHECK(out == std::vector<uint8_t>{1, 0, 1, 1, 1, 0});
+    CHECK(bitshield::interleaver::helical_deinterleave(out, 3, 2) == bits);
+}
+
+TEST_CASE("Interleaver - random permutation is deterministic and invertible") {
+    std::vector<size_t> perm = bitshield::interleaver::random_permutation(64, 7);
+    CHECK(perm == bitshield::interleaver::random_permutation(64, 7));
+    CHECK(perm != bitshield::interleaver::random_permutation(64, 8));
+    
+    std::vector<size_t> sorted = perm;
+    std::sort(sorted.begin(), sorted.end());
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        CHECK(sorted[i] == i);
+    }
+    
+    std::vector<uint8_t> bits;
+    for (int i = 0; i < 150; ++i) {
+        bits.push_back(static_cast<uint8_t>(i % 3 == 0));
+    }
+    std::vector<uint8_t> out = bitshield::interleaver::random_interleave(bits, 64, 7);
+    CHECK(bitshield::interleaver::random_deinterleave(out, 64, 7) == bits);
+}
+
+TEST_CASE("Interleaver - convolutional spreads bursts and inverts") {
+    std::vector<uint8_t> bits(40, 0);
+    for (size_t i = 0; i < bits.size(); i += 3) {
+        bits[i] = 1;
+    }
+    
+    std::vector<uint8_t> out = bitshield::interleaver::convolutional_interleave(bits, 4, 2);
+    CHECK(out.size() == bits.size() + 3 * 8);
+    CHECK(bitshield::interleaver::convolutional_deinterleave(out, 4, 2) == bits);
+    
+    // A burst of 4 consecutive channel bits lands in 4 different branches,
+    // which are at least branches apart after deinterleaving
+    std::vector<uint8_t> corrupted = out;
+    for (size_t i = 20; i < 24; ++i) {
+        corrupted[i] ^= 1;
+    }
+    std::vector<uint8_t> back = bitshield::interleaver::convolutional_deinterleave(corrupted, 4, 2);
+    std::vector<size_t> errors;
+    for (size_t i = 0; i < bits.size(); ++i) {
+        if (back[i] != bits[i]) {
+            errors.push_back(i);
+        }
+    }
+    for (size_t i = 1; i < errors.size(); ++i) {
+        CHECK(errors[i] - errors[i - 1] >= 4);
+    }
+    
+    CHECK_THROWS_AS(bitshield::interleaver::convolutional_deinterleave(std::vector<uint8_t>(5), 4, 2), std::invalid_argument);
+}
+
+TEST_CASE("Interleaver - spec dispatch round-trips every kind") {
+    std::vector<uint8_t> bits;
+    for (int i = 0; i < 100; ++i) {
+        bits.push_back(static_cast<uint8_t>((i * 5) % 7 < 3));
+    }
+    
+    using bitshield::interleaver::Kind;
+    for (Kind kind : {Kind::block, Kind::helical, Kind::random, Kind::convolutional}) {
+        bitshield::interleaver::Spec spec{kind, 4, 6, 11};
+        std::vector<uint8_t> out = bitshield::interleaver::interleave(bits, spec);
+        CHECK(bitshield::interleaver::deinterleave(out, spec) == bits);
+    }
+}
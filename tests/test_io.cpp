@@ -0,0 +1,192 @@
+#include "doctest.h"
+#include "test_helpers.hpp"
+#include <bitshield/io.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+using bitshield::test::bit_pattern;
+using bitshield::test::temp_path;
+
+namespace {
+
+std::string write_temp(const std::string& name, const std::string& contents) {
+    std::string path = temp_path(name);
+    std::ofstream file(path, std::ios::binary);
+    file << contents;
+    return path;
+}
+
+std::string error_of(const std::string& path) {
+    try {
+        bitshield::io::read_bit_format(path);
+    } catch (const std::runtime_error& e) {
+        return e.what();
+    }
+    return "";
+}
+
+} // anonymous namespace
+
+TEST_CASE("IO - bit format round-trip") {
+    std::string path = temp_path("bitshield_io_roundtrip.txt");
+    for (size_t count : {0, 1, 15, 16, 17, 1000, 4099}) {
+        std::vector<uint8_t> bits = bit_pattern(count);
+        bitshield::io::write_bit_format(path, bits);
+        CHECK(bitshield::io::read_bit_format(path) == bits);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("IO - bit format writer output") {
+    std::string path = temp_path("bitshield_io_writer.txt");
+    auto contents = [&path]() {
+        std::ifstream file(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    };
+    
+    bitshield::io::write_bit_format(path, {});
+    CHECK(contents().empty());
+    bitshield::io::write_bit_format(path, {1});
+    CHECK(contents() == "1");
+    bitshield::io::write_bit_format(path, {1, 0, 1, 1, 0, 0, 1, 0, 1});
+    CHECK(contents() == "1 0 1 1 0 0 1 0 1");
+    
+    // Spans several write chunks
+    std::vector<uint8_t> bits = bit_pattern(100003);
+    bitshield::io::write_bit_format(path, bits);
+    std::string text = contents();
+    REQUIRE(text.size() == 2 * bits.size() - 1);
+    CHECK(text[2 * 50000] == static_cast<char>('0' + bits[50000]));
+    CHECK(text[2 * 50000 + 1] == ' ');
+    CHECK(bitshield::io::read_bit_format(path) == bits);
+    std::filesystem::remove(path);
+    
+    CHECK_THROWS_AS(bitshield::io::write_bit_format("/nonexistent/dir/bits.txt", bits), std::runtime_error);
+}
+
+TEST_CASE("IO - bit format accepts any whitespace layout") {
+    std::vector<uint8_t> bits = bit_pattern(300);
+    std::string text = "  \n";
+    for (size_t i = 0; i < bits.size(); ++i) {
+        text += static_cast<char>('0' + bits[i]);
+        text += i % 11 == 0 ? "\r\n" : (i % 5 == 0 ? "\t  " : " ");
+    }
+    std::string path = write_temp("bitshield_io_spaces.txt", text);
+    CHECK(bitshield::io::read_bit_format(path) == bits);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("IO - invalid tokens report their byte offset") {
+    std::string prefix;
+    for (size_t i = 0; i < 100; ++i) {
+        prefix += "1 ";
+    }
+    
+    std::string path = write_temp("bitshield_io_invalid.txt", prefix + "2 0 1");
+    CHECK(error_of(path) == "Invalid bit format: bits must be 0 or 1 (at byte offset 200)");
+    
+    // Multi-digit tokens are rejected at their second digit, inside and after the vector loop
+    path = write_temp("bitshield_io_invalid.txt", prefix + "10" + prefix);
+    CHECK(error_of(path) == "Invalid bit format: bits must be 0 or 1 (at byte offset 201)");
+    path = write_temp("bitshield_io_invalid.txt", "0 1 x");
+    CHECK(error_of(path) == "Invalid bit format: bits must be 0 or 1 (at byte offset 4)");
+    std::filesystem::remove(path);
+    
+    CHECK_THROWS_AS(bitshield::io::read_bit_format("/nonexistent/bitshield.txt"), std::runtime_error);
+}
+
+TEST_CASE("IO - legacy format reads N and bits") {
+    std::string path = write_temp("bitshield_io_legacy.txt", " 5\n1 0 0 1 1");
+    auto [n, bits] = bitshield::io::read_legacy_format(path);
+    CHECK(n == 5);
+    CHECK(bits == std::vector<uint8_t>{1, 0, 0, 1, 1});
+    
+    path = write_temp("bitshield_io_legacy.txt", "x 1 0");
+    CHECK_THROWS_WITH_AS(
+        bitshield::io::read_legacy_format(path),
+        "Invalid legacy format: cannot read repetition factor N",
+        std::runtime_error
+    );
+    path = write_temp("bitshield_io_legacy.txt", "3 1 0 7");
+    CHECK_THROWS_WITH_AS(
+        bitshield::io::read_legacy_format(path),
+        "Invalid legacy format: bits must be 0 or 1 (at byte offset 6)",
+        std::runtime_error
+    );
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("IO - streaming bit format reader and writer") {
+    std::string path = temp_path("bitshield_io_stream.txt");
+    std::vector<uint8_t> bits = bit_pattern(300000);
+    {
+        bitshield::io::BitFormatWriter writer(path);
+        for (size_t begin = 0; begin < bits.size(); begin += 7001) {
+            size_t end = std::min(bits.size(), begin + 7001);
+            writer.write(std::vector<uint8_t>(bits.begin() + begin, bits.begin() + end));
+        }
+        writer.finish();
+    }
+    CHECK(bitshield::io::read_bit_format(path) == bits);
+    
+    // The input arrives over several reads, with tokens split across buffers
+    bitshield::io::InputFile file(path);
+    bitshield::io::BitFormatReader reader(file);
+    std::vector<uint8_t> read;
+    std::vector<uint8_t> part;
+    size_t reads = 0;
+    while (reader.next(part)) {
+        read.insert(read.end(), part.begin(), part.end());
+        reads++;
+    }
+    CHECK(reads > 1);
+    CHECK(read == bits);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("IO - streaming text writer") {
+    std::string path = temp_path("bitshield_io_text.bin");
+    std::vector<uint8_t> bits = bit_pattern(100005);
+    {
+        // Pieces of odd lengths leave partial bytes between calls
+        bitshield::io::TextWriter writer(path);
+        for (size_t begin = 0; begin < bits.size(); begin += 1003) {
+            size_t end = std::min(bits.size(), begin + 1003);
+            writer.write(std::vector<uint8_t>(bits.begin() + begin, bits.begin() + end));
+        }
+        writer.finish();
+    }
+    
+    // The trailing partial byte is dropped, as by write_text_format
+    std::string whole = temp_path("bitshield_io_text_whole.bin");
+    bitshield::io::write_text_format(whole, bits);
+    CHECK(std::filesystem::file_size(path) == bits.size() / 8);
+    CHECK(bitshield::io::read_text_format(path) == bitshield::io::read_text_format(whole));
+    std::filesystem::remove(path);
+    std::filesystem::remove(whole);
+}
+
+TEST_CASE("IO - streaming legacy reader and peek") {
+    std::string path = write_temp("bitshield_io_stream_legacy.txt", "12\n1 0 1\n1");
+    bitshield::io::InputFile file(path);
+    uint8_t head[3];
+    CHECK(file.peek(head, sizeof(head)) == 3);
+    CHECK(std::string(head, head + 3) == "12\n");
+    
+    bitshield::io::BitFormatReader reader(file, true);
+    std::vector<uint8_t> read;
+    std::vector<uint8_t> part;
+    while (reader.next(part)) {
+        read.insert(read.end(), part.begin(), part.end());
+    }
+    CHECK(reader.count() == 12);
+    CHECK(read == std::vector<uint8_t>{1, 0, 1, 1});
+    std::filesystem::remove(path);
+    
+    CHECK_THROWS_AS(bitshield::io::InputFile{"/nonexistent/bitshield.txt"}, std::runtime_error);
+}
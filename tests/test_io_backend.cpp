@@ -0,0 +1,115 @@
+#include "doctest.h"
+#include "test_helpers.hpp"
+#include <bitshield/io.hpp>
+#include <bitshield/io_backend.hpp>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+using bitshield::test::byte_pattern;
+using bitshield::test::temp_path;
+
+namespace {
+
+// Restores the process-wide I/O options when a test ends
+struct ScopedIoOptions {
+    explicit ScopedIoOptions(const bitshield::io::IoOptions& options) : saved(bitshield::io::io_options()) {
+        bitshield::io::set_io_options(options);
+    }
+    ~ScopedIoOptions() {
+        bitshield::io::set_io_options(saved);
+    }
+    bitshield::io::IoOptions saved;
+};
+
+} // anonymous namespace
+
+TEST_CASE("IO backend - names round-trip") {
+    using bitshield::io::IoBackend;
+    for (IoBackend backend : {IoBackend::blocking, IoBackend::uring, IoBackend::threads}) {
+        CHECK(bitshield::io::parse_backend(bitshield::io::backend_name(backend)) == backend);
+    }
+    CHECK(bitshield::io::is_available(IoBackend::blocking));
+    CHECK_THROWS_AS(bitshield::io::parse_backend("aio"), std::invalid_argument);
+    CHECK_THROWS_AS(bitshield::io::set_io_options({IoBackend::threads, 0, 4}), std::invalid_argument);
+}
+
+TEST_CASE("IO backend - files round-trip on every backend") {
+    using bitshield::io::IoBackend;
+    std::string path = temp_path("bitshield_io_backend.bin");
+    
+    for (IoBackend backend : {IoBackend::blocking, IoBackend::uring, IoBackend::threads}) {
+        if (!bitshield::io::is_available(backend)) {
+            continue;
+        }
+        CAPTURE(bitshield::io::backend_name(backend));
+        // Small blocks so the queue wraps many times; sizes straddle block edges
+        ScopedIoOptions scoped({backend, 4096, 3});
+        for (size_t size : {0, 1, 4095, 4096, 4097, 3 * 4096, 50000}) {
+            std::vector<uint8_t> data = byte_pattern(size);
+            {
+                bitshield::io::OutputFile file(path);
+                for (size_t begin = 0; begin < size; begin += 1000) {
+                    size_t n = size - begin < 1000 ? size - begin : 1000;
+                    file.write(data.data() + begin, n);
+                }
+                file.flush();
+            }
+            CHECK(std::filesystem::file_size(path) == size);
+            
+            bitshield::io::InputFile file(path);
+            std::vector<uint8_t> read(size + 10);
+            size_t got = 0;
+            for (size_t n; (n = file.read(read.data() + got, 777 < read.size() - got ? 777 : read.size() - got)) > 0;) {
+                got += n;
+            }
+            read.resize(got);
+            CHECK(read == data);
+            CHECK(file.read(read.data(), 1) == 0);
+        }
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("IO backend - reserve and commit write in place") {
+    using bitshield::io::IoBackend;
+    std::string path = temp_path("bitshield_io_reserve.bin");
+    std::vector<uint8_t> data = byte_pattern(50000);
+    
+    for (IoBackend backend : {IoBackend::blocking, IoBackend::uring, IoBackend::threads}) {
+        if (!bitshield::io::is_available(backend)) {
+            continue;
+        }
+        CAPTURE(bitshield::io::backend_name(backend));
+        ScopedIoOptions scoped({backend, 4096, 3});
+        bitshield::io::reset_copy_stats();
+        {
+            bitshield::io::OutputFile file(path);
+            for (size_t done = 0; done < data.size();) {
+                size_t size = data.size() - done;
+                uint8_t* out = file.reserve(size);
+                REQUIRE(size > 0);
+                for (size_t i = 0; i < size; ++i) {
+                    out[i] = data[done + i];
+                }
+                file.commit(size);
+                done += size;
+            }
+            file.flush();
+        }
+        
+        // Produced in place: one kernel copy per byte and no staging
+        bitshield::io::CopyStats stats = bitshield::io::copy_stats();
+        CHECK(stats.copied_out == data.size());
+        CHECK(stats.staged == 0);
+        CHECK(stats.copies_per_byte(data.size()) == doctest::Approx(1.0));
+        
+        bitshield::io::InputFile file(path);
+        std::vector<uint8_t> read(data.size());
+        CHECK(file.read(read.data(), read.size()) == data.size());
+        CHECK(read == data);
+    }
+    std::filesystem::remove(path);
+}
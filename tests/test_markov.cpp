@@ -0,0 +1,114 @@
+#include "doctest.h"
+#include "test_helpers.hpp"
+#include <bitshield/channels/markov.hpp>
+#include <bitshield/channel.hpp>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+using bitshield::test::count_set_bits;
+using bitshield::test::packed_bit;
+
+TEST_CASE("Channel - apply_mask flips masked bits") {
+    std::vector<uint8_t> bits = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1};
+    std::vector<uint8_t> mask = {0b10000001, 0b01000000};
+    
+    std::vector<uint8_t> noisy = bitshield::channel::apply_mask(bits, mask);
+    CHECK(noisy == std::vector<uint8_t>{1, 0, 0, 0, 0, 0, 0, 1, 1, 0, 1});
+    
+    CHECK_THROWS_AS(bitshield::channel::apply_mask(bits, std::vector<uint8_t>{0xFF}), std::invalid_argument);
+}
+
+TEST_CASE("Markov - Gilbert-Elliott stationary error rate") {
+    auto ge = bitshield::channel::gilbert_elliott(0.01, 0.1, 0.001, 0.5);
+    
+    std::vector<double> pi = bitshield::channel::stationary_distribution(ge);
+    REQUIRE(pi.size() == 2);
+    CHECK(pi[0] == doctest::Approx(0.1 / 0.11));
+    CHECK(pi[1] == doctest::Approx(0.01 / 0.11));
+    
+    double expected = bitshield::channel::average_error_rate(ge);
+    CHECK(expected == doctest::Approx(pi[0] * 0.001 + pi[1] * 0.5));
+    
+    const size_t nbits = 2000000;
+    std::vector<uint8_t> mask = bitshield::channel::markov_error_mask(ge, nbits, 42);
+    CHECK(mask.size() == nbits / 8);
+    double measured = static_cast<double>(count_set_bits(mask, 0, nbits)) / nbits;
+    CHECK(measured == doctest::Approx(expected).epsilon(0.1));
+}
+
+TEST_CASE("Markov - errors arrive in bursts") {
+    // Same long-run error rate as a BSC, but errors cluster in the bad state
+    auto ge = bitshield::channel::gilbert_elliott(0.001, 0.05, 0.0, 1.0);
+    
+    const size_t nbits = 1000000;
+    std::vector<uint8_t> mask = bitshield::channel::markov_error_mask(ge, nbits, 7);
+    
+    size_t runs = 0;
+    size_t errors = 0;
+    for (size_t i = 0; i < nbits; ++i) {
+        if (packed_bit(mask, i)) {
+            errors++;
+            if (i == 0 || !packed_bit(mask, i - 1)) {
+                runs++;
+            }
+        }
+    }
+    REQUIRE(runs > 0);
+    double mean_burst = static_cast<double>(errors) / runs;
+    CHECK(mean_burst == doctest::Approx(1.0 / 0.05).epsilon(0.15));
+}
+
+TEST_CASE("Markov - deterministic with seed") {
+    auto ge = bitshield::channel::gilbert_elliott(0.02, 0.2, 0.01, 0.3);
+    std::vector<uint8_t> bits(10001, 1);
+    
+    CHECK(bitshield::channel::apply_markov(bits, ge, 5) == bitshield::channel::apply_markov(bits, ge, 5));
+    CHECK(bitshield::channel::apply_markov(bits, ge, 5) != bitshield::channel::apply_markov(bits, ge, 6));
+}
+
+TEST_CASE("Markov - single state matches a binary symmetric channel") {
+    bitshield::channel::MarkovChannel bsc;
+    bsc.transitions = {{1.0}};
+    bsc.error_rates = {0.05};
+    
+    const size_t nbits = 400000;
+    std::vector<uint8_t> mask = bitshield::channel::markov_error_mask(bsc, nbits, 3);
+    CHECK(static_cast<double>(count_set_bits(mask, 0, nbits)) / nbits == doctest::Approx(0.05).epsilon(0.05));
+    
+    // Bits past nbits in the last byte are never set
+    std::vector<uint8_t> ones = bitshield::channel::markov_error_mask({{{1.0}}, {1.0}, 0}, 13, 1);
+    CHECK(ones == std::vector<uint8_t>{0xFF, 0xF8});
+}
+
+TEST_CASE("Markov - three-state chain visits every state") {
+    bitshield::channel::MarkovChannel channel;
+    channel.transitions = {
+        {0.99, 0.01, 0.0},
+        {0.0, 0.9, 0.1},
+        {0.2, 0.0, 0.8},
+    };
+    channel.error_rates = {0.0, 0.1, 1.0};
+    
+    double expected = bitshield::channel::average_error_rate(channel);
+    const size_t nbits = 2000000;
+    std::vector<uint8_t> mask = bitshield::channel::markov_error_mask(channel, nbits, 11);
+    CHECK(static_cast<double>(count_set_bits(mask, 0, nbits)) / nbits == doctest::Approx(expected).epsilon(0.1));
+}
+
+TEST_CASE("Markov - invalid channels throw") {
+    CHECK_THROWS_AS(bitshield::channel::gilbert_elliott(1.5, 0.1, 0.0, 0.5), std::invalid_argument);
+    
+    bitshield::channel::MarkovChannel bad;
+    CHECK_THROWS_AS(bitshield::channel::markov_error_mask(bad, 8, 1), std::invalid_argument);
+    
+    bad.transitions = {{0.5, 0.4}, {0.5, 0.5}};
+    bad.error_rates = {0.0, 0.5};
+    CHECK_THROWS_AS(bitshield::channel::markov_error_mask(bad, 8, 1), std::invalid_argument);
+    
+    bad.transitions = {{1.0, 0.0}, {0.0, 1.0}};
+    CHECK_THROWS_AS(bitshield::channel::stationary_distribution(bad), std::invalid_argument);
+    
+    bad.initial_state = 2;
+    CHECK_THROWS_AS(bitshield::channel::markov_error_mask(bad, 8, 1), std::invalid_argument);
+}
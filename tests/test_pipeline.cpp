@@ -0,0 +1,146 @@
+#include "doctest.h"
+#include "test_helpers.hpp"
+#include <bitshield/pipeline.hpp>
+#include <bitshield/codecs/codec.hpp>
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+using bitshield::test::bit_pattern;
+
+namespace {
+
+// Source handing out bits in pieces of the given size; like the file
+// sources it clears its output at the end of the input
+bitshield::pipeline::Source pieces(const std::vector<uint8_t>& bits, size_t piece) {
+    return [&bits, piece, pos = size_t{0}](std::vector<uint8_t>& out) mutable {
+        if (pos == bits.size()) {
+            out.clear();
+            return false;
+        }
+        size_t end = std::min(bits.size(), pos + piece);
+        out.assign(bits.begin() + pos, bits.begin() + end);
+        pos = end;
+        return true;
+    };
+}
+
+} // anonymous namespace
+
+TEST_CASE("Pipeline - SPSC ring preserves order across threads") {
+    bitshield::pipeline::SpscRing<uint32_t> ring(5);
+    CHECK(ring.capacity() == 8);
+    
+    const uint32_t count = 100000;
+    std::thread producer([&] {
+        for (uint32_t i = 0; i < count; ++i) {
+            while (!ring.try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    bool ordered = true;
+    for (uint32_t expected = 0; expected < count; ++expected) {
+        uint32_t value = 0;
+        while (!ring.try_pop(value)) {
+            std::this_thread::yield();
+        }
+        ordered = ordered && value == expected;
+    }
+    producer.join();
+    CHECK(ordered);
+    
+    uint32_t value = 0;
+    CHECK(!ring.try_pop(value));
+}
+
+TEST_CASE("Pipeline - output matches whole-buffer coding") {
+    using bitshield::codec::ChunkedCoder;
+    bitshield::interleaver::Spec block{bitshield::interleaver::Kind::block, 6, 7, 0};
+    bitshield::interleaver::Spec conv{bitshield::interleaver::Kind::convolutional, 4, 7, 0};
+    std::vector<bitshield::codec::Codec> codecs = {
+        bitshield::codec::make_repetition(5),
+        bitshield::codec::make_hamming74(),
+        bitshield::codec::make_interleaved(bitshield::codec::make_hamming74(), block),
+        bitshield::codec::make_interleaved(bitshield::codec::make_hamming74(), conv)
+    };
+    
+    std::vector<uint8_t> data = bit_pattern(20011);
+    for (const auto& codec : codecs) {
+        CAPTURE(codec.name);
+        std::vector<uint8_t> whole = codec.encode(data);
+        for (size_t workers : {1, 2, 5}) {
+            bitshield::pipeline::Options options;
+            options.workers = workers;
+            options.chunk_bits = 1000;
+            options.depth = 2;
+            
+            std::vector<uint8_t> encoded;
+            auto stats = bitshield::pipeline::run(codec, ChunkedCoder::Mode::encode, pieces(data, 777),
+                [&](const std::vector<uint8_t>& bits) { encoded.insert(encoded.end(), bits.begin(), bits.end()); },
+                options);
+            CHECK(encoded == whole);
+            CHECK(stats.input_bits == data.size());
+            CHECK(stats.output_bits == whole.size());
+            CHECK(stats.stages.size() == 3);
+            CHECK(stats.stages[1].threads == workers);
+            
+            std::vector<uint8_t> decoded;
+            bitshield::pipeline::run(codec, ChunkedCoder::Mode::decode, pieces(encoded, 1234),
+                [&](const std::vector<uint8_t>& bits) { decoded.insert(decoded.end(), bits.begin(), bits.end()); },
+                options);
+            CHECK(decoded == codec.decode(whole));
+        }
+    }
+}
+
+TEST_CASE("Pipeline - empty input produces no output") {
+    std::vector<uint8_t> empty;
+    size_t calls = 0;
+    auto stats = bitshield::pipeline::run(bitshield::codec::make_hamming74(), bitshield::codec::ChunkedCoder::Mode::encode,
+        pieces(empty, 10), [&](const std::vector<uint8_t>&) { calls++; });
+    CHECK(calls == 0);
+    CHECK(stats.chunks == 0);
+}
+
+TEST_CASE("Pipeline - stage failures propagate") {
+    auto hamming = bitshield::codec::make_hamming74();
+    std::vector<uint8_t> data = bit_pattern(50000);
+    bitshield::pipeline::Options options;
+    options.workers = 3;
+    options.chunk_bits = 400;
+    
+    // Sink on the calling thread
+    CHECK_THROWS_WITH_AS(
+        bitshield::pipeline::run(hamming, bitshield::codec::ChunkedCoder::Mode::encode, pieces(data, 100),
+            [](const std::vector<uint8_t>&) { throw std::runtime_error("disk full"); }, options),
+        "disk full", std::runtime_error);
+    
+    // Source on the reader thread
+    size_t reads = 0;
+    CHECK_THROWS_WITH_AS(
+        bitshield::pipeline::run(hamming, bitshield::codec::ChunkedCoder::Mode::encode,
+            [&](std::vector<uint8_t>& bits) {
+                if (++reads == 20) {
+                    throw std::runtime_error("read error");
+                }
+                bits.assign(100, 1);
+                return true;
+            },
+            [](const std::vector<uint8_t>&) {}, options),
+        "read error", std::runtime_error);
+    
+    // Codec on a worker thread (decode needs whole codewords)
+    CHECK_THROWS_AS(
+        bitshield::pipeline::run(hamming, bitshield::codec::ChunkedCoder::Mode::decode, pieces(data, 100),
+            [](const std::vector<uint8_t>&) {}, options),
+        std::invalid_argument);
+    
+    options.workers = 0;
+    CHECK_THROWS_AS(
+        bitshield::pipeline::run(hamming, bitshield::codec::ChunkedCoder::Mode::encode, pieces(data, 100),
+            [](const std::vector<uint8_t>&) {}, options),
+        std::invalid_argument);
+}
@@ -0,0 +1,92 @@
+#include "doctest.h"
+#include "test_helpers.hpp"
+#include <bitshield/codecs/product.hpp>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+using bitshield::test::bit_pattern;
+
+TEST_CASE("Product code - encode/decode round-trip") {
+    std::vector<uint8_t> data = bit_pattern(64);
+    
+    std::vector<uint8_t> encoded = bitshield::codec::product::encode_bits(data);
+    CHECK(encoded.size() == 4 * 49);
+    
+    std::vector<uint8_t> decoded = bitshield::codec::product::decode_bits(encoded);
+    CHECK(decoded == data);
+}
+
+TEST_CASE("Product code - every row and column is a Hamming codeword") {
+    std::vector<uint8_t> encoded = bitshield::codec::product::encode_bits(bit_pattern(16));
+    
+    // Decoding an uncorrupted codeword must not change anything in one pass
+    std::vector<uint8_t> decoded = bitshield::codec::product::decode_bits(encoded, 1);
+    CHECK(decoded == bit_pattern(16));
+}
+
+TEST_CASE("Product code - corrects all double-bit errors") {
+    std::vector<uint8_t> data = bit_pattern(16);
+    std::vector<uint8_t> encoded = bitshield::codec::product::encode_bits(data);
+    
+    for (size_t a = 0; a < 49; ++a) {
+        for (size_t b = a + 1; b < 49; ++b) {
+            std::vector<uint8_t> corrupted = encoded;
+            corrupted[a] ^= 1;
+            corrupted[b] ^= 1;
+            CHECK(bitshield::codec::product::decode_bits(corrupted) == data);
+        }
+    }
+}
+
+TEST_CASE("Product code - iterative decoding fixes a burst within one row") {
+    std::vector<uint8_t> data = bit_pattern(16);
+    std::vector<uint8_t> encoded = bitshield::codec::product::encode_bits(data);
+    
+    // Three errors in row 2 defeat the row decoder; columns then repair them
+    std::vector<uint8_t> corrupted = encoded;
+    corrupted[2 * 7 + 0] ^= 1;
+    corrupted[2 * 7 + 3] ^= 1;
+    corrupted[2 * 7 + 5] ^= 1;
+    
+    CHECK(bitshield::codec::product::decode_bits(corrupted) == data);
+}
+
+TEST_CASE("Product code - pads input that's not multiple of 16") {
+    std::vector<uint8_t> data = {1, 0, 1};
+    
+    std::vector<uint8_t> encoded = bitshield::codec::product::encode_bits(data);
+    CHECK(encoded.size() == 49);
+    
+    std::vector<uint8_t> decoded = bitshield::codec::product::decode_bits(encoded);
+    CHECK(decoded.size() == 16);
+    CHECK(decoded[0] == 1);
+    CHECK(decoded[1] == 0);
+    CHECK(decoded[2] == 1);
+    CHECK(decoded[3] == 0);
+}
+
+TEST_CASE("Product code - invalid input throws") {
+    std::vector<uint8_t> not_multiple_of_49(48, 0);
+    CHECK_THROWS_AS(bitshield::codec::product::decode_bits(not_multiple_of_49), std::invalid_argument);
+    
+    std::vector<uint8_t> block(49, 0);
+    CHECK_THROWS_AS(bitshield::codec::product::decode_bits(block, 0), std::invalid_argument);
+}
+
+TEST_CASE("Product code - span forms write into caller buffers") {
+    std::vector<uint8_t> data = bit_pattern(40);
+    std::vector<uint8_t> encoded(3 * 49, 5);
+    bitshield::codec::product::encode_bits(data, encoded);
+    CHECK(encoded == bitshield::codec::product::encode_bits(data));
+    
+    encoded[10] ^= 1;
+    encoded[60] ^= 1;
+    std::vector<uint8_t> received = encoded;
+    std::vector<uint8_t> decoded(48);
+    bitshield::codec::product::decode_bits(encoded, decoded);
+    CHECK(std::vector<uint8_t>(decoded.begin(), decoded.begin() + 40) == data);
+    CHECK(encoded == received);
+    
+    CHECK_THROWS_AS(bitshield::codec::product::decode_bits(encoded, bitshield::util::BitSpan(decoded).subspan(1)), std::invalid_argument);
+}
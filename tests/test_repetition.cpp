@@ -64,3 +64,23 @@ TEST_CASE("Repetition codec - empty input") {
     CHECK(decoded.empty());
 }
 
+
+TEST_CASE("Repetition codec - span forms write into caller buffers") {
+    std::vector<uint8_t> data = {1, 0, 1, 1};
+    std::vector<uint8_t> encoded(12);
+    bitshield::codec::repetition::encode(data, encoded, 3);
+    CHECK(encoded == bitshield::codec::repetition::encode(data, 3));
+    
+    encoded[4] ^= 1;
+    std::vector<uint8_t> decoded(4, 9);
+    bitshield::codec::repetition::decode(encoded, decoded, 3);
+    CHECK(decoded == data);
+    
+    // Only the first group of a view is decoded
+    std::vector<uint8_t> first(1);
+    bitshield::codec::repetition::decode(bitshield::util::ConstBitSpan(encoded).subspan(0, 3), first, 3);
+    CHECK(first[0] == 1);
+    
+    CHECK_THROWS_AS(bitshield::codec::repetition::encode(data, bitshield::util::BitSpan(encoded).subspan(1), 3), std::invalid_argument);
+    CHECK_THROWS_AS(bitshield::codec::repetition::decode(encoded, bitshield::util::BitSpan(decoded).subspan(1), 3), std::invalid_argument);
+}
@@ -0,0 +1,540 @@
+#include "doctest.h"
+#include "test_helpers.hpp"
+#include <bitshield/sim.hpp>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <stdexcept>
+#include <vector>
+#include <cstdint>
+
+using bitshield::test::temp_path;
+
+namespace {
+
+// Trial whose outcome depends only on its index: trial t sees t % 5 bit errors
+bitshield::sim::Trial index_trial() {
+    return [](const bitshield::sim::Reference& reference, uint64_t t, bitshield::util::BitArena& arena,
+              bitshield::sim::Tally& tally) {
+        arena.bits(reference.encoded.size());
+        tally.bit_errors += t % 5;
+        tally.failed_messages += t % 5 != 0 ? 1 : 0;
+        tally.channel.bits += reference.encoded.size();
+    };
+}
+
+bitshield::sim::Topology two_nodes() {
+    bitshield::sim::Topology topology;
+    topology.nodes.push_back({0, {0, 1, 2}});
+    topology.nodes.push_back({1, {4, 5}});
+    return topology;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Sim - CPU lists") {
+    using bitshield::sim::parse_cpu_list;
+    CHECK(parse_cpu_list("0-3,8,10-11\n") == std::vector<int>{0, 1, 2, 3, 8, 10, 11});
+    CHECK(parse_cpu_list("5") == std::vector<int>{5});
+    CHECK(parse_cpu_list("\n").empty());
+    CHECK_THROWS_AS(parse_cpu_list("3-1"), std::invalid_argument);
+    CHECK_THROWS_AS(parse_cpu_list("a-b"), std::invalid_argument);
+}
+
+TEST_CASE("Sim - detected topology covers usable CPUs once") {
+    bitshield::sim::Topology topology = bitshield::sim::detect_topology();
+    REQUIRE(!topology.nodes.empty());
+    std::set<int> seen;
+    for (const auto& node : topology.nodes) {
+        CHECK(!node.cpus.empty());
+        for (int cpu : node.cpus) {
+            CHECK(seen.insert(cpu).second);
+        }
+    }
+    CHECK(seen.size() == topology.cpu_count());
+}
+
+TEST_CASE("Sim - worker placement") {
+    using bitshield::sim::Placement;
+    using bitshield::sim::WorkerSlot;
+    bitshield::sim::Topology topology = two_nodes();
+    
+    for (const WorkerSlot& slot : bitshield::sim::place_workers(topology, 3, Placement::none)) {
+        CHECK(slot.node == -1);
+        CHECK(slot.cpu == -1);
+    }
+    
+    // Compact: node 0 fills first, then wrap around
+    std::vector<WorkerSlot> pin = bitshield::sim::place_workers(topology, 6, Placement::pin);
+    std::vector<int> cpus;
+    for (const WorkerSlot& slot : pin) {
+        cpus.push_back(slot.cpu);
+    }
+    CHECK(cpus == std::vector<int>{0, 1, 2, 4, 5, 0});
+    CHECK(pin[3].node == 1);
+    
+    // Scatter: alternate nodes
+    std::vector<WorkerSlot> numa = bitshield::sim::place_workers(topology, 5, Placement::numa);
+    cpus.clear();
+    std::vector<int> nodes;
+    for (const WorkerSlot& slot : numa) {
+        cpus.push_back(slot.cpu);
+        nodes.push_back(slot.node);
+    }
+    CHECK(cpus == std::vector<int>{0, 4, 1, 5, 2});
+    CHECK(nodes == std::vector<int>{0, 1, 0, 1, 0});
+}
+
+TEST_CASE("Sim - totals do not depend on workers, batch or placement") {
+    using bitshield::sim::Placement;
+    bitshield::sim::Reference reference{{1, 0, 1}, std::vector<uint8_t>(21, 0)};
+    const uint64_t trials = 1003;
+    
+    uint64_t expected_errors = 0;
+    uint64_t expected_failures = 0;
+    for (uint64_t t = 0; t < trials; ++t) {
+        expected_errors += t % 5;
+        expected_failures += t % 5 != 0 ? 1 : 0;
+    }
+    
+    for (Placement placement : {Placement::none, Placement::pin, Placement::numa}) {
+        for (size_t workers : {1, 3}) {
+            for (uint64_t batch : {1, 64, 5000}) {
+                bitshield::sim::Options options;
+                options.workers = workers;
+                options.placement = placement;
+                options.batch = batch;
+                bitshield::sim::Result result = bitshield::sim::run(reference, trials, index_trial(), options);
+                CHECK(result.tally.trials == trials);
+                CHECK(result.tally.bit_errors == expected_errors);
+                CHECK(result.tally.failed_messages == expected_failures);
+                CHECK(result.tally.channel.bits == trials * 21);
+                
+                size_t node_workers = 0;
+                uint64_t node_trials = 0;
+                for (const auto& node : result.nodes) {
+                    CHECK((placement == Placement::none) == (node.node < 0));
+                    node_workers += node.workers;
+                    node_trials += node.trials;
+                }
+                CHECK(node_workers == workers);
+                CHECK(node_trials == trials);
+                if (placement == Placement::none) {
+                    CHECK(result.pinned_workers == 0);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Sim - numa workers read a node-local copy of the reference") {
+    bitshield::sim::Reference reference{{1}, {0, 1, 1}};
+    std::atomic<size_t> foreign{0};
+    bitshield::sim::Trial trial = [&](const bitshield::sim::Reference& local, uint64_t, bitshield::util::BitArena&,
+                                      bitshield::sim::Tally&) {
+        if (&local == &reference || local.encoded != reference.encoded) {
+            foreign++;
+        }
+    };
+    
+    bitshield::sim::Options options;
+    options.workers = 2;
+    options.placement = bitshield::sim::Placement::numa;
+    bitshield::sim::run(reference, 100, trial, options);
+    CHECK(foreign == 0);
+}
+
+TEST_CASE("Sim - work deque owner and thief ends") {
+    bitshield::sim::WorkDeque<uint64_t> deque(3);
+    CHECK(deque.capacity() == 4);
+    CHECK(deque.empty());
+    uint64_t value = 0;
+    CHECK(!deque.pop(value));
+    CHECK(!deque.steal(value));
+    
+    for (uint64_t i = 1; i <= 4; ++i) {
+        CHECK(deque.push(i));
+    }
+    CHECK(!deque.push(5));
+    
+    // Owner takes the newest, thieves the oldest
+    CHECK(deque.pop(value));
+    CHECK(value == 4);
+    CHECK(deque.steal(value));
+    CHECK(value == 1);
+    CHECK(deque.push(6));
+    CHECK(deque.pop(value));
+    CHECK(value == 6);
+    CHECK(deque.pop(value));
+    CHECK(value == 3);
+    CHECK(deque.steal(value));
+    CHECK(value == 2);
+    CHECK(deque.empty());
+    CHECK(!deque.pop(value));
+}
+
+TEST_CASE("Sim - work deque hands out each value once under contention") {
+    const uint64_t count = 20000;
+    bitshield::sim::WorkDeque<uint64_t> deque(count);
+    for (uint64_t i = 0; i < count; ++i) {
+        deque.push(i);
+    }
+    
+    std::vector<std::atomic<uint8_t>> taken(count);
+    std::atomic<uint64_t> duplicates{0};
+    auto take = [&](uint64_t value) {
+        if (taken[value].exchange(1) != 0) {
+            duplicates++;
+        }
+    };
+    
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; ++t) {
+        thieves.emplace_back([&] {
+            uint64_t value = 0;
+            while (!deque.empty()) {
+                if (deque.steal(value)) {
+                    take(value);
+                }
+            }
+        });
+    }
+    uint64_t value = 0;
+    while (!deque.empty()) {
+        if (deque.pop(value)) {
+            take(value);
+        }
+    }
+    for (std::thread& thief : thieves) {
+        thief.join();
+    }
+    
+    CHECK(duplicates == 0);
+    uint64_t total = 0;
+    for (const std::atomic<uint8_t>& flag : taken) {
+        total += flag.load();
+    }
+    CHECK(total == count);
+}
+
+TEST_CASE("Sim - sweep jobs match separate runs") {
+    // Jobs of very different cost: trial t of job j spins for (j + 1)^3 rounds
+    auto costly = [](uint64_t rounds) -> bitshield::sim::Trial {
+        return [rounds](const bitshield::sim::Reference& reference, uint64_t t, bitshield::util::BitArena&,
+                        bitshield::sim::Tally& tally) {
+            uint64_t x = t + 1;
+            for (uint64_t r = 0; r < rounds; ++r) {
+                x = x * 6364136223846793005ull + 1442695040888963407ull;
+            }
+            tally.bit_errors += (x >> 60) + reference.message.size();
+            tally.failed_messages += t % 3 == 0 ? 1 : 0;
+        };
+    };
+    
+    std::vector<bitshield::sim::Job> jobs;
+    for (uint64_t j = 0; j < 4; ++j) {
+        jobs.push_back(bitshield::sim::Job{{std::vector<uint8_t>(j + 1, 1), {0, 1}}, 300 + 7 * j, costly((j + 1) * (j + 1) * (j + 1))});
+    }
+    
+    for (bool steal : {true, false}) {
+        bitshield::sim::Options options;
+        options.workers = 3;
+        options.batch = 16;
+        options.steal = steal;
+        bitshield::sim::Result sweep = bitshield::sim::run_jobs(jobs, options);
+        REQUIRE(sweep.jobs.size() == jobs.size());
+        
+        uint64_t expected_tasks = 0;
+        uint64_t total_trials = 0;
+        for (size_t j = 0; j < jobs.size(); ++j) {
+            bitshield::sim::Result single = bitshield::sim::run(jobs[j].reference, jobs[j].trials, jobs[j].trial);
+            CHECK(sweep.jobs[j].trials == jobs[j].trials);
+            CHECK(sweep.jobs[j].bit_errors == single.tally.bit_errors);
+            CHECK(sweep.jobs[j].failed_messages == single.tally.failed_messages);
+            expected_tasks += (jobs[j].trials + options.batch - 1) / options.batch;
+            total_trials += jobs[j].trials;
+        }
+        CHECK(sweep.tally.trials == total_trials);
+        CHECK(sweep.tasks == expected_tasks);
+        CHECK(sweep.tail_seconds >= 0.0);
+        CHECK(sweep.tail_seconds <= sweep.wall_seconds);
+        if (!steal) {
+            CHECK(sweep.steals == 0);
+        }
+    }
+}
+
+TEST_CASE("Sim - checkpoint files round-trip and reject corruption") {
+    bitshield::sim::Checkpoint checkpoint;
+    checkpoint.fingerprint = 0x1234567890ABCDEFull;
+    checkpoint.batch = 16;
+    checkpoint.trials = {100, 7};
+    checkpoint.jobs.resize(2);
+    checkpoint.jobs[0].trials = 32;
+    checkpoint.jobs[0].bit_errors = 5;
+    checkpoint.jobs[0].failed_messages = 2;
+    checkpoint.jobs[0].channel.bits = 640;
+    checkpoint.jobs[0].channel.errors = 9;
+    checkpoint.jobs[1].channel.erasures = 3;
+    checkpoint.jobs[1].error_histogram = {3, 0, 2};
+    checkpoint.done = {1, 0, 0, 0, 0, 0, 1, 0};
+    CHECK(checkpoint.completed_trials() == 32);
+    
+    std::string path = temp_path("bitshield_sim.ckpt");
+    bitshield::sim::save_checkpoint(checkpoint, path);
+    bitshield::sim::Checkpoint loaded = bitshield::sim::load_checkpoint(path);
+    CHECK(loaded.fingerprint == checkpoint.fingerprint);
+    CHECK(loaded.batch == 16);
+    CHECK(loaded.trials == checkpoint.trials);
+    CHECK(loaded.done == checkpoint.done);
+    REQUIRE(loaded.jobs.size() == 2);
+    CHECK(loaded.jobs[0].bit_errors == 5);
+    CHECK(loaded.jobs[0].failed_messages == 2);
+    CHECK(loaded.jobs[0].channel.bits == 640);
+    CHECK(loaded.jobs[0].channel.errors == 9);
+    CHECK(loaded.jobs[1].channel.erasures == 3);
+    CHECK(loaded.jobs[1].error_histogram == std::vector<uint64_t>{3, 0, 2});
+    CHECK(loaded.jobs[1].channel_histogram.empty());
+    CHECK(!std::filesystem::exists(path + ".tmp"));
+    
+    // Flip one byte of the payload
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(20);
+        file.put('\x55');
+    }
+    CHECK_THROWS_AS(bitshield::sim::load_checkpoint(path), std::runtime_error);
+    std::filesystem::remove(path);
+    CHECK_THROWS_AS(bitshield::sim::load_checkpoint(path), std::runtime_error);
+}
+
+TEST_CASE("Sim - a stopped run resumes to the uninterrupted totals") {
+    std::vector<bitshield::sim::Job> jobs;
+    jobs.push_back(bitshield::sim::Job{{{1, 1}, {0}}, 500, index_trial()});
+    jobs.push_back(bitshield::sim::Job{{{1}, {0, 0}}, 301, index_trial()});
+    
+    bitshield::sim::Options options;
+    options.workers = 2;
+    options.batch = 8;
+    options.fingerprint = 42;
+    bitshield::sim::Result full = bitshield::sim::run_jobs(jobs, options);
+    REQUIRE(full.complete);
+    
+    // Stop once trial 200 of the first job has run
+    std::string path = temp_path("bitshield_sim_resume.ckpt");
+    std::atomic<bool> stop{false};
+    std::vector<bitshield::sim::Job> stopping = jobs;
+    stopping[0].trial = [&stop](const bitshield::sim::Reference& reference, uint64_t t, bitshield::util::BitArena& arena,
+                                bitshield::sim::Tally& tally) {
+        index_trial()(reference, t, arena, tally);
+        if (t == 200) {
+            stop = true;
+        }
+    };
+    options.checkpoint = path;
+    options.stop = &stop;
+    bitshield::sim::Result partial = bitshield::sim::run_jobs(stopping, options);
+    CHECK(!partial.complete);
+    
+    bitshield::sim::Checkpoint checkpoint = bitshield::sim::load_checkpoint(path);
+    CHECK(checkpoint.completed_trials() == partial.tally.trials);
+    CHECK(checkpoint.completed_trials() < full.tally.trials);
+    
+    // Resume with a different worker count
+    bitshield::sim::Options resume_options;
+    resume_options.workers = 3;
+    resume_options.batch = 8;
+    resume_options.fingerprint = 42;
+    resume_options.checkpoint = path;
+    resume_options.resume = &checkpoint;
+    bitshield::sim::Result resumed = bitshield::sim::run_jobs(jobs, resume_options);
+    CHECK(resumed.complete);
+    CHECK(resumed.resumed_trials == checkpoint.completed_trials());
+    CHECK(resumed.tally.trials == full.tally.trials);
+    CHECK(resumed.tally.bit_errors == full.tally.bit_errors);
+    CHECK(resumed.tally.failed_messages == full.tally.failed_messages);
+    CHECK(resumed.tally.channel.bits == full.tally.channel.bits);
+    for (size_t j = 0; j < jobs.size(); ++j) {
+        CHECK(resumed.jobs[j].bit_errors == full.jobs[j].bit_errors);
+    }
+    
+    // The final checkpoint marks every task done
+    bitshield::sim::Checkpoint finished = bitshield::sim::load_checkpoint(path);
+    CHECK(std::count(finished.done.begin(), finished.done.end(), 0) == 0);
+    CHECK(finished.completed_trials() == full.tally.trials);
+    
+    // A checkpoint of another configuration is refused
+    resume_options.fingerprint = 43;
+    CHECK_THROWS_AS(bitshield::sim::run_jobs(jobs, resume_options), std::invalid_argument);
+    resume_options.fingerprint = 42;
+    resume_options.batch = 16;
+    CHECK_THROWS_AS(bitshield::sim::run_jobs(jobs, resume_options), std::invalid_argument);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Sim - trial seeds use the whole seed and trial index") {
+    CHECK(bitshield::sim::trial_seed(0, 0) == bitshield::sim::trial_seed(0, 0));
+    CHECK(bitshield::sim::trial_seed(0, 0) != bitshield::sim::trial_seed(1, 0));
+    CHECK(bitshield::sim::trial_seed(0, 0) != bitshield::sim::trial_seed(0, 1));
+    // seed + i used to give these pairs the same noise
+    CHECK(bitshield::sim::trial_seed(0xFFFFFFFFu, 1) != bitshield::sim::trial_seed(0, 0));
+    CHECK(bitshield::sim::trial_seed(5, 7) != bitshield::sim::trial_seed(5, 7 + (uint64_t{1} << 32)));
+}
+
+TEST_CASE("Sim - tally histograms") {
+    bitshield::sim::Tally tally;
+    bitshield::metrics::ChannelStats stats;
+    stats.bits = 7;
+    stats.errors = 2;
+    tally.record(0, stats);
+    tally.record(3, stats);
+    tally.record(100000, stats);
+    CHECK(tally.bit_errors == 100003);
+    CHECK(tally.failed_messages == 2);
+    CHECK(tally.channel.bits == 21);
+    CHECK(tally.channel.errors == 6);
+    REQUIRE(tally.error_histogram.size() == bitshield::sim::Tally::kHistogramBins);
+    CHECK(tally.error_histogram[0] == 1);
+    CHECK(tally.error_histogram[3] == 1);
+    CHECK(tally.error_histogram.back() == 1);
+    CHECK(tally.channel_histogram == std::vector<uint64_t>{0, 0, 3});
+    
+    bitshield::sim::Tally other;
+    other.record(1, bitshield::metrics::ChannelStats{});
+    tally.merge(other);
+    CHECK(tally.error_histogram[1] == 1);
+    CHECK(tally.channel_histogram == std::vector<uint64_t>{1, 0, 3});
+}
+
+TEST_CASE("Sim - shard ranges cover the trials once") {
+    for (uint64_t trials : {0, 1, 10, 1001}) {
+        for (uint32_t count : {1, 3, 7}) {
+            uint64_t next = 0;
+            for (uint32_t index = 0; index < count; ++index) {
+                auto [first, last] = bitshield::sim::shard_range(trials, index, count);
+                CHECK(first == next);
+                CHECK(last - first <= trials / count + 1);
+                next = last;
+            }
+            CHECK(next == trials);
+        }
+    }
+    CHECK_THROWS_AS(bitshield::sim::shard_range(10, 2, 2), std::invalid_argument);
+    CHECK_THROWS_AS(bitshield::sim::shard_range(10, 0, 0), std::invalid_argument);
+}
+
+TEST_CASE("Sim - shards of a job add up to the whole job") {
+    bitshield::sim::Reference reference{{1, 0}, {1, 1, 0}};
+    bitshield::sim::Trial trial = [](const bitshield::sim::Reference&, uint64_t t, bitshield::util::BitArena&,
+                                     bitshield::sim::Tally& tally) {
+        bitshield::metrics::ChannelStats stats;
+        stats.bits = 3;
+        stats.errors = t % 4;
+        tally.record(t % 7 == 0 ? 0 : t % 3, stats);
+    };
+    bitshield::sim::Result whole = bitshield::sim::run(reference, 997, trial);
+    
+    std::vector<bitshield::sim::ShardResult> shards;
+    for (uint32_t index = 0; index < 4; ++index) {
+        auto [first, last] = bitshield::sim::shard_range(997, index, 4);
+        bitshield::sim::Options options;
+        options.workers = 2;
+        options.batch = 10;
+        bitshield::sim::Result part = bitshield::sim::run_jobs({bitshield::sim::Job{reference, last - first, trial, first}}, options);
+        
+        bitshield::sim::ShardResult shard;
+        shard.fingerprint = 7;
+        shard.shard_count = 4;
+        shard.shards = {index};
+        shard.seconds = part.wall_seconds;
+        shard.metadata = {{"command", "simulate"}, {"note", "two words"}};
+        shard.labels = {"hamming 0.05"};
+        shard.trials = {997};
+        shard.jobs = part.jobs;
+        
+        std::string path = temp_path("bitshield_sim_shard.res");
+        bitshield::sim::save_result(shard, path);
+        shards.push_back(bitshield::sim::load_result(path));
+        std::filesystem::remove(path);
+    }
+    CHECK(shards[1].metadata == std::vector<std::pair<std::string, std::string>>{{"command", "simulate"}, {"note", "two words"}});
+    CHECK(shards[1].labels == std::vector<std::string>{"hamming 0.05"});
+    
+    bitshield::sim::ShardResult partial = bitshield::sim::merge_results({shards[3], shards[1]});
+    CHECK(!partial.complete());
+    CHECK(partial.shards == std::vector<uint32_t>{1, 3});
+    
+    bitshield::sim::ShardResult merged = bitshield::sim::merge_results({shards[2], shards[0], partial});
+    CHECK(merged.complete());
+    const bitshield::sim::Tally& tally = merged.jobs.at(0);
+    CHECK(tally.trials == whole.tally.trials);
+    CHECK(tally.bit_errors == whole.tally.bit_errors);
+    CHECK(tally.failed_messages == whole.tally.failed_messages);
+    CHECK(tally.channel.bits == whole.tally.channel.bits);
+    CHECK(tally.channel.errors == whole.tally.channel.errors);
+    CHECK(tally.error_histogram == whole.tally.error_histogram);
+    CHECK(tally.channel_histogram == whole.tally.channel_histogram);
+    
+    // Overlapping shards and other simulations are refused
+    CHECK_THROWS_AS(bitshield::sim::merge_results({shards[0], partial, shards[1]}), std::invalid_argument);
+    bitshield::sim::ShardResult foreign = shards[2];
+    foreign.fingerprint = 8;
+    CHECK_THROWS_AS(bitshield::sim::merge_results({shards[0], foreign}), std::invalid_argument);
+}
+
+TEST_CASE("Sim - result files reject malformed input") {
+    std::string path = temp_path("bitshield_sim_bad.res");
+    auto write = [&path](const std::string& text) {
+        std::ofstream(path, std::ios::binary) << text;
+    };
+    
+    write("not a result\n");
+    CHECK_THROWS_AS(bitshield::sim::load_result(path), std::runtime_error);
+    write("bitshield-result 9\n");
+    CHECK_THROWS_AS(bitshield::sim::load_result(path), std::runtime_error);
+    write("bitshield-result 1\ntally 1 2 3 4 5 6\n");
+    CHECK_THROWS_AS(bitshield::sim::load_result(path), std::runtime_error);
+    write("bitshield-result 1\nshards 2 0 5\n");
+    CHECK_THROWS_AS(bitshield::sim::load_result(path), std::runtime_error);
+    write("bitshield-result 1\njob 10 x\ntally 1 two\n");
+    CHECK_THROWS_AS(bitshield::sim::load_result(path), std::runtime_error);
+    write("bitshield-result 1\njob 1 a\ntally 1 0 0 8 0 0\njob 1 b\njob 1 c\ntally 1 0 0 8 0 0\n");
+    CHECK_THROWS_AS(bitshield::sim::load_result(path), std::runtime_error);
+    std::filesystem::remove(path);
+    CHECK_THROWS_AS(bitshield::sim::load_result(path), std::runtime_error);
+    
+    bitshield::sim::ShardResult result;
+    result.labels = {"a\nb"};
+    result.trials = {1};
+    result.jobs.resize(1);
+    CHECK_THROWS_AS(bitshield::sim::save_result(result, path), std::invalid_argument);
+}
+
+TEST_CASE("Sim - errors") {
+    bitshield::sim::Reference reference;
+    bitshield::sim::Options options;
+    options.workers = 0;
+    CHECK_THROWS_AS(bitshield::sim::run(reference, 10, index_trial(), options), std::invalid_argument);
+    options.workers = 1;
+    options.batch = 0;
+    CHECK_THROWS_AS(bitshield::sim::run(reference, 10, index_trial(), options), std::invalid_argument);
+    
+    // A failing trial stops the run and the failure reaches the caller
+    options.workers = 3;
+    options.batch = 4;
+    bitshield::sim::Trial failing = [](const bitshield::sim::Reference&, uint64_t t, bitshield::util::BitArena&,
+                                       bitshield::sim::Tally&) {
+        if (t == 50) {
+            throw std::runtime_error("trial failed");
+        }
+    };
+    CHECK_THROWS_AS(bitshield::sim::run(reference, 1000, failing, options), std::runtime_error);
+    
+    // No trials is not an error
+    bitshield::sim::Result empty = bitshield::sim::run(reference, 0, index_trial(), options);
+    CHECK(empty.tally.trials == 0);
+}
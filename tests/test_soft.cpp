@@ -0,0 +1,221 @@
+#include "doctest.h"
+#include <bitshield/llr.hpp>
+#include <bitshield/channels/awgn.hpp>
+#include <bitshield/codecs/repetition.hpp>
+#include <bitshield/codecs/hamming74.hpp>
+#include <bitshield/codecs/codec.hpp>
+#include <bitshield/metrics.hpp>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+TEST_CASE("LLR - hard decision and quantisation") {
+    std::vector<float> llrs = {3.5f, -0.2f, 0.0f, -200.0f, 200.0f};
+    
+    CHECK(bitshield::llr::hard_decision(llrs) == std::vector<uint8_t>{0, 1, 0, 1, 0});
+    
+    std::vector<int8_t> q = bitshield::llr::quantize(llrs, 2.0f);
+    CHECK(q == std::vector<int8_t>{7, 0, 0, -127, 127});
+    CHECK(bitshield::llr::hard_decision(std::vector<int8_t>{5, -1, 0}) == std::vector<uint8_t>{0, 1, 0});
+    
+    CHECK(bitshield::llr::from_bits(std::vector<uint8_t>{0, 1}, 4.0f) == std::vector<float>{4.0f, -4.0f});
+    CHECK_THROWS_AS(bitshield::llr::quantize(llrs, 0.0f), std::invalid_argument);
+    
+    // NaN, including 0 * inf, is an erasure
+    std::vector<float> odd = {std::nanf(""), -std::nanf(""), 0.0f, -1.0f};
+    CHECK(bitshield::llr::quantize(odd, 4.0f) == std::vector<int8_t>{0, 0, 0, -4});
+    CHECK(bitshield::llr::quantize(std::vector<float>{0.0f}, INFINITY) == std::vector<int8_t>{0});
+}
+
+TEST_CASE("Repetition soft decode - reliability outweighs majority") {
+    // Two unreliable copies say 1, one confident copy says 0
+    std::vector<float> llrs = {-0.5f, -0.4f, 3.0f, -1.0f, -1.0f, 0.5f};
+    
+    CHECK(bitshield::codec::repetition::decode(bitshield::llr::hard_decision(llrs), 3) == std::vector<uint8_t>{1, 1});
+    CHECK(bitshield::codec::repetition::decode_soft(llrs, 3) == std::vector<uint8_t>{0, 1});
+    CHECK(bitshield::codec::repetition::decode_soft(bitshield::llr::quantize(llrs, 10.0f), 3) == std::vector<uint8_t>{0, 1});
+    
+    CHECK_THROWS_AS(bitshield::codec::repetition::decode_soft(llrs, 0), std::invalid_argument);
+}
+
+TEST_CASE("Hamming(7,4) soft decode - matches hard decode on single errors") {
+    for (int v = 0; v < 16; ++v) {
+        std::vector<uint8_t> data = {
+            static_cast<uint8_t>((v >> 3) & 1),
+            static_cast<uint8_t>((v >> 2) & 1),
+            static_cast<uint8_t>((v >> 1) & 1),
+            static_cast<uint8_t>(v & 1)
+        };
+        std::vector<uint8_t> codeword = bitshield::codec::hamming74::encode(data);
+        for (int pos = 0; pos < 7; ++pos) {
+            std::vector<uint8_t> corrupted = codeword;
+            corrupted[pos] ^= 1;
+            CHECK(bitshield::codec::hamming74::decode_soft_bits(bitshield::llr::from_bits(corrupted)) == data);
+        }
+    }
+}
+
+TEST_CASE("Hamming(7,4) soft decode - corrects two weak errors") {
+    std::vector<uint8_t> data = {1, 0, 1, 1};
+    std::vector<uint8_t> codeword = bitshield::codec::hamming74::encode(data);
+    
+    std::vector<float> llrs = bitshield::llr::from_bits(codeword, 4.0f);
+    llrs[0] = -0.3f * llrs[0] / 4.0f;  // Flipped, low reliability
+    llrs[5] = -0.3f * llrs[5] / 4.0f;
+    
+    CHECK(bitshield::codec::hamming74::decode_bits(bitshield::llr::hard_decision(llrs)) != data);
+    CHECK(bitshield::codec::hamming74::decode_soft_bits(llrs) == data);
+    CHECK(bitshield::codec::hamming74::decode_soft_bits(bitshield::llr::quantize(llrs, 10.0f)) == data);
+    
+    CHECK_THROWS_AS(bitshield::codec::hamming74::decode_soft_bits(std::vector<float>(6)), std::invalid_argument);
+}
+
+TEST_CASE("AWGN - deterministic LLRs and correct sign at high SNR") {
+    std::vector<uint8_t> bits = {1, 0, 1, 1, 0, 0, 1, 0};
+    
+    std::vector<float> a = bitshield::channel::awgn_llr(bits, 3.0, 0.5, 42);
+    std::vector<float> b = bitshield::channel::awgn_llr(bits, 3.0, 0.5, 42);
+    CHECK(a == b);
+    
+    std::vector<float> clean = bitshield::channel::awgn_llr(bits, 40.0, 1.0, 7);
+    CHECK(bitshield::llr::hard_decision(clean) == bits);
+    
+    CHECK(bitshield::channel::awgn_sigma(0.0, 1.0) == doctest::Approx(0.70710678));
+    CHECK_THROWS_AS(bitshield::channel::awgn_llr(bits, 3.0, 0.0, 1), std::invalid_argument);
+    CHECK_THROWS_AS(bitshield::channel::awgn_llr(bits, 3.0, 1.5, 1), std::invalid_argument);
+}
+
+TEST_CASE("AWGN - Gaussian samples have unit normal moments") {
+    const size_t n = 1 << 20;
+    std::vector<float> samples(n);
+    bitshield::channel::gaussian_fill(samples.data(), n, 123);
+    
+    double sum = 0.0, sum2 = 0.0, sum4 = 0.0;
+    size_t beyond2 = 0;
+    for (float x : samples) {
+        double d = x;
+        sum += d;
+        sum2 += d * d;
+        sum4 += d * d * d * d;
+        if (std::abs(d) > 2.0) {
+            beyond2++;
+        }
+    }
+    CHECK(std::abs(sum / n) < 0.005);
+    CHECK(sum2 / n == doctest::Approx(1.0).epsilon(0.01));
+    CHECK(sum4 / n == doctest::Approx(3.0).epsilon(0.03));
+    CHECK(static_cast<double>(beyond2) / n == doctest::Approx(std::erfc(2.0 / std::sqrt(2.0))).epsilon(0.03));
+}
+
+TEST_CASE("AWGN - any range of the sample stream can be generated independently") {
+    std::vector<float> whole(1000);
+    bitshield::channel::gaussian_fill(whole.data(), whole.size(), 9);
+    
+    for (size_t first : {1, 15, 16, 37, 500}) {
+        std::vector<float> part(whole.size() - first);
+        bitshield::channel::gaussian_fill(part.data(), part.size(), 9, first);
+        CHECK(std::equal(part.begin(), part.end(), whole.begin() + first));
+    }
+    
+    std::vector<float> other(whole.size());
+    bitshield::channel::gaussian_fill(other.data(), other.size(), 10);
+    CHECK(other != whole);
+}
+
+TEST_CASE("AWGN - raw bit error rate matches Q(sqrt(2 Es/N0))") {
+    std::vector<uint8_t> bits(400000);
+    for (size_t i = 0; i < bits.size(); ++i) {
+        bits[i] = static_cast<uint8_t>((i * 2654435761u >> 7) & 1);
+    }
+    
+    // Eb/N0 = 4 dB at rate 1/2 gives Es/N0 = 1 dB
+    std::vector<float> llrs = bitshield::channel::awgn_llr(bits, 4.0, 0.5, 3);
+    double ber = bitshield::metrics::calculate_ber(bits, bitshield::llr::hard_decision(llrs));
+    double es_n0 = std::pow(10.0, 0.1);
+    CHECK(ber == doctest::Approx(0.5 * std::erfc(std::sqrt(es_n0))).epsilon(0.03));
+}
+
+TEST_CASE("AWGN - quantised LLRs match quantising float LLRs") {
+    std::vector<uint8_t> bits(10007);
+    for (size_t i = 0; i < bits.size(); ++i) {
+        bits[i] = static_cast<uint8_t>(i % 3 == 0);
+    }
+    
+    for (float scale : {0.5f, 4.0f, 64.0f}) {
+        std::vector<int8_t> direct = bitshield::channel::awgn_llr_quantized(bits, 2.0, 0.5, scale, 17);
+        std::vector<int8_t> via_float = bitshield::llr::quantize(bitshield::channel::awgn_llr(bits, 2.0, 0.5, 17), scale);
+        CHECK(direct == via_float);
+    }
+    CHECK_THROWS_AS(bitshield::channel::awgn_llr_quantized(bits, 2.0, 0.5, 0.0f, 1), std::invalid_argument);
+}
+
+TEST_CASE("Soft decoding beats hard decoding over AWGN") {
+    std::vector<uint8_t> data(4000);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>((i * 7 + i / 3) % 2);
+    }
+    
+    for (const auto& codec : {bitshield::codec::make_repetition(3), bitshield::codec::make_hamming74()}) {
+        std::vector<uint8_t> encoded = codec.encode(data);
+        double rate = static_cast<double>(codec.data_bits) / codec.code_bits;
+        std::vector<float> llrs = bitshield::channel::awgn_llr(encoded, 3.0, rate, 5);
+        
+        std::vector<uint8_t> hard = codec.decode(bitshield::llr::hard_decision(llrs));
+        std::vector<uint8_t> soft = bitshield::codec::decode_llr(codec, llrs);
+        
+        size_t hard_errors = 0, soft_errors = 0;
+        for (size_t i = 0; i < data.size(); ++i) {
+            hard_errors += hard[i] != data[i];
+            soft_errors += soft[i] != data[i];
+        }
+        CHECK(soft_errors < hard_errors);
+    }
+}
+
+TEST_CASE("Codec - decode_llr falls back to hard decisions") {
+    auto codec = bitshield::codec::make_product();
+    CHECK(!codec.decode_soft);
+    
+    std::vector<uint8_t> data(16, 1);
+    std::vector<float> llrs = bitshield::llr::from_bits(codec.encode(data), 2.0f);
+    CHECK(bitshield::codec::decode_llr(codec, llrs) == data);
+}
+
+TEST_CASE("Codec - interleaved codecs keep soft decoding") {
+    std::vector<uint8_t> data(4000);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>((i * 7 + i / 3) % 2);
+    }
+    
+    using bitshield::interleaver::Kind;
+    for (Kind kind : {Kind::block, Kind::helical, Kind::random, Kind::convolutional}) {
+        CAPTURE(static_cast<int>(kind));
+        bitshield::interleaver::Spec spec{kind, 8, 7, 3};
+        auto codec = bitshield::codec::make_interleaved(bitshield::codec::make_hamming74(), spec);
+        REQUIRE(codec.decode_soft);
+        
+        std::vector<uint8_t> encoded = codec.encode(data);
+        std::vector<float> llrs = bitshield::channel::awgn_llr(encoded, 3.0, 4.0 / 7.0, 5);
+        
+        // LLRs follow the same permutation as the bits
+        std::vector<float> deinterleaved = bitshield::interleaver::deinterleave(llrs, spec);
+        CHECK(bitshield::llr::hard_decision(deinterleaved)
+              == bitshield::interleaver::deinterleave(bitshield::llr::hard_decision(llrs), spec));
+        
+        std::vector<uint8_t> hard = codec.decode(bitshield::llr::hard_decision(llrs));
+        std::vector<uint8_t> soft = bitshield::codec::decode_llr(codec, llrs);
+        REQUIRE(soft.size() >= data.size());
+        size_t hard_errors = 0, soft_errors = 0;
+        for (size_t i = 0; i < data.size(); ++i) {
+            hard_errors += hard[i] != data[i];
+            soft_errors += soft[i] != data[i];
+        }
+        CHECK(soft_errors < hard_errors);
+    }
+    
+    // Wrapping a codec without a soft decoder does not invent one
+    bitshield::interleaver::Spec block{Kind::block, 8, 49, 0};
+    CHECK(!bitshield::codec::make_interleaved(bitshield::codec::make_product(), block).decode_soft);
+}
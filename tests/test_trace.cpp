@@ -0,0 +1,89 @@
+#include "doctest.h"
+#include "test_helpers.hpp"
+#include <bitshield/channels/trace.hpp>
+#include <bitshield/channel.hpp>
+#include <bitshield/io.hpp>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+using bitshield::test::temp_path;
+
+namespace {
+
+std::string write_temp(const std::string& name, const std::vector<uint8_t>& bytes) {
+    std::string path = temp_path(name);
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return path;
+}
+
+} // anonymous namespace
+
+TEST_CASE("MappedFile - exposes file contents") {
+    std::vector<uint8_t> bytes = {0x00, 0x11, 0x22, 0xFF};
+    std::string path = write_temp("bitshield_mapped.bin", bytes);
+    
+    bitshield::io::MappedFile file(path);
+    REQUIRE(file.size() == bytes.size());
+    CHECK(std::vector<uint8_t>(file.data(), file.data() + file.size()) == bytes);
+    
+    bitshield::io::MappedFile moved(std::move(file));
+    CHECK(moved.size() == bytes.size());
+    CHECK(moved.data()[3] == 0xFF);
+    CHECK(file.size() == 0);
+    
+    std::filesystem::remove(path);
+    CHECK_THROWS_AS(bitshield::io::MappedFile("/nonexistent/bitshield.bin"), std::runtime_error);
+}
+
+TEST_CASE("Trace channel - windows, offset and looping") {
+    // Trace bits: 10000000 00000001 11110000
+    std::string path = write_temp("bitshield_trace.bin", {0x80, 0x01, 0xF0});
+    
+    bitshield::channel::TraceChannel trace(path);
+    CHECK(trace.length() == 24);
+    CHECK(trace.error_rate() == doctest::Approx(6.0 / 24.0));
+    
+    CHECK(trace.mask(0, 8) == std::vector<uint8_t>{0x80});
+    CHECK(trace.mask(15, 5) == std::vector<uint8_t>{0xF8});   // bits 15..19
+    CHECK(trace.mask(20, 8) == std::vector<uint8_t>{0x08});   // 20..23 then wraps to 0..3
+    CHECK(trace.mask(24 + 15, 5) == trace.mask(15, 5));
+    
+    bitshield::channel::TraceChannel shifted(path, 15, false);
+    CHECK(shifted.length() == 9);
+    CHECK(shifted.mask(0, 5) == std::vector<uint8_t>{0xF8});
+    CHECK_THROWS_AS(shifted.mask(5, 5), std::invalid_argument);
+    
+    CHECK_THROWS_AS(bitshield::channel::TraceChannel(path, 24), std::invalid_argument);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Trace channel - apply matches the window mask") {
+    std::vector<uint8_t> bytes(4096);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = (i % 7 == 0) ? static_cast<uint8_t>(i * 37 + 1) : 0;
+    }
+    std::string path = write_temp("bitshield_trace_apply.bin", bytes);
+    
+    auto file = std::make_shared<const bitshield::io::MappedFile>(path);
+    bitshield::channel::TraceChannel a(file, 3);
+    bitshield::channel::TraceChannel b(file, 0);
+    
+    std::vector<uint8_t> bits(1001);
+    for (size_t i = 0; i < bits.size(); ++i) {
+        bits[i] = static_cast<uint8_t>((i / 3) & 1);
+    }
+    for (uint64_t position : {0ull, 5ull, 1000ull, 31000ull}) {
+        CHECK(a.apply(bits, position) == bitshield::channel::apply_mask(bits, a.mask(position, bits.size())));
+        // Same trace bits through a different offset
+        CHECK(a.apply(bits, position) == b.apply(bits, position + 3));
+    }
+    // Windows that wrap apply the tail of the trace, then its start
+    CHECK(a.apply(bits, a.length() - 10) == bitshield::channel::apply_mask(bits, a.mask(a.length() - 10, bits.size())));
+    std::filesystem::remove(path);
+}